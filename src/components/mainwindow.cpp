@@ -61,6 +61,7 @@ MainWindow::loadIcons()
   ui->actionDownloadManager->setIcon(awesome.icon(fa_solid, fa_download));
   ui->actionExit->setIcon(awesome.icon(fa_solid, fa_xmark));
   ui->actionFind->setIcon(awesome.icon(fa_solid, fa_magnifying_glass));
+  ui->actionConcordance->setIcon(awesome.icon(fa_solid, fa_chart_bar));
   ui->actionTafsir->setIcon(awesome.icon(fa_solid, fa_book_open));
   ui->actionVOTD->setIcon(awesome.icon(fa_solid, fa_calendar_day));
   ui->actionBookmarks->setIcon(awesome.icon(fa_solid, fa_bookmark));
@@ -105,6 +106,7 @@ MainWindow::loadComponents()
   m_cpyDlg = new CopyDialog(this);
   m_systemTray = new SystemTray(this);
   m_contentDlg = new ContentDialog(this);
+  m_similarDlg = new SimilarVersesDialog(this);
   m_jobMgr = new JobManager(this);
   m_versionChecker = new VersionChecker(this);
   m_selectorDlg = new FileSelector(this);
@@ -250,6 +252,10 @@ MainWindow::connectReader()
           &QuranReader::showVerseThoughts,
           m_contentDlg,
           &ContentDialog::showVerseThoughts);
+  connect(m_reader,
+          &QuranReader::showSimilarVerses,
+          m_similarDlg,
+          &SimilarVersesDialog::showSimilarVerses);
   connect(m_reader,
           &QuranReader::showBetaqa,
           m_betaqaViewer,
@@ -319,8 +325,8 @@ MainWindow::connectSettings()
           &QuranReader::addSideContent);
   connect(m_settingsDlg,
           &SettingsDialog::translationChanged,
-          m_translationService,
-          &TranslationService::loadTranslation);
+          m_reader,
+          &QuranReader::reloadTranslation);
   connect(m_settingsDlg,
           &SettingsDialog::sideFontChanged,
           m_reader,
@@ -357,6 +363,8 @@ MainWindow::connectMenubar()
          make_pair(ui->actionPereferences, &MainWindow::actionPrefTriggered),
          make_pair(ui->actionDownloadManager, &MainWindow::actionDMTriggered),
          make_pair(ui->actionFind, &MainWindow::actionSearchTriggered),
+         make_pair(ui->actionConcordance,
+                   &MainWindow::actionConcordanceTriggered),
          make_pair(ui->actionTafsir, &MainWindow::actionTafsirTriggered),
          make_pair(ui->actionVOTD, &MainWindow::actionVotdTriggered),
          make_pair(ui->actionBookmarks, &MainWindow::actionBookmarksTriggered),
@@ -731,6 +739,15 @@ MainWindow::actionSearchTriggered()
   m_searchDlg->show();
 }
 
+void
+MainWindow::actionConcordanceTriggered()
+{
+  if (m_concordanceDlg == nullptr)
+    m_concordanceDlg = new ConcordanceDialog(this);
+
+  m_concordanceDlg->show();
+}
+
 void
 MainWindow::actionPlayerControlsToggled(bool checked)
 {
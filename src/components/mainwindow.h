@@ -18,6 +18,7 @@
 #include <components/quranreader.h>
 #include <components/systemtray.h>
 #include <dialogs/bookmarksdialog.h>
+#include <dialogs/concordancedialog.h>
 #include <dialogs/contentdialog.h>
 #include <dialogs/copydialog.h>
 #include <dialogs/downloaderdialog.h>
@@ -26,6 +27,7 @@
 #include <dialogs/khatmahdialog.h>
 #include <dialogs/searchdialog.h>
 #include <dialogs/settingsdialog.h>
+#include <dialogs/similarversesdialog.h>
 #include <dialogs/versedialog.h>
 #include <player/verseplayer.h>
 #include <service/bookmarkservice.h>
@@ -177,6 +179,10 @@ private slots:
    * @brief open the SearchDialog, create instance if not set
    */
   void actionSearchTriggered();
+  /**
+   * @brief open the ConcordanceDialog, create instance if not set
+   */
+  void actionConcordanceTriggered();
   /**
    * @brief callback for the checkbox to toggle the visibility of the player
    * controls
@@ -433,10 +439,18 @@ private:
    * @brief pointer to ContentDialog instance
    */
   QPointer<ContentDialog> m_contentDlg;
+  /**
+   * @brief pointer to SimilarVersesDialog instance
+   */
+  QPointer<SimilarVersesDialog> m_similarDlg;
   /**
    * @brief pointer to SearchDialog instance
    */
   QPointer<SearchDialog> m_searchDlg;
+  /**
+   * @brief pointer to ConcordanceDialog instance
+   */
+  QPointer<ConcordanceDialog> m_concordanceDlg;
   /**
    * @brief pointer to SettingsDialog instance
    */
@@ -1,6 +1,7 @@
 #include "quranreader.h"
 #include "ui_quranreader.h"
 #include <QtAwesome.h>
+#include <QtConcurrent>
 #include <service/servicefactory.h>
 #include <utils/fontmanager.h>
 #include <utils/shortcuthandler.h>
@@ -108,6 +109,10 @@ QuranReader::setupConnections()
     ui->btnNext, &QPushButton::clicked, this, &QuranReader::btnNextClicked);
   connect(
     ui->btnPrev, &QPushButton::clicked, this, &QuranReader::btnPrevClicked);
+  connect(&m_sideContentWatcher,
+          &QFutureWatcher<SideContent>::finished,
+          this,
+          &QuranReader::sideContentFetched);
   for (int i = 0; i <= 1; i++)
     if (m_quranBrowsers[i])
       connect(m_quranBrowsers[i],
@@ -205,6 +210,34 @@ QuranReader::redrawQuranPage(bool manualSz)
   }
 
   updatePageVerseInfoList();
+  prefetchPages();
+}
+
+void
+QuranReader::prefetchPages()
+{
+  const int page = m_currVerse.page();
+  if (m_lastPage && page != m_lastPage)
+    m_readingDirection = page > m_lastPage ? 1 : -1;
+  m_lastPage = page;
+
+  const int first = m_quranBrowsers[0]->page();
+  const int last = m_quranBrowsers[1] ? m_quranBrowsers[1]->page() : first;
+  for (int i = 1; i <= 2; i++) {
+    int next = m_readingDirection > 0 ? last + i : first - i;
+    // even pages are always on the left side in 2-page mode
+    QuranPageBrowser* browser =
+      m_quranBrowsers[1] ? m_quranBrowsers[next % 2 == 0] : m_quranBrowsers[0];
+    browser->prefetchPage(next);
+  }
+}
+
+void
+QuranReader::reloadTranslation()
+{
+  // reopening the translation clears the statements a running fetch uses
+  m_sideContentWatcher.waitForFinished();
+  m_translationService->loadTranslation();
 }
 
 void
@@ -213,6 +246,32 @@ QuranReader::addSideContent()
   if (m_config.readerMode() != ReaderMode::SinglePage)
     return;
 
+  // the page is fetched with one query per database instead of one per verse
+  SideContent content;
+  content.page = m_currVerse.page();
+  content.verses = *m_activeVList;
+  const bool qcf = m_config.verseType() == ConfigurationSchema::Qcf;
+  const QuranService* quranService = m_quranService;
+  const GlyphService* glyphService = m_glyphService;
+  const TranslationService* translationService = m_translationService;
+  m_sideContentWatcher.setFuture(QtConcurrent::run(
+    [content, qcf, quranService, glyphService, translationService]() mutable {
+      content.texts = qcf ? glyphService->pageVerseGlyphs(content.page)
+                          : quranService->pageVerseTexts(content.page);
+      content.translations =
+        translationService->translationsForPage(content.page);
+      return content;
+    }));
+}
+
+void
+QuranReader::sideContentFetched()
+{
+  const SideContent content = m_sideContentWatcher.result();
+  if (m_config.readerMode() != ReaderMode::SinglePage ||
+      content.page != m_currVerse.page() || content.verses != *m_activeVList)
+    return;
+
   if (!m_verseFrameList.isEmpty()) {
     qDeleteAll(m_verseFrameList);
     m_verseFrameList.clear();
@@ -222,33 +281,28 @@ QuranReader::addSideContent()
   ClickableLabel* verselb;
   QLabel* contentLb;
   VerseFrame* verseContFrame;
-  QString prevLbContent, currLbContent, glyphs;
+  QString prevLbContent, currLbContent;
   if (m_config.verseType() == ConfigurationSchema::Qcf)
     m_versesFont.setFamily(
-      FontManager::getInstance().pageFontname(m_currVerse.page()));
+      FontManager::getInstance().pageFontname(content.page));
 
-  m_translationService->loadTranslation();
-  for (int i = m_activeVList->size() - 1; i >= 0; i--) {
-    const Verse* verse = &(m_activeVList->at(i));
+  for (int i = content.verses.size() - 1; i >= 0; i--) {
+    const Verse* verse = &(content.verses.at(i));
 
     verseContFrame = new VerseFrame(m_scrlVerseByVerse->widget());
     verselb = new ClickableLabel(verseContFrame);
     contentLb = new QLabel(verseContFrame);
-    glyphs = m_config.verseType() == ConfigurationSchema::Qcf
-               ? m_glyphService->getVerseGlyphs(verse->surah(), verse->number())
-               : m_quranService->verseText(verse->surah(), verse->number());
 
     verseContFrame->setObjectName(QString::number(verse->page()) + "_" +
                                   QString::number(verse->surah()) + "_" +
                                   QString::number(verse->number()));
 
     verselb->setFont(m_versesFont);
-    verselb->setText(glyphs);
+    verselb->setText(content.texts.value(i));
     verselb->setAlignment(Qt::AlignCenter);
     verselb->setWordWrap(true);
 
-    currLbContent =
-      m_translationService->getTranslation(verse->surah(), verse->number());
+    currLbContent = content.translations.value(i);
 
     if (currLbContent == prevLbContent) {
       currLbContent = '-';
@@ -271,6 +325,10 @@ QuranReader::addSideContent()
     connect(
       verselb, &ClickableLabel::clicked, this, &QuranReader::verseClicked);
   }
+
+  // the current verse may have been highlighted before its frame existed
+  if (m_currVerse.number() && content.verses.contains(m_currVerse))
+    setHighlightedFrame();
 }
 
 void
@@ -300,6 +358,8 @@ QuranReader::setHighlightedFrame()
     QString::number(m_currVerse.page()) + "_" +
     QString::number(m_currVerse.surah()) + "_" +
     QString::number(m_currVerse.number()));
+  if (!verseFrame)
+    return;
 
   verseFrame->setSelected(true);
 
@@ -381,6 +441,12 @@ QuranReader::selectVerse(int browserIdx, int IdxInPage)
 void
 QuranReader::verseAnchorClicked(const QUrl& hrefUrl)
 {
+  // the anchors of the previous page stay shown while the new one is built,
+  // the verse lists already belong to the new page
+  QuranPageBrowser* senderBrowser = qobject_cast<QuranPageBrowser*>(sender());
+  if (!senderBrowser->pageReady())
+    return;
+
   if (hrefUrl.toString().at(1) == 'F') {
     int surah = hrefUrl.toString().remove("#F").toInt();
     qDebug() << "SURAH CARD:" << surah;
@@ -388,7 +454,6 @@ QuranReader::verseAnchorClicked(const QUrl& hrefUrl)
     return;
   }
 
-  QuranPageBrowser* senderBrowser = qobject_cast<QuranPageBrowser*>(sender());
   int browerIdx = senderBrowser == m_quranBrowsers[1];
   int idx = hrefUrl.toString().remove('#').toInt();
   Verse v(m_vLists[browerIdx].at(idx));
@@ -413,6 +478,9 @@ QuranReader::verseAnchorClicked(const QUrl& hrefUrl)
     case QuranPageBrowser::Thoughts:
       emit showVerseThoughts(v);
       break;
+    case QuranPageBrowser::Similar:
+      emit showSimilarVerses(v);
+      break;
     case QuranPageBrowser::Copy:
       emit copyVerseText(v);
       break;
@@ -1,6 +1,7 @@
 #ifndef QURANREADER_H
 #define QURANREADER_H
 
+#include <QFutureWatcher>
 #include <QLabel>
 #include <QScrollArea>
 #include <QWidget>
@@ -75,8 +76,15 @@ public slots:
   /**
    * @brief updates the side panel with the translation of the current page
    * verses
+   * @details the verse texts and translations of the page are fetched on the
+   * global thread pool, the panel is rebuilt once they are ready
    */
   void addSideContent();
+  /**
+   * @brief reload the translation set in the settings once the side content
+   * being fetched is ready
+   */
+  void reloadTranslation();
   /**
    * @brief set side content font to the one in the settings
    */
@@ -112,8 +120,14 @@ signals:
   void showVerseTafsir(const Verse& v);
   void showVerseTranslation(const Verse& v);
   void showVerseThoughts(const Verse& v);
+  void showSimilarVerses(const Verse& v);
 
 private slots:
+  /**
+   * @brief rebuilds the side panel from the fetched page content, content of
+   * a page that is no longer shown is discarded
+   */
+  void sideContentFetched();
   /**
    * @brief callback function for clicking verses in the QuranPageBrowser that
    * takes actions based on the chosen option in the menu
@@ -137,6 +151,16 @@ private slots:
   void gotoDoublePage(int page);
 
 private:
+  /**
+   * @brief verse texts and translations of a page shown in the side panel
+   */
+  struct SideContent
+  {
+    int page = 0;
+    QList<Verse> verses;
+    QStringList texts;        ///< verse text or QCF glyphs of each verse
+    QStringList translations; ///< translation of each verse
+  };
   Ui::QuranReader* ui;
   /**
    * @brief reference to the shared current verse instance
@@ -218,6 +242,12 @@ private:
    * current page
    */
   void updatePageVerseInfoList();
+  /**
+   * @brief build the next 2 pages in the reading direction in the background
+   * @details the reading direction follows the last page change, in 2-page
+   * mode the pages of the following 2-pages are prefetched
+   */
+  void prefetchPages();
   /**
    * @brief QScrollArea used in single page mode to display verses &
    * translation
@@ -263,6 +293,18 @@ private:
    * @brief pointer to PlaybackController instance
    */
   QPointer<PlaybackController> m_playbackController;
+  /**
+   * @brief watches the fetching of the side panel content
+   */
+  QFutureWatcher<SideContent> m_sideContentWatcher;
+  /**
+   * @brief page shown by the last redraw, used to find the reading direction
+   */
+  int m_lastPage = 0;
+  /**
+   * @brief 1 when reading forward, -1 when reading backward
+   */
+  int m_readingDirection = 1;
 };
 
 #endif // QURANREADER_H
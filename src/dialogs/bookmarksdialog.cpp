@@ -111,6 +111,15 @@ BookmarksDialog::loadBookmarks(int surah)
     return;
   }
 
+  // the texts of the shown page of bookmarks are fetched in one query
+  QList<int> ids;
+  for (int i = m_startIdx; i < end; i++)
+    ids.append(
+      Verse::id(m_shownVerses.at(i).surah(), m_shownVerses.at(i).number()));
+  const QStringList texts = m_config.verseType() == ConfigurationSchema::Qcf
+                              ? m_glyphService->verseGlyphsById(ids)
+                              : m_quranService->verseTextsById(ids);
+
   for (int i = m_startIdx; i < end; i++) {
     const Verse& verse = m_shownVerses.at(i);
     QString fontName = FontManager::getInstance().verseFontname(
@@ -140,10 +149,7 @@ BookmarksDialog::loadBookmarks(int surah)
     QString info = tr("Surah: ") +
                    m_quranService->surahNames().at(verse.surah() - 1) + " - " +
                    tr("Verse: ") + QString::number(verse.number());
-    QString glyphs =
-      m_config.verseType() == ConfigurationSchema::Qcf
-        ? m_glyphService->getVerseGlyphs(verse.surah(), verse.number())
-        : m_quranService->verseText(verse.surah(), verse.number());
+    const QString& glyphs = texts.at(i - m_startIdx);
 
     lbMeta->setText(info);
     lbMeta->setAlignment(Qt::AlignLeft);
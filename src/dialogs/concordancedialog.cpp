@@ -0,0 +1,178 @@
+/**
+ * @file concordancedialog.cpp
+ * @brief Implementation file for ConcordanceDialog
+ */
+
+#include "concordancedialog.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QSet>
+#include <QSplitter>
+#include <QVBoxLayout>
+#include <service/servicefactory.h>
+#include <utils/arabicnormalizer.h>
+#include <utils/configuration.h>
+#include <utils/stylemanager.h>
+
+ConcordanceDialog::ConcordanceDialog(QWidget* parent)
+  : QDialog(parent)
+  , m_navigator(Navigator::getInstance())
+  , m_quranService(ServiceFactory::quranService())
+  , m_surahNames(m_quranService->surahNames())
+  , m_model(m_surahNames)
+  , m_ledWord(new QLineEdit(this))
+  , m_chkPrefix(new QCheckBox(tr("Words starting with"), this))
+  , m_cmbForms(new QComboBox(this))
+  , m_cmbGrouping(new QComboBox(this))
+  , m_lbSummary(new QLabel(this))
+  , m_treeCounts(new QTreeWidget(this))
+  , m_tableLines(new QTableView(this))
+{
+  setWindowTitle(tr("Concordance"));
+  setWindowIcon(StyleManager::getInstance().awesome().icon(
+    fa::fa_solid, fa::fa_chart_bar));
+  resize(900, 560);
+
+  m_ledWord->setPlaceholderText(tr("Word"));
+  m_ledWord->setClearButtonEnabled(true);
+  m_cmbGrouping->addItems({ tr("Per surah"), tr("Per juz") });
+  // matching by root or lemma needs the optional morphology dataset
+  m_cmbForms->addItems({ tr("Same word"), tr("Same root"), tr("Same lemma") });
+  m_cmbForms->setVisible(m_quranService->hasMorphology());
+
+  m_treeCounts->setColumnCount(2);
+  m_treeCounts->setHeaderLabels({ tr("Surah"), tr("Occurrences") });
+  m_treeCounts->setRootIsDecorated(false);
+  m_treeCounts->setUniformRowHeights(true);
+
+  // arabic lines read from the right, the preceding words go to the right
+  // of the keyword whatever the interface language
+  m_tableLines->setModel(&m_model);
+  m_tableLines->setLayoutDirection(Qt::RightToLeft);
+  m_tableLines->setSelectionBehavior(QAbstractItemView::SelectRows);
+  m_tableLines->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  m_tableLines->setShowGrid(false);
+  m_tableLines->verticalHeader()->hide();
+  m_tableLines->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  m_tableLines->horizontalHeader()->setSectionResizeMode(
+    QHeaderView::Interactive);
+  m_tableLines->horizontalHeader()->setSectionResizeMode(
+    ConcordanceModel::Keyword, QHeaderView::ResizeToContents);
+  m_tableLines->horizontalHeader()->setStretchLastSection(true);
+  m_tableLines->setColumnWidth(ConcordanceModel::Reference, 120);
+  m_tableLines->setColumnWidth(ConcordanceModel::Before, 280);
+
+  QHBoxLayout* inputs = new QHBoxLayout;
+  inputs->addWidget(m_ledWord, 1);
+  inputs->addWidget(m_chkPrefix);
+  inputs->addWidget(m_cmbForms);
+  inputs->addWidget(m_cmbGrouping);
+
+  QSplitter* splitter = new QSplitter(this);
+  splitter->addWidget(m_treeCounts);
+  splitter->addWidget(m_tableLines);
+  splitter->setStretchFactor(1, 1);
+  splitter->setSizes({ 220, 680 });
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addLayout(inputs);
+  layout->addWidget(m_lbSummary);
+  layout->addWidget(splitter, 1);
+
+  // lookups read the mapped concordance only, fast enough to run per edit
+  connect(m_ledWord, &QLineEdit::textChanged, this, &ConcordanceDialog::lookup);
+  connect(&m_concordanceWatcher,
+          &QFutureWatcher<bool>::finished,
+          this,
+          &ConcordanceDialog::lookup);
+  connect(
+    m_chkPrefix, &QCheckBox::toggled, this, &ConcordanceDialog::lookup);
+  connect(m_cmbForms,
+          &QComboBox::currentIndexChanged,
+          this,
+          &ConcordanceDialog::lookup);
+  connect(m_cmbGrouping,
+          &QComboBox::currentIndexChanged,
+          this,
+          &ConcordanceDialog::fillCounts);
+  connect(m_tableLines,
+          &QTableView::clicked,
+          this,
+          &ConcordanceDialog::lineClicked);
+
+  m_concordanceWatcher.setFuture(m_quranService->prepareConcordance());
+  lookup();
+}
+
+void
+ConcordanceDialog::lookup()
+{
+  // the concordance file is written on first use, never on the UI thread
+  if (!m_concordanceWatcher.isFinished()) {
+    m_lbSummary->setText(tr("Preparing the concordance..."));
+    return;
+  }
+  if (!m_concordanceWatcher.result()) {
+    m_lbSummary->setText(tr("The concordance couldn't be prepared"));
+    return;
+  }
+
+  const QStringList tokens = ArabicNormalizer::tokens(m_ledWord->text());
+  const Concordance& concordance = m_quranService->concordance();
+  const int match = m_cmbForms->currentIndex();
+  m_chkPrefix->setEnabled(match == SameWord);
+  const bool prefix = m_chkPrefix->isChecked();
+
+  m_occurrences.clear();
+  int forms = 0;
+  if (!tokens.isEmpty() && match == SameWord) {
+    m_occurrences = concordance.occurrences(tokens.first(), prefix);
+    forms = concordance.forms(tokens.first(), prefix).size();
+  } else if (!tokens.isEmpty()) {
+    // the words sharing the root or lemma are looked up together
+    const QStringList words =
+      m_quranService->morphologyForms(tokens.first(), match == SameLemma);
+    m_occurrences = concordance.occurrences(words);
+    forms = words.size();
+  }
+  m_model.setOccurrences(&concordance, m_occurrences);
+
+  QSet<int> verses;
+  for (const Concordance::Occurrence& occurrence : m_occurrences)
+    verses.insert(occurrence.verse);
+  m_lbSummary->setText(tokens.isEmpty()
+                         ? QString()
+                         : QString::number(m_occurrences.size()) +
+                             tr(" occurrences in ") +
+                             QString::number(verses.size()) + tr(" verses, ") +
+                             QString::number(forms) + tr(" word forms"));
+  fillCounts();
+}
+
+void
+ConcordanceDialog::fillCounts()
+{
+  const bool perJuz = m_cmbGrouping->currentIndex() == 1;
+  const QList<int> counts = perJuz
+                              ? Concordance::juzCounts(m_occurrences)
+                              : Concordance::surahCounts(m_occurrences);
+
+  m_treeCounts->clear();
+  m_treeCounts->setHeaderLabels(
+    { perJuz ? tr("Juz") : tr("Surah"), tr("Occurrences") });
+  for (int i = 0; i < counts.size(); i++) {
+    if (!counts.at(i))
+      continue;
+    const QString name = perJuz ? QString::number(i + 1) : m_surahNames.at(i);
+    m_treeCounts->addTopLevelItem(new QTreeWidgetItem(
+      QStringList{ name, QString::number(counts.at(i)) }));
+  }
+}
+
+void
+ConcordanceDialog::lineClicked(const QModelIndex& index)
+{
+  const int verse = m_model.occurrenceAt(index.row()).verse;
+  m_navigator.navigateToVerse(
+    Verse::fromId(verse, Configuration::getInstance().qcfVersion()));
+}
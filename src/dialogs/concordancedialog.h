@@ -0,0 +1,101 @@
+/**
+ * @file concordancedialog.h
+ * @brief Header file for ConcordanceDialog
+ */
+
+#ifndef CONCORDANCEDIALOG_H
+#define CONCORDANCEDIALOG_H
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDialog>
+#include <QFutureWatcher>
+#include <QLabel>
+#include <QLineEdit>
+#include <QTableView>
+#include <QTreeWidget>
+#include <navigation/navigator.h>
+#include <service/quranservice.h>
+#include <widgets/concordancemodel.h>
+
+/**
+ * @brief ConcordanceDialog shows every occurrence of a word in the mushaf.
+ * @details The typed word is looked up in the Concordance of the
+ * QuranService as it is typed, alone or with the words sharing its root or
+ * lemma when a morphology dataset is installed. The concordance is prepared
+ * in the background when the dialog is created, lookups wait for it. The
+ * number of occurrences per surah or per juz is listed next to the
+ * keyword-in-context line of every occurrence, clicking a line navigates to
+ * its verse.
+ */
+class ConcordanceDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Class constructor
+   * @param parent - pointer to parent widget
+   */
+  explicit ConcordanceDialog(QWidget* parent = nullptr);
+
+private slots:
+  /**
+   * @brief Looks up the typed word and updates the counts and lines.
+   */
+  void lookup();
+  /**
+   * @brief Fills the counts list grouped by surah or juz.
+   */
+  void fillCounts();
+  /**
+   * @brief Navigates to the verse of the clicked line.
+   * @param index - model index of the clicked line
+   */
+  void lineClicked(const QModelIndex& index);
+
+private:
+  /**
+   * @brief Words looked up for the typed word, indices of m_cmbForms.
+   */
+  enum FormsMatch
+  {
+    SameWord,
+    SameRoot,
+    SameLemma
+  };
+  /**
+   * @brief Reference to the Navigator instance used for navigating to verses.
+   */
+  Navigator& m_navigator;
+  /**
+   * @brief Pointer to the QuranService instance holding the concordance.
+   */
+  const QuranService* m_quranService;
+  /**
+   * @brief Names of the surahs shown in the counts and references.
+   */
+  const QStringList m_surahNames;
+  /**
+   * @brief Watches the background preparation of the concordance, the typed
+   * word is looked up once it finishes.
+   */
+  QFutureWatcher<bool> m_concordanceWatcher;
+  /**
+   * @brief Occurrences of the looked up word.
+   */
+  QList<Concordance::Occurrence> m_occurrences;
+  /**
+   * @brief Model of the keyword-in-context lines.
+   */
+  ConcordanceModel m_model;
+  QLineEdit* m_ledWord;
+  QCheckBox* m_chkPrefix;
+  QComboBox* m_cmbForms;
+  QComboBox* m_cmbGrouping;
+  QLabel* m_lbSummary;
+  QTreeWidget* m_treeCounts;
+  QTableView* m_tableLines;
+};
+
+#endif // CONCORDANCEDIALOG_H
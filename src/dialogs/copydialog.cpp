@@ -48,10 +48,12 @@ CopyDialog::copyRange()
 
   QString final = "{ ";
   QClipboard* clip = QApplication::clipboard();
-  for (int i = from; i <= to; i++) {
-    QString text = m_quranService->verseText(m_currVerse.surah(), i);
+  const QStringList texts =
+    m_quranService->verseTexts(m_currVerse.surah(), from, to);
+  for (int i = 0; i < texts.size(); i++) {
+    QString text = texts.at(i);
     text.remove(text.size() - 1, 1);
-    text += "(" + QString::number(i) + ") ";
+    text += "(" + QString::number(from + i) + ") ";
     final.append(text);
   }
 
@@ -5,10 +5,15 @@
 
 #include "searchdialog.h"
 #include "ui_searchdialog.h"
+#include <QtConcurrent>
+#include <repository/querycacherepository.h>
+#include <repository/tafsirsearchrepository.h>
+#include <search/morphology.h>
+#include <search/searchquery.h>
 #include <service/servicefactory.h>
-#include <utils/fontmanager.h>
+#include <utils/arabicnormalizer.h>
 #include <utils/stylemanager.h>
-#include <widgets/clickablelabel.h>
+#include <widgets/searchresultdelegate.h>
 
 SearchDialog::SearchDialog(QWidget* parent)
   : QDialog(parent)
@@ -17,17 +22,21 @@ SearchDialog::SearchDialog(QWidget* parent)
   , m_navigator(Navigator::getInstance())
   , m_quranService(ServiceFactory::quranService())
   , m_glyphService(ServiceFactory::glyphService())
+  , m_translationService(ServiceFactory::translationService())
+  , m_tafsirService(ServiceFactory::tafsirService())
+  , m_resultModel(m_quranService, m_glyphService)
 {
   setWindowIcon(StyleManager::getInstance().awesome().icon(
     fa::fa_solid, fa::fa_magnifying_glass));
   ui->setupUi(this);
-  ui->frmNavBtns->setLayoutDirection(Qt::LeftToRight);
-  ui->btnNext->setIcon(StyleManager::getInstance().awesome().icon(
-    fa::fa_solid, fa::fa_arrow_left));
-  ui->btnPrev->setIcon(StyleManager::getInstance().awesome().icon(
-    fa::fa_solid, fa::fa_arrow_right));
-  ui->btnNext->setDisabled(true);
-  ui->btnPrev->setDisabled(true);
+  ui->listResults->setModel(&m_resultModel);
+  SearchResultDelegate* delegate = new SearchResultDelegate(ui->listResults);
+  ui->listResults->setItemDelegate(delegate);
+  connect(&m_resultModel,
+          &SearchResultModel::rowsFetched,
+          delegate,
+          &SearchResultDelegate::rowsFetched);
+  ui->listResults->setMouseTracking(true);
 
   ui->btnTransfer->setIcon(StyleManager::getInstance().awesome().icon(
     fa::fa_solid, fa::fa_arrow_right_arrow_left));
@@ -36,6 +45,12 @@ SearchDialog::SearchDialog(QWidget* parent)
   if (m_config.language() == QLocale::Arabic)
     ui->searchTabWidget->setObjectName("rtlTabWidget");
 
+  // the morphology dataset is optional, it is only read once searched
+  ui->cmbMorphology->setVisible(m_quranService->hasMorphology());
+
+  m_searchTimer.setSingleShot(true);
+  m_searchTimer.setInterval(300);
+
   fillListView();
   // connectors
   setupConnections();
@@ -45,142 +60,385 @@ void
 SearchDialog::setupConnections()
 {
   connect(ui->btnSrch, &QPushButton::clicked, this, &SearchDialog::getResults);
-  connect(ui->btnNext, &QPushButton::clicked, this, &SearchDialog::moveFwd);
-  connect(ui->btnPrev, &QPushButton::clicked, this, &SearchDialog::moveBwd);
+  connect(
+    &m_searchTimer, &QTimer::timeout, this, &SearchDialog::getResults);
+  connect(ui->ledSearchBar,
+          &QLineEdit::textChanged,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->chkWholeWord,
+          &QCheckBox::toggled,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->chkApproximate,
+          &QCheckBox::toggled,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->chkCrossVerse,
+          &QCheckBox::toggled,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->chkSurahsOnly,
+          &QCheckBox::toggled,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->cmbOrder,
+          &QComboBox::currentIndexChanged,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->cmbSource,
+          &QComboBox::currentIndexChanged,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->cmbMorphology,
+          &QComboBox::currentIndexChanged,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->spnStartPage,
+          &QSpinBox::valueChanged,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(ui->spnEndPage,
+          &QSpinBox::valueChanged,
+          this,
+          &SearchDialog::scheduleSearch);
+  connect(&m_searchWatcher,
+          &QFutureWatcher<SearchResult>::finished,
+          this,
+          &SearchDialog::searchFinished);
+  // approximate matching ignores word boundaries and ranks by itself
+  connect(ui->chkApproximate,
+          &QCheckBox::toggled,
+          ui->chkWholeWord,
+          &QCheckBox::setDisabled);
+  connect(ui->chkApproximate,
+          &QCheckBox::toggled,
+          ui->chkCrossVerse,
+          &QCheckBox::setDisabled);
+  connect(ui->chkApproximate,
+          &QCheckBox::toggled,
+          ui->cmbOrder,
+          &QComboBox::setDisabled);
+  // the first search of a tafsir waits for it to be indexed
+  connect(&TafsirSearchRepository::getInstance(),
+          &TafsirSearchRepository::indexProgress,
+          this,
+          &SearchDialog::tafsirIndexProgress);
+  // translations and tafasir are searched by their own indices, exact
+  // matches only
+  // roots and lemmas are only known for the Quran text and match whole
+  // words of any form
+  // word positions across verses are only indexed for the Quran text
+  auto updateOptions = [this]() {
+    const bool quran = ui->cmbSource->currentIndex() == 0;
+    const bool morphology = quran && ui->cmbMorphology->currentIndex() > 0;
+    ui->cmbMorphology->setEnabled(quran);
+    ui->chkApproximate->setEnabled(quran && !morphology);
+    ui->chkCrossVerse->setEnabled(quran && !morphology &&
+                                  !ui->chkApproximate->isChecked());
+    ui->cmbOrder->setEnabled(quran && !morphology &&
+                             !ui->chkApproximate->isChecked());
+    ui->chkWholeWord->setEnabled(
+      !quran || (!morphology && !ui->chkApproximate->isChecked()));
+  };
+  connect(ui->cmbSource, &QComboBox::currentIndexChanged, this, updateOptions);
+  connect(
+    ui->cmbMorphology, &QComboBox::currentIndexChanged, this, updateOptions);
+  connect(ui->listResults,
+          &QListView::clicked,
+          this,
+          &SearchDialog::verseClicked);
   connect(ui->btnTransfer,
           &QPushButton::clicked,
           this,
           &SearchDialog::btnTransferClicked);
 }
 
-void
-SearchDialog::getResults()
+bool
+SearchDialog::SearchRequest::operator==(const SearchRequest& other) const
 {
-  m_searchText = ui->ledSearchBar->text().trimmed();
-
-  if (!m_lbLst.empty()) {
-    qDeleteAll(m_lbLst);
-    m_lbLst.clear();
-    m_currResults.clear();
-  }
+  return text == other.text && whole == other.whole &&
+         crossVerse == other.crossVerse && approximate == other.approximate &&
+         relevance == other.relevance &&
+         translations == other.translations && tafsir == other.tafsir &&
+         morphology == other.morphology && scope == other.scope &&
+         qcfVersion == other.qcfVersion;
+}
 
-  if (m_searchText.isEmpty()) {
-    ui->lbResultCount->setText("");
-    ui->btnNext->setDisabled(true);
-    ui->btnPrev->setDisabled(true);
-    return;
+SearchDialog::SearchRequest
+SearchDialog::currentRequest() const
+{
+  SearchRequest request;
+  request.text = ui->ledSearchBar->text().trimmed();
+  if (ui->cmbSource->currentIndex() == 1) {
+    for (const Translation& translation : Translation::translations)
+      if (translation.isAvailable())
+        request.translations.append(translation.id());
+  } else if (ui->cmbSource->currentIndex() == 2) {
+    std::optional<const Tafsir> tafsir = m_tafsirService->currTafsir();
+    request.tafsir = tafsir.has_value() ? tafsir->id() : QString();
   }
-
+  const bool quran = ui->cmbSource->currentIndex() == 0;
+  if (quran && !ui->cmbMorphology->isHidden() &&
+      ui->cmbMorphology->currentIndex() > 0)
+    request.morphology = ui->cmbMorphology->currentIndex() == 1
+                           ? Morphology::Root
+                           : Morphology::Lemma;
+  const bool words = request.morphology < 0;
+  request.approximate = quran && words && ui->chkApproximate->isChecked();
+  // phrases across verses are matched by word positions, whole words only
+  request.crossVerse =
+    quran && words && !request.approximate && ui->chkCrossVerse->isChecked();
+  request.whole = request.crossVerse || (words && !request.approximate &&
+                                         ui->chkWholeWord->isChecked());
+  request.relevance = quran && words && ui->cmbOrder->currentIndex() == 1;
+  request.qcfVersion = m_config.qcfVersion();
+
+  // the page range or the selected surahs limit the whole query
   if (!ui->chkSurahsOnly->isChecked()) {
-    int range[2];
-    range[0] = ui->spnStartPage->value();
-    if (ui->spnEndPage->value() < range[0])
-      ui->spnEndPage->setValue(range[0]);
-    range[1] = ui->spnEndPage->value();
-
-    m_currResults = m_quranService->searchVerses(
-      m_searchText, range, ui->chkWholeWord->isChecked());
+    request.scope = VerseBitset::pages(ui->spnStartPage->value(),
+                                       ui->spnEndPage->value(),
+                                       request.qcfVersion);
   } else {
-    m_currResults = m_quranService->searchSurahs(
-      m_searchText, m_selectedSurahMap.values(), ui->chkWholeWord->isChecked());
+    for (int surah : m_selectedSurahMap.values())
+      request.scope |= VerseBitset::surahs(surah, surah);
   }
-  ui->lbResultCount->setText(QString::number(m_currResults.size()) +
-                             tr(" Search results"));
-  m_startResult = 0;
-  showResults();
+  return request;
+}
+
+bool
+SearchDialog::canRefine(const SearchRequest& request) const
+{
+  if (!m_resultsCurrent || request.whole || request.approximate ||
+      m_request.whole || m_request.approximate || request.morphology >= 0 ||
+      m_request.morphology >= 0 ||
+      !request.translations.isEmpty() || !m_request.translations.isEmpty() ||
+      !request.tafsir.isEmpty() || !m_request.tafsir.isEmpty() ||
+      !(request.scope == m_request.scope) ||
+      request.qcfVersion != m_request.qcfVersion ||
+      !request.text.startsWith(m_request.text))
+    return false;
+
+  // operators or filters typed in the extension change the meaning of the
+  // query, only a longer phrase is guaranteed to match a subset
+  return SearchQuery(m_request.text).isPhrase() &&
+         SearchQuery(request.text).isPhrase();
 }
 
 void
-SearchDialog::verseClicked()
+SearchDialog::scheduleSearch()
 {
-  QStringList data = sender()->objectName().split('-');
-  Verse selected(data.at(0).toInt(), data.at(1).toInt(), data.at(2).toInt());
-  m_navigator.navigateToVerse(selected);
+  m_searchTimer.start();
 }
 
 void
-SearchDialog::showResults()
+SearchDialog::getResults()
 {
-  int endIdx = m_currResults.size() > m_startResult + 25 ? m_startResult + 25
-                                                         : m_currResults.size();
-
-  if (m_startResult == 0)
-    ui->btnPrev->setDisabled(true);
-  else
-    ui->btnPrev->setDisabled(false);
-  if (endIdx == m_currResults.size())
-    ui->btnNext->setDisabled(true);
-  else
-    ui->btnNext->setDisabled(false);
-
-  for (int i = m_startResult; i < endIdx; i++) {
-    Verse v = m_currResults.at(i);
-    QString fontName =
-      FontManager::getInstance().verseFontname(m_config.verseType(), v.page());
-
-    VerseFrame* vFrame = new VerseFrame(ui->srclResults);
-    QLabel* lbInfo = new QLabel(vFrame);
-    ClickableLabel* clkLb = new ClickableLabel(vFrame);
-
-    QString info = tr("Surah: ") +
-                   m_quranService->surahNames().at(v.surah() - 1) + " - " +
-                   tr("Verse: ") + QString::number(v.number());
-    QString glyphs = m_config.verseType() == ConfigurationSchema::Qcf
-                       ? m_glyphService->getVerseGlyphs(v.surah(), v.number())
-                       : m_quranService->verseText(v.surah(), v.number());
-
-    lbInfo->setText(info);
-    lbInfo->setMaximumHeight(50);
-    lbInfo->setAlignment(Qt::AlignLeft);
-    lbInfo->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
-
-    clkLb->setMargin(5);
-    clkLb->setObjectName(QString::number(v.page()) + '-' +
-                         QString::number(v.surah()) + '-' +
-                         QString::number(v.number()));
-    clkLb->setFont(QFont(fontName, 15));
-    clkLb->setText(glyphs);
-    clkLb->setAlignment(Qt::AlignLeft);
-    clkLb->setWordWrap(true);
-
-    connect(clkLb, &ClickableLabel::clicked, this, &SearchDialog::verseClicked);
-
-    vFrame->layout()->addWidget(lbInfo);
-    vFrame->layout()->addWidget(clkLb);
-    vFrame->setObjectName("F-" + clkLb->objectName());
-    ui->srclResults->layout()->addWidget(vFrame);
-    m_lbLst.append(vFrame);
+  m_searchTimer.stop();
+  if (ui->spnEndPage->value() < ui->spnStartPage->value())
+    ui->spnEndPage->setValue(ui->spnStartPage->value());
+
+  const SearchRequest request = currentRequest();
+  if (m_request == request && (m_resultsCurrent || m_searchWatcher.isRunning()))
+    return;
+
+  const bool refine = canRefine(request);
+  m_searchWatcher.future().cancel();
+  m_request = request;
+  m_resultsCurrent = false;
+
+  if (request.text.isEmpty() || (!request.approximate &&
+                                 !SearchQuery(request.text).isValid())) {
+    m_currResults.clear();
+    m_resultModel.setResults(m_currResults);
+    ui->lbResultCount->setText(
+      request.text.isEmpty()
+        ? QString()
+        : tr("Invalid search query: ") + SearchQuery(request.text).error());
+    return;
   }
 
-  ui->scrollArea->verticalScrollBar()->setValue(0);
+  m_searchWatcher.setFuture(QtConcurrent::run(&SearchDialog::runSearch,
+                                              m_quranService,
+                                              m_translationService,
+                                              m_tafsirService,
+                                              request,
+                                              m_currResults,
+                                              refine));
 }
 
 void
-SearchDialog::moveFwd()
+SearchDialog::runSearch(QPromise<SearchResult>& promise,
+                        const QuranService* service,
+                        const TranslationService* translationService,
+                        const TafsirService* tafsirService,
+                        const SearchRequest& request,
+                        const QList<Verse>& previous,
+                        bool refine)
 {
-  if (!m_currResults.empty() && m_startResult + 25 < m_currResults.size()) {
-    if (!m_lbLst.empty()) {
-      qDeleteAll(m_lbLst);
-      m_lbLst.clear();
-    }
-
-    m_startResult += 25;
-    showResults();
+  QList<Verse> results;
+  if (refine) {
+    results = service->refineSearch(previous, request.text);
+    // previous results may have been ordered by relevance
+    std::sort(results.begin(),
+              results.end(),
+              [](const Verse& a, const Verse& b) {
+                return Verse::id(a.surah(), a.number()) <
+                       Verse::id(b.surah(), b.number());
+              });
+  } else if (request.approximate) {
+    // approximate results are ranked, keep their order
+    for (const Verse& v : service->searchApproximate(request.text))
+      if (request.scope.test(Verse::id(v.surah(), v.number())))
+        results.append(v);
+  } else {
+    const int fullRange[2] = { 1, 604 };
+    auto matcher = [&](const QString& phrase) {
+      VerseBitset matches;
+      if (promise.isCanceled())
+        return matches;
+      if (!request.translations.isEmpty()) {
+        for (int id : translationService->searchTranslations(
+               phrase, request.translations, request.whole))
+          matches.set(id);
+        return matches;
+      }
+      if (!request.tafsir.isEmpty()) {
+        for (int id :
+             tafsirService->searchTafsir(phrase, request.tafsir, request.whole))
+          matches.set(id);
+        return matches;
+      }
+      if (request.morphology >= 0) {
+        for (int id : service->searchMorphology(
+               phrase, request.morphology == Morphology::Lemma))
+          matches.set(id);
+        return matches;
+      }
+      // Quran text matches are cached by phrase before the scope applies,
+      // so every scope shares them. The cache outlives the session, the
+      // backend is part of the key as whole words match differently
+      QueryCache& cache = QueryCacheRepository::getInstance().cache();
+      const QString mode = request.crossVerse ? "cross:"
+                           : request.whole    ? "whole:"
+                                              : "text:";
+      const QString key = service->searchBackend() + ':' + mode +
+                          ArabicNormalizer::tokens(phrase).join(' ');
+      if (std::optional<VerseBitset> cached = cache.find(key))
+        return *cached;
+      if (request.crossVerse) {
+        // a phrase running into the next verse matches the verse it starts in
+        for (const WordSpan& span : service->searchPhrase(phrase, true))
+          matches.set(span.verse);
+      } else {
+        for (const Verse& v :
+             service->searchVerses(phrase, fullRange, request.whole))
+          matches.set(Verse::id(v.surah(), v.number()));
+      }
+      if (!promise.isCanceled())
+        cache.insert(key, matches);
+      return matches;
+    };
+
+    auto nearMatcher =
+      [&](const QString& first, const QString& second, int distance) {
+        VerseBitset matches;
+        if (promise.isCanceled())
+          return matches;
+        for (const WordSpan& span :
+             service->searchNear(first, second, distance))
+          matches.set(span.verse);
+        return matches;
+      };
+
+    // word positions are only indexed for the Quran text, NEAR is evaluated
+    // as AND in translations, tafasir and morphological searches
+    SearchQuery::NearMatcher near;
+    if (request.translations.isEmpty() && request.tafsir.isEmpty() &&
+        request.morphology < 0)
+      near = nearMatcher;
+    VerseBitset matches =
+      SearchQuery(request.text).evaluate(matcher, request.qcfVersion, near);
+    matches &= request.scope;
+    for (int id : matches.ids())
+      results.append(Verse::fromId(id, request.qcfVersion));
   }
+
+  // only the phrases the results contain are scored, not the excluded ones
+  if (request.relevance && !request.approximate && !promise.isCanceled()) {
+    const QString terms =
+      SearchQuery(request.text).positivePhrases().join(' ');
+    results = service->rankSearch(results, terms, request.whole);
+  }
+
+  // the searched phrases are located in the Quran text by the engine, not
+  // in approximate or morphological results
+  SearchResult result{ results, {} };
+  if (request.translations.isEmpty() && request.tafsir.isEmpty() &&
+      !request.approximate && request.morphology < 0 && !promise.isCanceled())
+    result.words =
+      service->matchedWords(results,
+                            SearchQuery(request.text).positivePhrases(),
+                            request.whole,
+                            request.crossVerse);
+
+  if (!promise.isCanceled())
+    promise.addResult(result);
 }
 
 void
-SearchDialog::moveBwd()
+SearchDialog::searchFinished()
 {
-  if (!m_currResults.empty() && m_startResult > 0) {
-    if (!m_lbLst.empty()) {
-      qDeleteAll(m_lbLst);
-      m_lbLst.clear();
-    }
-
-    m_startResult -= 25;
-    showResults();
+  if (m_searchWatcher.isCanceled() || !m_searchWatcher.resultCount())
+    return;
+
+  const SearchResult result = m_searchWatcher.result();
+  m_currResults = result.verses;
+  m_resultsCurrent = true;
+
+  // excerpts are fetched per batch of shown rows, around any of the phrases
+  // the results contain, excluded phrases are never highlighted
+  SearchResultModel::SnippetProvider snippets;
+  if (!m_request.tafsir.isEmpty()) {
+    const TafsirService* service = m_tafsirService;
+    const QStringList phrases = SearchQuery(m_request.text).positivePhrases();
+    const QString id = m_request.tafsir;
+    const bool whole = m_request.whole;
+    snippets = [service, phrases, id, whole](const QList<int>& verses) {
+      return service->tafsirSnippets(phrases, id, verses, whole);
+    };
+  }
+
+  // the words matched by the search are mapped to the shown text of a row
+  // when it is fetched
+  SearchResultModel::MatchProvider matches;
+  if (!result.words.isEmpty()) {
+    const QuranService* service = m_quranService;
+    const QHash<int, QList<QPair<int, int>>> words = result.words;
+    matches = [service, words](const Verse& verse, const QString& text) {
+      return service->matchSpans(
+        verse, text, words.value(Verse::id(verse.surah(), verse.number())));
+    };
   }
+  m_resultModel.setResults(m_currResults, snippets, matches);
+  ui->listResults->scrollToTop();
+  ui->lbResultCount->setText(QString::number(m_currResults.size()) +
+                             tr(" Search results"));
+}
+
+void
+SearchDialog::tafsirIndexProgress(QString id, int done, int total)
+{
+  if (id != m_request.tafsir || m_resultsCurrent || total <= 0)
+    return;
+  ui->lbResultCount->setText(tr("Indexing tafsir: ") +
+                             QString::number(done * 100 / total) + '%');
+}
+
+void
+SearchDialog::verseClicked(const QModelIndex& index)
+{
+  m_navigator.navigateToVerse(m_resultModel.verseAt(index.row()));
 }
 
 void
@@ -227,20 +485,25 @@ SearchDialog::btnTransferClicked()
 void
 SearchDialog::closeEvent(QCloseEvent* event)
 {
-  if (!m_lbLst.empty()) {
-    qDeleteAll(m_lbLst);
-    m_lbLst.clear();
+  m_searchWatcher.future().cancel();
+  m_request = SearchRequest();
+  m_resultsCurrent = false;
+  if (!m_currResults.empty()) {
     ui->lbResultCount->setText("");
     ui->ledSearchBar->clear();
     m_currResults.clear();
-    ui->btnNext->setDisabled(true);
-    ui->btnPrev->setDisabled(true);
+    m_resultModel.setResults(m_currResults);
   }
+  // clearing the search bar schedules a search, stopped along with a pending
+  // one
+  m_searchTimer.stop();
 
   this->hide();
 }
 
 SearchDialog::~SearchDialog()
 {
+  m_searchWatcher.future().cancel();
+  m_searchWatcher.waitForFinished();
   delete ui;
 }
@@ -7,19 +7,24 @@
 #define SEARCHDIALOG_H
 
 #include <QDialog>
+#include <QFutureWatcher>
 #include <QPointer>
-#include <QScrollBar>
+#include <QPromise>
 #include <QSettings>
 #include <QShortcut>
 #include <QSpinBox>
 #include <QStandardItem>
 #include <QStandardItemModel>
+#include <QTimer>
 #include <navigation/navigator.h>
 #include <repository/glyphsrepository.h>
+#include <search/versebitset.h>
 #include <service/glyphservice.h>
 #include <service/quranservice.h>
+#include <service/tafsirservice.h>
+#include <service/translationservice.h>
 #include <types/verse.h>
-#include <widgets/verseframe.h>
+#include <widgets/searchresultmodel.h>
 
 namespace Ui {
 class SearchDialog;
@@ -27,9 +32,22 @@ class SearchDialog;
 
 /**
  * @brief SearchDialog is an interface for searching Quran verses.
- * @details Searching Quran verses is done through SQL Queries to the Quran
- * sqlite database. Searching options include using whole-word search, searching
- * within a page range, and searching within specific surahs only.
+ * @details The search text is parsed as a SearchQuery supporting AND/OR/NOT,
+ * quoted phrases and surah/juz/page filters, phrases are searched through the
+ * QuranService. Searching options include using whole-word search, phrases
+ * running across the end of a verse, searching within a page range, and
+ * searching within specific surahs only. Results are
+ * shown in a single list backed by a SearchResultModel, in mushaf order or
+ * with the most relevant verses first. The installed translations or the
+ * selected tafsir can be searched instead of the Quran text, tafsir results
+ * show an excerpt of the matching tafsir. When a morphology dataset is
+ * installed, the Quran text can be searched by the root or lemma of the
+ * searched words.
+ *
+ * Searches run as the user types: edits are debounced, the search runs on
+ * the global thread pool and a newer search cancels the one in progress.
+ * When a plain phrase is extended, the previous results are refined instead
+ * of searching all verses again.
  */
 class SearchDialog : public QDialog
 {
@@ -45,36 +63,18 @@ public:
 
 public slots:
   /**
-   * @brief Slot to get search results and update UI accordingly.
-   * @details Search queries are made using either a page range (default) or
-   * selected surahs. Results are displayed and navigation buttons are updated
-   * based on the search results.
+   * @brief Slot to start searching for the current search text and options.
+   * @details The search text is evaluated as a SearchQuery limited to either a
+   * page range (default) or the selected surahs. The search runs in the
+   * background and SearchDialog::searchFinished() displays its results.
    */
   void getResults();
   /**
-   * @brief Slot that is called when one of the result verse labels is clicked.
-   * Extracts a Verse from the emitting object name and emits
-   * SearchDialog::navigateToVerse(Verse) signal.
+   * @brief Slot that is called when one of the results is clicked. Navigates
+   * to the clicked verse.
+   * @param index - model index of the clicked result
    */
-  void verseClicked();
-  /**
-   * @brief Displays 25 entries from the search results.
-   * @details Search results are limited to 25 results per page. The starting
-   * index for the results to display is held in SearchDialog::m_startResult.
-   */
-  void showResults();
-  /**
-   * @brief Loads the next 25 search results in the results tab.
-   * @details Updates the view to show the next set of 25 results if available,
-   * and adjusts the navigation buttons accordingly.
-   */
-  void moveFwd();
-  /**
-   * @brief Loads the previous 25 search results in the results tab.
-   * @details Updates the view to show the previous set of 25 results if
-   * available, and adjusts the navigation buttons accordingly.
-   */
-  void moveBwd();
+  void verseClicked(const QModelIndex& index);
 
 protected:
   /**
@@ -94,8 +94,89 @@ private slots:
    * the surah number.
    */
   void btnTransferClicked();
+  /**
+   * @brief Restarts the debounce timer after the search text or options
+   * change.
+   */
+  void scheduleSearch();
+  /**
+   * @brief Displays the results of the finished background search. Results of
+   * cancelled searches are discarded.
+   */
+  void searchFinished();
+  /**
+   * @brief Shows the progress of indexing the searched tafsir.
+   * @param id - id of the tafsir being indexed
+   * @param done - number of indexed tafsir entries
+   * @param total - number of tafsir entries
+   */
+  void tafsirIndexProgress(QString id, int done, int total);
 
 private:
+  /**
+   * @brief Search text and options a background search runs with.
+   */
+  struct SearchRequest
+  {
+    QString text;
+    bool whole = false;
+    bool crossVerse = false; ///< phrases may continue into the next verse
+    bool approximate = false;
+    bool relevance = false;
+    QStringList translations; ///< searched translations, empty for the Quran
+    QString tafsir;           ///< searched tafsir, empty for the Quran
+    int morphology = -1;      ///< matched Morphology::Kind, -1 for words
+    VerseBitset scope;
+    int qcfVersion = 1;
+    bool operator==(const SearchRequest& other) const;
+  };
+  /**
+   * @brief Results of a background search.
+   */
+  struct SearchResult
+  {
+    QList<Verse> verses;
+    /**
+     * @brief First word offset and number of words of each match by verse
+     * id, located for Quran text searches only.
+     */
+    QHash<int, QList<QPair<int, int>>> words;
+  };
+  /**
+   * @brief Runs a search on a worker thread.
+   * @details The matched words of Quran text results are located too, so the
+   * rows shown don't search the verses again.
+   * @param promise - promise receiving the results, checked for cancellation
+   * between the searched phrases
+   * @param service - QuranService used for searching
+   * @param translationService - TranslationService used for searching
+   * translations
+   * @param tafsirService - TafsirService used for searching the tafsir
+   * @param request - search text and options
+   * @param previous - results of the previous search when refining
+   * @param refine - boolean value to narrow down the previous results instead
+   * of searching all verses
+   */
+  static void runSearch(QPromise<SearchResult>& promise,
+                        const QuranService* service,
+                        const TranslationService* translationService,
+                        const TafsirService* tafsirService,
+                        const SearchRequest& request,
+                        const QList<Verse>& previous,
+                        bool refine);
+  /**
+   * @brief Builds a SearchRequest from the current search text and options.
+   */
+  SearchRequest currentRequest() const;
+  /**
+   * @brief Check whether the results of the last search can be refined to
+   * get the results of the given request.
+   * @details Holds when the last search finished and both searches look for
+   * a plain phrase with the same options, the new phrase extending the old
+   * one. Whole-word, approximate, morphological, translation and tafsir
+   * searches are never refined.
+   */
+  bool canRefine(const SearchRequest& request) const;
   /**
    * @brief Pointer to the UI object for the dialog.
    */
@@ -117,6 +198,15 @@ private:
    * @brief Pointer to the GlyphService instance for accessing verse glyphs.
    */
   const GlyphService* m_glyphService;
+  /**
+   * @brief Pointer to the TranslationService instance for searching
+   * translations.
+   */
+  const TranslationService* m_translationService;
+  /**
+   * @brief Pointer to the TafsirService instance for searching the tafsir.
+   */
+  const TafsirService* m_tafsirService;
   /**
    * @brief Connects signals and slots for different UI components and
    * shortcuts.
@@ -127,14 +217,9 @@ private:
    */
   void fillListView();
   /**
-   * @brief Index of the first search result to show in
-   * SearchDialog::m_currResults.
+   * @brief Model of the search results shown in the results list.
    */
-  int m_startResult = 0;
-  /**
-   * @brief List for all visible VerseFrame widgets containing search results.
-   */
-  QList<QPointer<VerseFrame>> m_lbLst;
+  SearchResultModel m_resultModel;
   /**
    * @brief List of verses for the current search results.
    */
@@ -145,9 +230,22 @@ private:
    */
   QMap<QString, int> m_selectedSurahMap;
   /**
-   * @brief Current search text entered by the user.
+   * @brief Request of the running or last finished search.
+   */
+  SearchRequest m_request;
+  /**
+   * @brief Whether SearchDialog::m_currResults holds the results of
+   * SearchDialog::m_request.
+   */
+  bool m_resultsCurrent = false;
+  /**
+   * @brief Single shot timer delaying the search until the user stops typing.
+   */
+  QTimer m_searchTimer;
+  /**
+   * @brief Watches the running background search.
    */
-  QString m_searchText;
+  QFutureWatcher<SearchResult> m_searchWatcher;
   /**
    * @brief Model for the QListView that shows all surahs to select from.
    */
@@ -0,0 +1,67 @@
+/**
+ * @file similarversesdialog.cpp
+ * @brief Implementation file for SimilarVersesDialog
+ */
+
+#include "similarversesdialog.h"
+#include <QVBoxLayout>
+#include <service/servicefactory.h>
+#include <utils/stylemanager.h>
+#include <widgets/searchresultdelegate.h>
+
+SimilarVersesDialog::SimilarVersesDialog(QWidget* parent)
+  : QDialog(parent)
+  , m_navigator(Navigator::getInstance())
+  , m_quranService(ServiceFactory::quranService())
+  , m_resultModel(m_quranService, ServiceFactory::glyphService())
+  , m_lbTitle(new QLabel(this))
+  , m_listResults(new QListView(this))
+{
+  setWindowTitle(tr("Similar Verses"));
+  setWindowIcon(
+    StyleManager::getInstance().awesome().icon(fa::fa_solid, fa::fa_clone));
+  resize(640, 520);
+
+  m_lbTitle->setWordWrap(true);
+  m_listResults->setModel(&m_resultModel);
+  m_listResults->setItemDelegate(new SearchResultDelegate(m_listResults));
+  m_listResults->setMouseTracking(true);
+  m_listResults->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+  m_listResults->setResizeMode(QListView::Adjust);
+  m_listResults->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(m_lbTitle);
+  layout->addWidget(m_listResults);
+
+  connect(m_listResults,
+          &QListView::clicked,
+          this,
+          &SimilarVersesDialog::verseClicked);
+}
+
+void
+SimilarVersesDialog::showSimilarVerses(const Verse& verse)
+{
+  const QList<Verse> similar =
+    m_quranService->similarVerses(verse, resultLimit);
+  m_resultModel.setResults(similar);
+  m_listResults->scrollToTop();
+
+  const QString source =
+    tr("Surah: ") + m_quranService->surahNames().at(verse.surah() - 1) +
+    " - " + tr("Verse: ") + QString::number(verse.number());
+  m_lbTitle->setText(similar.isEmpty()
+                       ? tr("No verses similar to ") + source
+                       : tr("Verses similar to ") + source);
+
+  show();
+  raise();
+  activateWindow();
+}
+
+void
+SimilarVersesDialog::verseClicked(const QModelIndex& index)
+{
+  m_navigator.navigateToVerse(m_resultModel.verseAt(index.row()));
+}
@@ -0,0 +1,76 @@
+/**
+ * @file similarversesdialog.h
+ * @brief Header file for SimilarVersesDialog
+ */
+
+#ifndef SIMILARVERSESDIALOG_H
+#define SIMILARVERSESDIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QListView>
+#include <navigation/navigator.h>
+#include <service/glyphservice.h>
+#include <service/quranservice.h>
+#include <types/verse.h>
+#include <widgets/searchresultmodel.h>
+
+/**
+ * @brief SimilarVersesDialog lists the verses worded most like a verse.
+ * @details Meant for memorizers reviewing mutashabihat, the similar verses
+ * come from QuranService::similarVerses() and are shown most similar first
+ * in the same list view as search results. Clicking a verse navigates to it.
+ */
+class SimilarVersesDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Class constructor
+   * @param parent - pointer to parent widget
+   */
+  explicit SimilarVersesDialog(QWidget* parent = nullptr);
+
+public slots:
+  /**
+   * @brief Shows the verses similar to the given verse.
+   * @param verse - Verse to find similar verses for
+   */
+  void showSimilarVerses(const Verse& verse);
+
+private slots:
+  /**
+   * @brief Navigates to the clicked verse.
+   * @param index - model index of the clicked verse
+   */
+  void verseClicked(const QModelIndex& index);
+
+private:
+  /**
+   * @brief Maximum number of listed verses.
+   */
+  static const int resultLimit = 30;
+  /**
+   * @brief Reference to the Navigator instance used for navigating to verses.
+   */
+  Navigator& m_navigator;
+  /**
+   * @brief Pointer to the QuranService instance for finding similar verses.
+   */
+  const QuranService* m_quranService;
+  /**
+   * @brief Model of the listed verses.
+   */
+  SearchResultModel m_resultModel;
+  /**
+   * @brief Label describing the verse the list is for.
+   */
+  QLabel* m_lbTitle;
+  /**
+   * @brief View of the similar verses.
+   */
+  QListView* m_listResults;
+};
+
+#endif // SIMILARVERSESDIALOG_H
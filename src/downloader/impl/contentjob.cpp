@@ -1,6 +1,8 @@
 #include "contentjob.h"
 #include "tafsirtask.h"
 #include "translationtask.h"
+#include <repository/tafsirsearchrepository.h>
+#include <repository/translationsearchrepository.h>
 
 ContentJob::ContentJob(Type type, int idx)
   : m_idx(idx)
@@ -23,6 +25,19 @@ ContentJob::ContentJob(Type type, int idx)
           &TaskDownloader::downloadSpeedUpdated,
           this,
           &DownloadJob::downloadSpeedUpdated);
+
+  // downloaded translations and tafasir are indexed for search right away,
+  // an existing index is verified against the new file
+  if (type == DownloadJob::TranslationFile)
+    connect(this, &DownloadJob::finished, this, [this]() {
+      TranslationSearchRepository::getInstance().prepareIndex(
+        m_translations.at(m_idx), true);
+    });
+  else if (type == DownloadJob::TafsirFile)
+    connect(this, &DownloadJob::finished, this, [this]() {
+      TafsirSearchRepository::getInstance().prepareIndex(m_tafasir.at(m_idx),
+                                                         true);
+    });
 }
 
 void
@@ -6,6 +6,8 @@
 #include <QApplication>
 #include <QSplashScreen>
 #include <components/mainwindow.h>
+#include <repository/querycacherepository.h>
+#include <repository/statementregistry.h>
 #include <types/reciter.h>
 #include <types/tafsir.h>
 #include <types/translation.h>
@@ -13,6 +15,7 @@
 #include <utils/dirmanager.h>
 #include <utils/fontmanager.h>
 #include <utils/logger.h>
+#include <utils/pagedocumentcache.h>
 #include <utils/shortcuthandler.h>
 #include <utils/stylemanager.h>
 
@@ -50,6 +53,9 @@ main(int argc, char* argv[])
   w.show();
 
   int exitcode = a.exec();
+  QueryCacheRepository::getInstance().save();
+  PageDocumentCache::getInstance().logStatistics();
+  StatementRegistry::logStatistics();
   Logger::stopLogger();
   return exitcode;
 }
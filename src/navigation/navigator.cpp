@@ -1,9 +1,11 @@
 #include "navigator.h"
+#include <generated/quranmetadata.h>
 #include <service/servicefactory.h>
 
 Navigator::Navigator()
   : QObject()
   , m_currVerse(Verse::getCurrent())
+  , m_config(Configuration::getInstance())
   , m_quranService(ServiceFactory::quranService())
 {
 }
@@ -44,7 +46,8 @@ Navigator::navigateToVerse(const Verse& verse)
 void
 Navigator::navigateToSurah(int surah)
 {
-  Verse start(m_quranService->versePage(surah, 1),
+  int id = QuranMetadata::verseId(surah, 1);
+  Verse start(QuranMetadata::versePage[m_config.qcfVersion() - 1][id - 1],
               surah,
               (surah == 1 || surah == 9) ? 1 : 0);
   navigateToVerse(start);
@@ -60,7 +63,11 @@ Navigator::navigateToPage(int page)
 void
 Navigator::navigateToJuz(int juz)
 {
-  Verse juzStart = m_quranService->getJuzStart(juz);
+  int id = QuranMetadata::juzFirstVerse[juz];
+  int surah = QuranMetadata::surahOf(id);
+  Verse juzStart(QuranMetadata::versePage[m_config.qcfVersion() - 1][id - 1],
+                 surah,
+                 id - QuranMetadata::surahOffset[surah - 1]);
   navigateToVerse(juzStart);
 }
 
@@ -100,7 +107,8 @@ Navigator::navigateToPreviousSurah()
 void
 Navigator::navigateToNextJuz()
 {
-  int juz = m_quranService->getVerseJuz(m_currVerse);
+  int juz = QuranMetadata::juzOf(
+    Verse::id(m_currVerse.surah(), std::max(1, m_currVerse.number())));
   if (juz < 30)
     navigateToJuz(juz + 1);
 }
@@ -108,7 +116,8 @@ Navigator::navigateToNextJuz()
 void
 Navigator::navigateToPreviousJuz()
 {
-  int juz = m_quranService->getVerseJuz(m_currVerse);
+  int juz = QuranMetadata::juzOf(
+    Verse::id(m_currVerse.surah(), std::max(1, m_currVerse.number())));
   if (juz > 1)
     navigateToJuz(juz - 1);
 }
@@ -6,6 +6,7 @@
 #include <navigation/verseobserver.h>
 #include <service/quranservice.h>
 #include <types/verse.h>
+#include <utils/configuration.h>
 
 /**
  * @class Navigator
@@ -94,6 +95,7 @@ public:
 private:
   Navigator();        ///< Private constructor for singleton pattern.
   Verse& m_currVerse; ///< Reference to the current verse being displayed.
+  const Configuration& m_config; ///< Reference to the app configuration.
   const QuranService* m_quranService; ///< Pointer to the Quran service for
                                       ///< accessing verse information.
   QList<VerseObserver*>
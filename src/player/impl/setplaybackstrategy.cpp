@@ -15,6 +15,18 @@ SetPlaybackStrategy::SetPlaybackStrategy(Verse start,
   , m_current(Verse::getCurrent())
   , m_quranService(ServiceFactory::quranService())
 {
+  const QList<Verse> verses = m_quranService->verseInfoRange(
+    Verse::id(m_start.surah(), m_start.number()),
+    Verse::id(m_end.surah(), m_end.number()));
+  m_playlist.reserve(verses.size());
+  for (const Verse& v : verses) {
+    if (v.number() == 1 && v.surah() != 1 && v.surah() != 9 && v != m_start) {
+      Verse basmallah(v);
+      basmallah.setNumber(0);
+      m_playlist.append(basmallah);
+    }
+    m_playlist.append(v);
+  }
 }
 
 Verse
@@ -44,7 +56,11 @@ SetPlaybackStrategy::nextVerse()
       m_currentIteration++;
       return m_start;
     } else {
-      return m_quranService->next(m_current, true);
+      const int index = playlistIndex();
+      if (index < 0 || index + 1 >= m_playlist.size())
+        return m_quranService->next(m_current, true);
+      m_position = index + 1;
+      return m_playlist.at(m_position);
     }
   } else {
     m_currentRepetition++;
@@ -57,3 +73,14 @@ SetPlaybackStrategy::verseInRange(const Verse& v)
 {
   return v >= m_start && v <= m_end;
 }
+
+int
+SetPlaybackStrategy::playlistIndex()
+{
+  if (m_position < m_playlist.size() && m_playlist.at(m_position) == m_current)
+    return m_position;
+  const int index = m_playlist.indexOf(m_current);
+  if (index >= 0)
+    m_position = index;
+  return index;
+}
@@ -20,6 +20,11 @@ public:
   bool verseInRange(const Verse& v) override;
 
 private:
+  /**
+   * @brief Gets the index of the current verse in the playlist, -1 if it is
+   * not part of it.
+   */
+  int playlistIndex();
   int m_repeatCount;
   int m_verseFrequency;
   int m_currentIteration;
@@ -28,6 +33,15 @@ private:
   const Verse& m_current;
   Verse m_start;
   Verse m_end;
+  /**
+   * @brief Verses from start to end with the basmallah before each surah,
+   * fetched once when the strategy is created.
+   */
+  QList<Verse> m_playlist;
+  /**
+   * @brief Index of the last verse returned from the playlist.
+   */
+  int m_position = 0;
 };
 
 #endif // SETPLAYBACKSTRATEGY_H
@@ -1,5 +1,4 @@
 #include "betaqatrepository.h"
-#include <QSqlQuery>
 
 BetaqatRepository&
 BetaqatRepository::getInstance()
@@ -12,6 +11,7 @@ BetaqatRepository::BetaqatRepository()
   : QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "BetaqatCon"))
   , m_assetsDir(DirManager::getInstance().assetsDir())
   , m_config(Configuration::getInstance())
+  , m_statements("BetaqatCon")
 {
   BetaqatRepository::open();
 }
@@ -19,9 +19,16 @@ BetaqatRepository::BetaqatRepository()
 void
 BetaqatRepository::open()
 {
+  m_statements.clear();
   setDatabaseName(m_assetsDir.absoluteFilePath("betaqat.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening betaqat db");
+
+  // the UI language is fixed for the session
+  if (m_config.language() == QLocale::Arabic)
+    m_statements.prepare("betaqa", "SELECT text FROM content WHERE sura=?");
+  else
+    m_statements.prepare("betaqa", "SELECT text_en FROM content WHERE sura=?");
 }
 
 DbConnection::Type
@@ -33,18 +40,5 @@ BetaqatRepository::type()
 QString
 BetaqatRepository::getBetaqa(const int surah) const
 {
-  QSqlQuery dbQuery(*this);
-
-  if (m_config.language() == QLocale::Arabic)
-    dbQuery.prepare("SELECT text FROM content WHERE sura=:i");
-  else
-    dbQuery.prepare("SELECT text_en FROM content WHERE sura=:i");
-
-  dbQuery.bindValue(0, surah);
-  if (!dbQuery.exec()) {
-    qCritical() << "Error occurred during getBetaqa SQL statment exec";
-  }
-
-  dbQuery.next();
-  return dbQuery.value(0).toString();
+  return m_statements.scalar<QString>("betaqa", { surah });
 }
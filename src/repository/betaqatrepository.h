@@ -4,6 +4,7 @@
 #include <QDir>
 #include <QSqlDatabase>
 #include <repository/dbconnection.h>
+#include <repository/statementregistry.h>
 #include <utils/configuration.h>
 #include <utils/dirmanager.h>
 
@@ -52,6 +53,10 @@ private:
    * @brief Reference to the application assets directory.
    */
   const QDir& m_assetsDir;
+  /**
+   * @brief Statements prepared once when the connection is opened.
+   */
+  mutable StatementRegistry m_statements;
 };
 
 #endif // BETAQATREPOSITORY_H
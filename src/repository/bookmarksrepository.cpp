@@ -1,5 +1,4 @@
 #include "bookmarksrepository.h"
-#include <QSqlError>
 #include <QSqlQuery>
 #include <service/servicefactory.h>
 
@@ -15,8 +14,20 @@ BookmarksRepository::BookmarksRepository()
   , m_config(Configuration::getInstance())
   , m_configDir(DirManager::getInstance().configDir())
   , m_quranService(ServiceFactory::quranService())
+  , m_statements("BookmarksCon")
 {
   BookmarksRepository::open();
+}
+
+void
+BookmarksRepository::open()
+{
+  m_statements.clear();
+  setDatabaseName(m_configDir.absoluteFilePath("bookmarks.db"));
+  if (!QSqlDatabase::open())
+    qFatal("Error opening bookmarks db");
+
+  // tables must exist before statements referencing them can be prepared
   QSqlQuery dbQuery(*this);
   dbQuery.exec(
     "CREATE TABLE IF NOT EXISTS khatmah(id INTEGER PRIMARY KEY "
@@ -29,14 +40,50 @@ BookmarksRepository::BookmarksRepository()
   dbQuery.exec("CREATE TABLE IF NOT EXISTS thoughts(id INTEGER PRIMARY KEY "
                "UNIQUE,"
                "page INTEGER, surah INTEGER, number INTEGER, text TEXT)");
-}
 
-void
-BookmarksRepository::open()
-{
-  setDatabaseName(m_configDir.absoluteFilePath("bookmarks.db"));
-  if (!QSqlDatabase::open())
-    qFatal("Error opening bookmarks db");
+  m_statements.prepare(
+    "saveKhatmah", "UPDATE khatmah SET page=?, surah=?, number=? WHERE id=?");
+  m_statements.prepare("allKhatmah", "SELECT id FROM khatmah");
+  m_statements.prepare("khatmahName", "SELECT name FROM khatmah WHERE id=?");
+  m_statements.prepare("khatmahVerse",
+                       "SELECT page,surah,number FROM khatmah WHERE id=?");
+  m_statements.prepare(
+    "insertKhatmah",
+    "INSERT INTO khatmah(name, page, surah, number) VALUES (?, ?, ?, ?)");
+  m_statements.prepare("replaceKhatmah",
+                       "REPLACE INTO khatmah(id, name, page, surah, number) "
+                       "VALUES (?, ?, ?, ?, ?)");
+  m_statements.prepare("lastKhatmah",
+                       "SELECT id FROM khatmah ORDER BY id DESC LIMIT 1");
+  m_statements.prepare("khatmahByName",
+                       "SELECT DISTINCT id FROM khatmah WHERE name=?");
+  m_statements.prepare("renameKhatmah",
+                       "UPDATE khatmah SET name=? WHERE id=?");
+  m_statements.prepare("removeKhatmah", "DELETE FROM khatmah WHERE id=?");
+  m_statements.prepare(
+    "bookmarks",
+    "SELECT page,surah,number FROM favorites ORDER BY surah, number");
+  m_statements.prepare("surahBookmarks",
+                       "SELECT page,surah,number FROM favorites WHERE surah=? "
+                       "ORDER BY surah, number");
+  m_statements.prepare(
+    "isBookmarked",
+    "SELECT page FROM favorites WHERE page=? AND surah=? AND number=?");
+  m_statements.prepare(
+    "addBookmark",
+    "INSERT INTO favorites(page, surah, number) VALUES (?, ?, ?)");
+  m_statements.prepare(
+    "removeBookmark",
+    "DELETE FROM favorites WHERE page=? AND surah=? AND number=?");
+  m_statements.prepare("saveThoughts",
+                       "REPLACE INTO thoughts(id, page, surah, number, text) "
+                       "VALUES(?, ?, ?, ?, ?)");
+  m_statements.prepare(
+    "thoughts",
+    "SELECT text FROM thoughts WHERE page=? AND surah=? AND number=?");
+  m_statements.prepare(
+    "allThoughts",
+    "SELECT page,surah,number,text FROM thoughts WHERE text!=''");
 }
 
 DbConnection::Type
@@ -48,14 +95,10 @@ BookmarksRepository::type()
 bool
 BookmarksRepository::saveActiveKhatmah(const Verse& verse)
 {
-  QSqlQuery dbQuery(*this);
-  QString q = QString::asprintf(
-    "UPDATE khatmah SET page=%i, surah=%i, number=%i WHERE id=%i",
-    verse.page(),
-    verse.surah(),
-    verse.number(),
-    m_activeKhatmah);
-  if (!dbQuery.exec(q)) {
+  QSqlQuery& query = m_statements.exec(
+    "saveKhatmah",
+    { verse.page(), verse.surah(), verse.number(), m_activeKhatmah });
+  if (!query.isActive()) {
     qCritical() << "Couldn't save position in mushaf";
     return false;
   }
@@ -68,45 +111,29 @@ BookmarksRepository::saveActiveKhatmah(const Verse& verse)
 QList<int>
 BookmarksRepository::getAllKhatmah() const
 {
-  QList<int> res;
-  QSqlQuery dbQuery(*this);
-  if (!dbQuery.exec("SELECT id FROM khatmah"))
-    qCritical() << "Couldn't execute sql query: " << dbQuery.lastQuery();
-
-  while (dbQuery.next())
-    res.append(dbQuery.value(0).toInt());
-
-  return res;
+  return m_statements.column<int>("allKhatmah");
 }
 
 QString
 BookmarksRepository::getKhatmahName(const int id) const
 {
-  QSqlQuery dbQuery(*this);
-  if (!dbQuery.exec("SELECT name FROM khatmah WHERE id=" + QString::number(id)))
-    qCritical() << "Couldn't execute sql query: " << dbQuery.lastQuery();
-
-  dbQuery.next();
-  return dbQuery.value(0).toString();
+  return m_statements.scalar<QString>("khatmahName", { id });
 }
 
 std::optional<Verse>
 BookmarksRepository::loadVerse(const int khatmahId) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString q = QString::asprintf(
-    "SELECT page,surah,number FROM khatmah WHERE id=%i", khatmahId);
-  if (!dbQuery.exec(q)) {
+  QSqlQuery& query = m_statements.exec("khatmahVerse", { khatmahId });
+  if (!query.isActive()) {
     qCritical() << "Couldn't execute getPosition SQL query!";
     return std::nullopt;
   }
-  if (!dbQuery.next())
+  if (!query.next())
     return std::nullopt;
 
-  int page = dbQuery.value(0).toInt();
-  int surah = dbQuery.value(1).toInt();
-  int num = dbQuery.value(2).toInt();
+  int page = query.value(0).toInt();
+  int surah = query.value(1).toInt();
+  int num = query.value(2).toInt();
   return std::optional<Verse>(Verse(page, surah, num));
 }
 
@@ -115,57 +142,41 @@ BookmarksRepository::addKhatmah(const Verse& verse,
                                 const QString name,
                                 const int id) const
 {
-  QSqlQuery dbQuery(*this);
-  QString q;
-  if (id == -1) {
-    q = "INSERT INTO khatmah(name, page, surah, number) VALUES ('%0', %1, %2, "
-        "%3)";
-    dbQuery.prepare(q.arg(name,
-                          QString::number(verse.page()),
-                          QString::number(verse.surah()),
-                          QString::number(verse.number())));
-  } else {
-    q = "REPLACE INTO khatmah VALUES "
-        "(%0, "
-        "'%1', %2, %3, %4)";
-    dbQuery.prepare(q.arg(QString::number(id),
-                          name,
-                          QString::number(verse.page()),
-                          QString::number(verse.surah()),
-                          QString::number(verse.number())));
-  }
-
-  if (!dbQuery.exec()) {
+  bool success;
+  if (id == -1)
+    success = m_statements
+                .exec("insertKhatmah",
+                      { name, verse.page(), verse.surah(), verse.number() })
+                .isActive();
+  else
+    success =
+      m_statements
+        .exec("replaceKhatmah",
+              { id, name, verse.page(), verse.surah(), verse.number() })
+        .isActive();
+
+  if (!success) {
     qCritical() << "Couldn't create new khatmah entry!";
-    qDebug() << lastError();
     return -1;
   }
 
   if (id != -1)
     return id;
 
-  dbQuery.exec("SELECT id FROM khatmah ORDER BY id DESC limit 1");
-  dbQuery.next();
-  return dbQuery.value(0).toInt();
+  return m_statements.scalar<int>("lastKhatmah");
 }
 
 bool
 BookmarksRepository::editKhatmahName(const int khatmahId, QString newName)
 {
-  QSqlQuery dbQuery(*this);
-  QString q = "SELECT DISTINCT id FROM khatmah WHERE name='%0'";
-  if (!dbQuery.exec(q.arg(newName))) {
-    qCritical() << "Couldn't execute sql query: " << dbQuery.lastQuery();
-    qDebug() << lastError();
+  QSqlQuery& query = m_statements.exec("khatmahByName", { newName });
+  if (!query.isActive())
     return false;
-  }
-  if (dbQuery.next())
+  if (query.next())
     return false;
 
-  q = "UPDATE khatmah SET name='%0' WHERE id=%1";
-  if (!dbQuery.exec(q.arg(newName, QString::number(khatmahId)))) {
+  if (!m_statements.exec("renameKhatmah", { newName, khatmahId }).isActive()) {
     qCritical() << "Couldn't rename khatmah entry!";
-    qDebug() << lastError();
     return false;
   }
 
@@ -176,28 +187,20 @@ BookmarksRepository::editKhatmahName(const int khatmahId, QString newName)
 void
 BookmarksRepository::removeKhatmah(const int id) const
 {
-  QSqlQuery dbQuery(*this);
-  if (!dbQuery.exec(QString::asprintf("DELETE FROM khatmah WHERE id=%i", id)))
-    qDebug() << "Couldn't execute query: " << dbQuery.lastQuery();
+  m_statements.exec("removeKhatmah", { id });
 }
 
 QList<Verse>
 BookmarksRepository::bookmarkedVerses(int surahIdx) const
 {
   QList<Verse> results;
-  QSqlQuery dbQuery(*this);
-  QString q = "SELECT page,surah,number FROM favorites";
-  if (surahIdx != -1)
-    q.append(" WHERE surah=" + QString::number(surahIdx));
-
-  dbQuery.prepare(q.append(" ORDER BY surah, number"));
-  if (!dbQuery.exec())
-    qCritical() << "Couldn't execute bookmarkedVerses SELECT query";
-
-  while (dbQuery.next()) {
-    results.append(Verse(dbQuery.value(0).toInt(),
-                         dbQuery.value(1).toInt(),
-                         dbQuery.value(2).toInt()));
+  QSqlQuery& query = surahIdx == -1
+                       ? m_statements.exec("bookmarks")
+                       : m_statements.exec("surahBookmarks", { surahIdx });
+
+  while (query.next()) {
+    results.append(Verse(
+      query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt()));
   }
 
   return results;
@@ -206,36 +209,22 @@ BookmarksRepository::bookmarkedVerses(int surahIdx) const
 bool
 BookmarksRepository::isBookmarked(const Verse& verse) const
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare(
-    "SELECT page FROM favorites WHERE page=:p AND surah=:s AND number=:n");
-  dbQuery.bindValue(0, verse.page());
-  dbQuery.bindValue(1, verse.surah());
-  dbQuery.bindValue(2, verse.number());
-
-  if (!dbQuery.exec()) {
+  QSqlQuery& query = m_statements.exec(
+    "isBookmarked", { verse.page(), verse.surah(), verse.number() });
+  if (!query.isActive()) {
     qWarning() << "Couldn't check if verse is bookmarked";
     return false;
   }
 
-  dbQuery.next();
-
-  return dbQuery.isValid();
+  return query.next();
 }
 
 bool
 BookmarksRepository::addBookmark(const Verse& verse)
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare(
-    "INSERT INTO favorites(page, surah, number) VALUES (:p, :s, :n)");
-  dbQuery.bindValue(0, verse.page());
-  dbQuery.bindValue(1, verse.surah());
-  dbQuery.bindValue(2, verse.number());
-
-  if (!dbQuery.exec()) {
+  QSqlQuery& query = m_statements.exec(
+    "addBookmark", { verse.page(), verse.surah(), verse.number() });
+  if (!query.isActive()) {
     qWarning() << "Couldn't add verse to bookmarks db";
     return false;
   }
@@ -247,14 +236,9 @@ BookmarksRepository::addBookmark(const Verse& verse)
 bool
 BookmarksRepository::removeBookmark(const Verse& verse)
 {
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare(
-    "DELETE FROM favorites WHERE page=:p AND surah=:s AND number=:n");
-  dbQuery.bindValue(0, verse.page());
-  dbQuery.bindValue(1, verse.surah());
-  dbQuery.bindValue(2, verse.number());
-
-  if (!dbQuery.exec()) {
+  QSqlQuery& query = m_statements.exec(
+    "removeBookmark", { verse.page(), verse.surah(), verse.number() });
+  if (!query.isActive()) {
     qWarning() << "Couldn't remove verse from bookmarks";
     return false;
   }
@@ -266,50 +250,28 @@ void
 BookmarksRepository::saveThoughts(Verse& verse, const QString& text)
 {
   int id = Verse::id(verse.surah(), verse.number());
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare("REPLACE INTO thoughts(id, page, surah, number, text) "
-                  "VALUES(:i, :p, :s, :n, :t)");
-  dbQuery.bindValue(0, id);
-  dbQuery.bindValue(1, verse.page());
-  dbQuery.bindValue(2, verse.surah());
-  dbQuery.bindValue(3, verse.number());
-  dbQuery.bindValue(4, text);
-
-  if (!dbQuery.exec())
-    qCritical() << "SQL statement execution error:" << dbQuery.lastError();
-
+  m_statements.exec("saveThoughts",
+                    { id, verse.page(), verse.surah(), verse.number(), text });
   commit();
 }
 
 QString
 BookmarksRepository::getThoughts(const Verse& verse) const
 {
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare(
-    "SELECT text FROM thoughts WHERE page=:p AND surah=:s AND number=:n");
-  dbQuery.bindValue(0, verse.page());
-  dbQuery.bindValue(1, verse.surah());
-  dbQuery.bindValue(2, verse.number());
-
-  if (!dbQuery.exec())
-    qCritical() << "SQL statement execution error:" << dbQuery.lastError();
-
-  dbQuery.next();
-  return dbQuery.value(0).toString();
+  return m_statements.scalar<QString>(
+    "thoughts", { verse.page(), verse.surah(), verse.number() });
 }
 
 QList<QPair<Verse, QString>>
 BookmarksRepository::allThoughts() const
 {
   QList<QPair<Verse, QString>> all;
-  QSqlQuery dbQuery(*this);
-  dbQuery.exec("SELECT page,surah,number,text FROM thoughts WHERE text!=''");
-  while (dbQuery.next()) {
-    const Verse verse(dbQuery.value(0).toInt(),
-                      dbQuery.value(1).toInt(),
-                      dbQuery.value(2).toInt());
+  QSqlQuery& query = m_statements.exec("allThoughts");
+  while (query.next()) {
+    const Verse verse(
+      query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt());
 
-    all.append({ verse, dbQuery.value(3).toString() });
+    all.append({ verse, query.value(3).toString() });
   }
 
   return all;
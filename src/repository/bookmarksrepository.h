@@ -7,6 +7,7 @@
 #include <QSqlDatabase>
 #include <notifiers/bookmarksnotifier.h>
 #include <repository/dbconnection.h>
+#include <repository/statementregistry.h>
 #include <service/quranservice.h>
 #include <types/verse.h>
 #include <utils/configuration.h>
@@ -163,6 +164,10 @@ private:
    * @brief Integer ID of the current active khatmah.
    */
   int m_activeKhatmah = 0;
+  /**
+   * @brief Statements prepared once when the connection is opened.
+   */
+  mutable StatementRegistry m_statements;
 };
 
 #endif // BOOKMARKSREPOSITORY_H
@@ -0,0 +1,68 @@
+#include "concordancerepository.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <repository/quranrepository.h>
+#include <utils/indexfile.h>
+
+ConcordanceRepository&
+ConcordanceRepository::getInstance()
+{
+  static ConcordanceRepository crdb;
+  return crdb;
+}
+
+ConcordanceRepository::ConcordanceRepository()
+  : m_assetsDir(DirManager::getInstance().assetsDir())
+  , m_downloadsDir(DirManager::getInstance().downloadsDir())
+{
+  // the preparation writes the concordance file, let it finish before the
+  // database drivers are torn down
+  QObject::connect(qApp, &QCoreApplication::aboutToQuit, [this]() {
+    QMutexLocker locker(&m_lock);
+    m_prepare.waitForFinished();
+  });
+}
+
+QFuture<bool>
+ConcordanceRepository::prepare()
+{
+  QMutexLocker locker(&m_lock);
+  if (!m_prepare.isValid())
+    m_prepare = QtConcurrent::run([this]() { return open(); });
+  return m_prepare;
+}
+
+const Concordance&
+ConcordanceRepository::concordance()
+{
+  prepare().waitForFinished();
+  return m_concordance;
+}
+
+bool
+ConcordanceRepository::open()
+{
+  const QByteArray stamp =
+    IndexFile::stamp({ m_assetsDir.absoluteFilePath("quran.db") });
+  if (stamp.isEmpty()) {
+    qWarning() << "Couldn't read quran db for the concordance";
+    return false;
+  }
+
+  const QString path = m_downloadsDir.absoluteFilePath("concordance.bin");
+  if (m_concordance.open(path, stamp))
+    return true;
+
+  QElapsedTimer timer;
+  timer.start();
+  if (Concordance::write(
+        QuranRepository::getInstance().emlaeyTexts(), path, stamp) &&
+      m_concordance.open(path, stamp)) {
+    qInfo() << "Concordance written in" << timer.elapsed() << "ms";
+    return true;
+  }
+
+  qWarning() << "Couldn't prepare the concordance" << path;
+  return false;
+}
@@ -0,0 +1,74 @@
+#ifndef CONCORDANCEREPOSITORY_H
+#define CONCORDANCEREPOSITORY_H
+
+#include <QDir>
+#include <QFuture>
+#include <QMutex>
+#include <search/concordance.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class ConcordanceRepository
+ * @brief Manages the concordance file of the verse texts.
+ *
+ * The file (`concordance.bin` in the downloads directory) is written once
+ * from the emlaey text of every verse and mapped on a worker thread started by
+ * the first use. It is stamped with a hash of `quran.db` and rewritten when
+ * the database changes, later lookups are answered from the mapping without
+ * querying the database. A concordance that couldn't be prepared isn't
+ * retried until the next launch.
+ */
+class ConcordanceRepository
+{
+public:
+  /**
+   * @brief Get a reference to the singleton instance.
+   * @return Reference to the static class instance.
+   */
+  static ConcordanceRepository& getInstance();
+  /**
+   * @brief Starts writing and mapping the concordance file in the background,
+   * once.
+   * @return QFuture holding true once the concordance is open.
+   */
+  QFuture<bool> prepare();
+  /**
+   * @brief Gets the concordance, preparing it and waiting for it if not ready
+   * yet.
+   * @return Reference to the Concordance, not open if the file couldn't be
+   * written.
+   */
+  const Concordance& concordance();
+
+private:
+  ConcordanceRepository();
+  /**
+   * @brief Maps the concordance file, writing it first if missing or
+   * outdated. Runs on a worker thread.
+   * @return True if the concordance is open.
+   */
+  bool open();
+  /**
+   * @brief Reference to the app assets directory.
+   */
+  const QDir& m_assetsDir;
+  /**
+   * @brief Reference to the user data (downloads) directory.
+   */
+  const QDir& m_downloadsDir;
+  /**
+   * @brief The mapped concordance.
+   */
+  Concordance m_concordance;
+  /**
+   * @brief Background preparation of the concordance, invalid until the
+   * first use.
+   */
+  QFuture<bool> m_prepare;
+  /**
+   * @brief Guards m_prepare.
+   */
+  QMutex m_lock;
+};
+
+#endif // CONCORDANCEREPOSITORY_H
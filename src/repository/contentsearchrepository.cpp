@@ -0,0 +1,208 @@
+#include "contentsearchrepository.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+#include <QtConcurrent>
+#include <utils/arabicnormalizer.h>
+#include <utils/indexfile.h>
+
+ContentSearchRepository::ContentSearchRepository(const QString& name,
+                                                 int formatVersion)
+  : m_name(name)
+  , m_formatVersion(formatVersion)
+{
+  // direct, the instance may be created on a worker thread without an event
+  // loop, builds write their index files and must stop before quitting
+  connect(
+    qApp,
+    &QCoreApplication::aboutToQuit,
+    this,
+    [this]() {
+      m_cancelled = true;
+      QList<QFuture<bool>> builds;
+      {
+        QMutexLocker locker(&m_buildsLock);
+        builds = m_builds.values();
+      }
+      for (QFuture<bool>& build : builds)
+        build.waitForFinished();
+    },
+    Qt::DirectConnection);
+}
+
+QFuture<bool>
+ContentSearchRepository::prepareIndex(const QString& id,
+                                      const QString& sourcePath,
+                                      const QString& indexPath,
+                                      bool recheck)
+{
+  QMutexLocker locker(&m_buildsLock);
+  // a failed build is retried, a successful one only when rechecking
+  QFuture<bool>& build = m_builds[id];
+  if (build.isValid() && !recheck && (!build.isFinished() || build.result()))
+    return build;
+
+  // a running build of the same index finishes first
+  build = QtConcurrent::run(
+    [this, id, sourcePath, indexPath, previous = build]() mutable {
+      previous.waitForFinished();
+      return buildIndex(id, sourcePath, indexPath);
+    });
+  return build;
+}
+
+QList<int>
+ContentSearchRepository::searchIndex(const QString& indexPath,
+                                     const QString& expression)
+{
+  QList<int> ids;
+  withIndex(indexPath, [&](QSqlDatabase& db) {
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (query.prepare("SELECT rowid FROM content_fts WHERE content_fts "
+                      "MATCH ? ORDER BY rowid")) {
+      query.bindValue(0, expression);
+      if (query.exec()) {
+        while (query.next())
+          ids.append(query.value(0).toInt());
+      }
+    }
+    if (query.lastError().isValid())
+      qWarning() << "Couldn't search" << indexPath << ':' << query.lastError();
+  });
+  return ids;
+}
+
+void
+ContentSearchRepository::withIndex(
+  const QString& indexPath,
+  const std::function<void(QSqlDatabase& db)>& run)
+{
+  const QString connection = connectionName("Query", indexPath);
+  {
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection);
+    db.setDatabaseName(indexPath);
+    db.setConnectOptions("QSQLITE_OPEN_READONLY");
+    if (db.open())
+      run(db);
+  }
+  QSqlDatabase::removeDatabase(connection);
+}
+
+bool
+ContentSearchRepository::isCancelled() const
+{
+  return m_cancelled;
+}
+
+bool
+ContentSearchRepository::buildIndex(const QString& id,
+                                    const QString& sourcePath,
+                                    const QString& indexPath)
+{
+  const QByteArray sourceStamp = IndexFile::stamp({ sourcePath });
+  if (sourceStamp.isEmpty())
+    return false;
+  const QString stamp = QString::number(m_formatVersion) + ':' + sourceStamp;
+
+  QString existing;
+  if (QFile::exists(indexPath)) {
+    withIndex(indexPath, [&existing](QSqlDatabase& db) {
+      QSqlQuery query(db);
+      if (query.exec("SELECT value FROM meta WHERE key='version'") &&
+          query.next())
+        existing = query.value(0).toString();
+    });
+  }
+
+  if (existing == stamp)
+    return true;
+
+  qInfo() << "Building" << m_name.toLower() << "search index" << indexPath;
+  return IndexFile::replace(indexPath, [&](const QString& partPath) {
+    return writeIndex(id, sourcePath, partPath, stamp);
+  });
+}
+
+bool
+ContentSearchRepository::writeIndex(const QString& id,
+                                    const QString& sourcePath,
+                                    const QString& indexPath,
+                                    const QString& stamp)
+{
+  const QString sourceCon = connectionName("Source", indexPath);
+  const QString buildCon = connectionName("Build", indexPath);
+  bool success = false;
+  {
+    QSqlDatabase sourceDb = QSqlDatabase::addDatabase("QSQLITE", sourceCon);
+    sourceDb.setDatabaseName(sourcePath);
+    sourceDb.setConnectOptions("QSQLITE_OPEN_READONLY");
+    QSqlDatabase indexDb = QSqlDatabase::addDatabase("QSQLITE", buildCon);
+    indexDb.setDatabaseName(indexPath);
+
+    if (sourceDb.open() && indexDb.open()) {
+      QSqlQuery index(indexDb);
+      // the partial file is discarded on failure, no journal is needed and
+      // the page cache is capped at 4 MiB. remove_diacritics folds accented
+      // latin letters, arabic script is normalized before insertion
+      success = index.exec("PRAGMA journal_mode=OFF") &&
+                index.exec("PRAGMA synchronous=OFF") &&
+                index.exec("PRAGMA cache_size=-4096") &&
+                index.exec("CREATE VIRTUAL TABLE content_fts USING "
+                           "fts5(text, tokenize='unicode61 "
+                           "remove_diacritics 2')") &&
+                index.exec(
+                  "CREATE TABLE meta(key TEXT PRIMARY KEY, value TEXT)") &&
+                indexDb.transaction();
+      if (!success)
+        qWarning() << "Couldn't create" << m_name.toLower()
+                   << "index:" << index.lastError();
+
+      success = success && writeContent(id, sourceDb, indexDb) &&
+                index.exec(
+                  "INSERT INTO content_fts(content_fts) VALUES('optimize')") &&
+                index.prepare("INSERT INTO meta VALUES('version', ?)");
+      if (success) {
+        index.bindValue(0, stamp);
+        success = index.exec() && indexDb.commit();
+      }
+      if (!success) {
+        if (!m_cancelled)
+          qWarning() << "Couldn't build" << m_name.toLower()
+                     << "index:" << index.lastError();
+        indexDb.rollback();
+      }
+    }
+  }
+  QSqlDatabase::removeDatabase(buildCon);
+  QSqlDatabase::removeDatabase(sourceCon);
+  return success;
+}
+
+QString
+ContentSearchRepository::matchExpression(const QString& text, bool whole)
+{
+  QStringList tokens = ArabicNormalizer::tokens(text);
+  for (QString& token : tokens)
+    token.remove('"');
+  tokens.removeAll(QString());
+  if (tokens.isEmpty())
+    return QString();
+
+  // a single quoted phrase, words inside it are matched in sequence
+  QString expression = '"' + tokens.join(' ') + '"';
+  if (!whole)
+    expression.append(" *");
+  return expression;
+}
+
+QString
+ContentSearchRepository::connectionName(const QString& purpose,
+                                        const QString& indexPath) const
+{
+  return m_name + "Index" + purpose + "Con-" + indexPath + '@' +
+         QString::number(reinterpret_cast<quintptr>(QThread::currentThread()),
+                         16);
+}
@@ -0,0 +1,136 @@
+#ifndef CONTENTSEARCHREPOSITORY_H
+#define CONTENTSEARCHREPOSITORY_H
+
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSqlDatabase>
+#include <atomic>
+#include <functional>
+
+/**
+ * @class ContentSearchRepository
+ * @brief Base of the repositories managing FTS5 full-text indices of
+ * downloadable content (translations, tafasir).
+ *
+ * Each content database gets its own index holding the normalized text of
+ * its `content` table in a `content_fts` table keyed by verse id, and a
+ * `meta` table with the version stamp of the content file it was built from.
+ * Indices are verified against their content file on a worker thread and
+ * written to a partial file that replaces the index once complete, so a
+ * cancelled or failed build never leaves a broken index behind. Builds are
+ * stopped and waited for when the application quits.
+ *
+ * Subclasses only write the index of their content, every query opens a
+ * short-lived connection of its own on the querying thread.
+ */
+class ContentSearchRepository : public QObject
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Builds an FTS5 MATCH expression for the given search text.
+   * @param text The searched word or phrase.
+   * @param whole If false, the last word is matched as a prefix.
+   * @return QString of the MATCH expression, empty if the text has no tokens.
+   */
+  static QString matchExpression(const QString& text, bool whole);
+
+protected:
+  /**
+   * @brief Class constructor.
+   * @param name Name of the content used in connection names and logs.
+   * @param formatVersion Version of the index schema and text processing,
+   * indices of another version are rebuilt.
+   */
+  ContentSearchRepository(const QString& name, int formatVersion);
+  /**
+   * @brief Starts verifying or building an index in the background, if not
+   * already started.
+   * @param id Id of the indexed content.
+   * @param sourcePath Path to the content database.
+   * @param indexPath Path to the index database.
+   * @param recheck If true, the index is verified again even if it was up to
+   * date, used after the content file is downloaded again.
+   * @return QFuture holding true once the index is up to date.
+   */
+  QFuture<bool> prepareIndex(const QString& id,
+                             const QString& sourcePath,
+                             const QString& indexPath,
+                             bool recheck);
+  /**
+   * @brief Inserts the content rows into a new index database. Runs on a
+   * worker thread and stops once isCancelled() is set.
+   * @param id Id of the indexed content.
+   * @param sourceDb Open read-only connection to the content database.
+   * @param indexDb Open connection to the new index database, its tables are
+   * created and a transaction is started, the stamp is stored and the
+   * transaction committed after the content is written.
+   * @return True if the content was written completely.
+   */
+  virtual bool writeContent(const QString& id,
+                            QSqlDatabase& sourceDb,
+                            QSqlDatabase& indexDb) = 0;
+  /**
+   * @brief Gets the ids of the verses whose content matches an expression.
+   * @param indexPath Path to the index database.
+   * @param expression The FTS5 MATCH expression.
+   * @return Ascending QList of matching verse ids.
+   */
+  QList<int> searchIndex(const QString& indexPath, const QString& expression);
+  /**
+   * @brief Runs queries on an index through a connection of the calling
+   * thread, opened for the call only.
+   * @param indexPath Path to the index database.
+   * @param run Function running the queries on the open connection.
+   */
+  void withIndex(const QString& indexPath,
+                 const std::function<void(QSqlDatabase& db)>& run);
+  /**
+   * @brief Check whether the application is quitting.
+   */
+  bool isCancelled() const;
+
+private:
+  /**
+   * @brief Verifies the index file against the content file and rebuilds it
+   * if needed. Runs on a worker thread using its own connections.
+   * @return True if the index file is up to date.
+   */
+  bool buildIndex(const QString& id,
+                  const QString& sourcePath,
+                  const QString& indexPath);
+  /**
+   * @brief Writes a new index database.
+   * @return True if the index was written completely.
+   */
+  bool writeIndex(const QString& id,
+                  const QString& sourcePath,
+                  const QString& indexPath,
+                  const QString& stamp);
+  /**
+   * @brief Get a connection name unique to the purpose, index and calling
+   * thread, builds and searches of different indices run concurrently.
+   */
+  QString connectionName(const QString& purpose,
+                         const QString& indexPath) const;
+  const QString m_name;
+  const int m_formatVersion;
+  /**
+   * @brief Background index builds by content id.
+   */
+  QHash<QString, QFuture<bool>> m_builds;
+  /**
+   * @brief Guards m_builds, searches run on worker threads.
+   */
+  QMutex m_buildsLock;
+  /**
+   * @brief Set when the application quits to stop ongoing builds, which are
+   * then waited for.
+   */
+  std::atomic_bool m_cancelled = false;
+};
+
+#endif // CONTENTSEARCHREPOSITORY_H
@@ -24,12 +24,13 @@ public:
    */
   enum Type
   {
-    Quran,      ///< Represents the main Quran database file (quran.db)
-    Glyphs,     ///< Represents the QCF glyphs database file (glyphs.db)
-    Betaqat,    ///< Represents the Betaqat database file
-    Bookmarks,  ///< Represents the bookmarks database file (bookmarks.db)
-    Tafsir,     ///< Represents the currently selected tafsir database file
-    Translation ///< Represents the currently selected translation database file
+    Quran,       ///< Represents the main Quran database file (quran.db)
+    Glyphs,      ///< Represents the QCF glyphs database file (glyphs.db)
+    Betaqat,     ///< Represents the Betaqat database file
+    Bookmarks,   ///< Represents the bookmarks database file (bookmarks.db)
+    Tafsir,      ///< Represents the currently selected tafsir database file
+    Translation, ///< Represents the currently selected translation db file
+    SearchIndex  ///< Represents the verse full-text search index (search.db)
   };
   /**
    * @brief Sets and opens the database connection.
@@ -1,5 +1,6 @@
 #include "glyphsrepository.h"
-#include <QSqlQuery>
+#include <algorithm>
+#include <generated/quranmetadata.h>
 
 GlyphsRepository&
 GlyphsRepository::getInstance()
@@ -12,6 +13,7 @@ GlyphsRepository::GlyphsRepository()
   : QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "GlyphsCon"))
   , m_config(Configuration::getInstance())
   , m_assetsDir(DirManager::getInstance().assetsDir())
+  , m_statements("GlyphsCon")
 {
     GlyphsRepository::open();
 }
@@ -19,9 +21,30 @@ GlyphsRepository::GlyphsRepository()
 void
 GlyphsRepository::open()
 {
+  m_statements.clear();
   setDatabaseName(m_assetsDir.absoluteFilePath("glyphs.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening glyphs db");
+
+  const QString column = "qcf_v" + QString::number(m_config.qcfVersion());
+  m_statements.prepare("pageLines",
+                       "SELECT " + column + " FROM pages WHERE page_no=?");
+  m_statements.prepare("surahNameGlyph",
+                       "SELECT qcf_v1 FROM surah_glyphs WHERE surah=?");
+  m_statements.prepare("juzGlyph", "SELECT text FROM juz_glyphs WHERE juz=?");
+  m_statements.prepare(
+    "verseGlyphs",
+    "SELECT " + column + " FROM ayah_glyphs WHERE surah=? AND ayah=?");
+  // ayah_glyphs ids follow the verse ids
+  m_statements.prepare("verseGlyphRange",
+                       "SELECT " + column +
+                         " FROM ayah_glyphs WHERE id BETWEEN ? AND ? "
+                         "ORDER BY id");
+  // the id list is bound as ",1,2,3," and matched against ",id,"
+  m_statements.prepare("verseGlyphsById",
+                       "SELECT id," + column +
+                         " FROM ayah_glyphs WHERE id BETWEEN ? AND ? "
+                         "AND instr(?, ',' || id || ',') > 0");
 }
 
 DbConnection::Type
@@ -33,69 +56,61 @@ GlyphsRepository::type()
 QStringList
 GlyphsRepository::getPageLines(const int page) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString query = "SELECT %0 FROM pages WHERE page_no=%1";
-  query = query.arg("qcf_v" + QString::number(m_config.qcfVersion()),
-                    QString::number(page));
-
-  dbQuery.prepare(query);
-  if (!dbQuery.exec())
-    qFatal("Couldn't execute getPageLines query!");
-
-  dbQuery.next();
-  QStringList lines = dbQuery.value(0).toString().trimmed().split('\n');
-
-  return lines;
+  return m_statements.scalar<QString>("pageLines", { page })
+    .trimmed()
+    .split('\n');
 }
 
 QString
 GlyphsRepository::getSurahNameGlyph(const int sura) const
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare("SELECT qcf_v1 FROM surah_glyphs WHERE surah=:i");
-  dbQuery.bindValue(0, sura);
-  if (!dbQuery.exec()) {
-    qCritical() << "Error occurred during getSurahNameGlyph SQL statment exec";
-  }
-
-  dbQuery.next();
-
-  return dbQuery.value(0).toString();
+  return m_statements.scalar<QString>("surahNameGlyph", { sura });
 }
 
 QString
 GlyphsRepository::getJuzGlyph(const int juz) const
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare("SELECT text FROM juz_glyphs WHERE juz=:j");
-  dbQuery.bindValue(0, juz);
-  if (!dbQuery.exec()) {
-    qCritical() << "Error occurred during getJuzGlyph SQL statment exec";
-  }
-
-  dbQuery.next();
-
-  return dbQuery.value(0).toString();
+  return m_statements.scalar<QString>("juzGlyph", { juz });
 }
 
 QString
 GlyphsRepository::getVerseGlyphs(const int sIdx, const int vIdx) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString query = "SELECT %0 FROM ayah_glyphs WHERE surah=%1 AND ayah=%2";
-  query = query.arg("qcf_v" + QString::number(m_config.qcfVersion()),
-                    QString::number(sIdx),
-                    QString::number(vIdx));
-
-  dbQuery.prepare(query);
-  if (!dbQuery.exec())
-    qFatal("Couldn't execute getVerseGlyphs query!");
+  return m_statements.scalar<QString>("verseGlyphs", { sIdx, vIdx });
+}
 
-  dbQuery.next();
+QStringList
+GlyphsRepository::verseGlyphsById(const QList<int>& ids) const
+{
+  if (ids.isEmpty())
+    return {};
+
+  const auto [first, last] = std::minmax_element(ids.cbegin(), ids.cend());
+  QString idList = ",";
+  for (int id : ids)
+    idList.append(QString::number(id) + ',');
+
+  QHash<int, QString> glyphs;
+  QSqlQuery& query =
+    m_statements.exec("verseGlyphsById", { *first, *last, idList });
+  while (query.next())
+    glyphs.insert(query.value(0).toInt(), query.value(1).toString());
+
+  QStringList ordered;
+  ordered.reserve(ids.size());
+  for (int id : ids)
+    ordered.append(glyphs.value(id));
+  return ordered;
+}
 
-  return dbQuery.value(0).toString();
+QStringList
+GlyphsRepository::pageVerseGlyphs(const int page) const
+{
+  if (page < 1 || page > QuranMetadata::pageTotal)
+    return {};
+  const int v = m_config.qcfVersion() - 1;
+  return m_statements.column<QString>(
+    "verseGlyphRange",
+    { QuranMetadata::pageFirstVerse[v][page],
+      QuranMetadata::pageFirstVerse[v][page + 1] - 1 });
 }
@@ -5,6 +5,7 @@
 #include <QSharedPointer>
 #include <QSqlDatabase>
 #include <repository/dbconnection.h>
+#include <repository/statementregistry.h>
 #include <utils/configuration.h>
 #include <utils/dirmanager.h>
 
@@ -63,6 +64,18 @@ public:
    * @return QString containing the glyphs for the specified verse.
    */
   QString getVerseGlyphs(const int sIdx, const int vIdx) const;
+  /**
+   * @brief Retrieves the glyphs of any set of verses in a single query.
+   * @param ids QList of verse ids.
+   * @return QStringList of the glyphs of the verses in the order of the ids.
+   */
+  QStringList verseGlyphsById(const QList<int>& ids) const;
+  /**
+   * @brief Retrieves the glyphs of all verses of a page in a single query.
+   * @param page The page number in the active QCF version.
+   * @return QStringList of the glyphs of the page verses in order.
+   */
+  QStringList pageVerseGlyphs(const int page) const;
 
 private:
   /**
@@ -80,6 +93,10 @@ private:
    * @brief Reference to the application assets directory.
    */
   const QDir& m_assetsDir;
+  /**
+   * @brief Statements prepared once when the connection is opened.
+   */
+  mutable StatementRegistry m_statements;
 };
 
 #endif // GLYPHSREPOSITORY_H
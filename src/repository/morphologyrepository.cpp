@@ -0,0 +1,106 @@
+#include "morphologyrepository.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <repository/quranrepository.h>
+#include <utils/arabicnormalizer.h>
+#include <utils/indexfile.h>
+
+MorphologyRepository&
+MorphologyRepository::getInstance()
+{
+  static MorphologyRepository mrdb;
+  return mrdb;
+}
+
+MorphologyRepository::MorphologyRepository()
+  : m_assetsDir(DirManager::getInstance().assetsDir())
+  , m_downloadsDir(DirManager::getInstance().downloadsDir())
+{
+}
+
+QString
+MorphologyRepository::datasetPath() const
+{
+  for (const QDir* dir : { &m_downloadsDir, &m_assetsDir }) {
+    if (dir->exists("morphology.tsv"))
+      return dir->absoluteFilePath("morphology.tsv");
+  }
+  return QString();
+}
+
+bool
+MorphologyRepository::isAvailable() const
+{
+  return !datasetPath().isEmpty();
+}
+
+const Morphology&
+MorphologyRepository::morphology()
+{
+  QMutexLocker locker(&m_lock);
+  if (m_prepared)
+    return m_morphology;
+
+  // a dataset installed later is picked up by the next use
+  const QString dataset = datasetPath();
+  if (dataset.isEmpty())
+    return m_morphology;
+
+  // every attempt reads the whole dataset, a failed one isn't repeated
+  m_prepared = true;
+  const QByteArray stamp = IndexFile::stamp(
+    { dataset, m_assetsDir.absoluteFilePath("quran.db") });
+  if (stamp.isEmpty()) {
+    qWarning() << "Couldn't read the morphology dataset" << dataset;
+    return m_morphology;
+  }
+
+  const QString path = m_downloadsDir.absoluteFilePath("morphology.bin");
+  if (m_morphology.open(path, stamp))
+    return m_morphology;
+
+  QElapsedTimer timer;
+  timer.start();
+  if (Morphology::write(dataset,
+                        QuranRepository::getInstance().emlaeyTexts(),
+                        path,
+                        stamp) &&
+      m_morphology.open(path, stamp)) {
+    qInfo() << "Morphology compiled in" << timer.elapsed() << "ms";
+  } else {
+    qWarning() << "Couldn't prepare the morphology" << path;
+  }
+  return m_morphology;
+}
+
+QList<int>
+MorphologyRepository::search(const QString& text, Morphology::Kind kind)
+{
+  const Morphology& morphology = this->morphology();
+  const QStringList tokens = ArabicNormalizer::tokens(text);
+  if (!morphology.isOpen() || tokens.isEmpty())
+    return {};
+
+  QList<int> ids = morphology.verses(tokens.first(), kind);
+  for (int i = 1; i < tokens.size() && !ids.isEmpty(); i++) {
+    const QList<int> verses = morphology.verses(tokens.at(i), kind);
+    QList<int> common;
+    std::set_intersection(ids.cbegin(),
+                          ids.cend(),
+                          verses.cbegin(),
+                          verses.cend(),
+                          std::back_inserter(common));
+    ids = common;
+  }
+  return ids;
+}
+
+QStringList
+MorphologyRepository::forms(const QString& word, Morphology::Kind kind)
+{
+  const Morphology& morphology = this->morphology();
+  const QStringList tokens = ArabicNormalizer::tokens(word);
+  if (!morphology.isOpen() || tokens.isEmpty())
+    return {};
+  return morphology.forms(tokens.first(), kind);
+}
@@ -0,0 +1,87 @@
+#ifndef MORPHOLOGYREPOSITORY_H
+#define MORPHOLOGYREPOSITORY_H
+
+#include <QDir>
+#include <QMutex>
+#include <search/morphology.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class MorphologyRepository
+ * @brief Manages the optional morphology dataset of the mushaf words.
+ *
+ * The dataset (`morphology.tsv`) is looked up in the downloads directory,
+ * then in the app assets directory. Nothing is read until a morphological
+ * search is made: the dataset is then compiled once into `morphology.bin` in
+ * the downloads directory, stamped with a hash of the dataset and `quran.db`
+ * and mapped for later lookups.
+ */
+class MorphologyRepository
+{
+public:
+  /**
+   * @brief Get a reference to the singleton instance.
+   * @return Reference to the static class instance.
+   */
+  static MorphologyRepository& getInstance();
+  /**
+   * @brief Check whether a morphology dataset is installed, without reading
+   * it.
+   */
+  bool isAvailable() const;
+  /**
+   * @brief Gets the morphology, compiling and mapping the dataset on first
+   * use.
+   * @return Reference to the Morphology, not open if no dataset is installed
+   * or it couldn't be compiled.
+   */
+  const Morphology& morphology();
+  /**
+   * @brief Finds the verses containing a word of the same key as every word
+   * of a text, preparing the morphology first if needed.
+   * @param text Words or keys to search for, words missing from the dataset
+   * match no verse.
+   * @param kind The kind of key words are matched by.
+   * @return Ascending QList of verse ids.
+   */
+  QList<int> search(const QString& text, Morphology::Kind kind);
+  /**
+   * @brief Gets the words sharing the key of a word, preparing the
+   * morphology first if needed.
+   * @param word The word, root or lemma.
+   * @param kind The kind of key.
+   * @return QStringList of the normalized words, empty if the word is missing
+   * from the dataset.
+   */
+  QStringList forms(const QString& word, Morphology::Kind kind);
+
+private:
+  MorphologyRepository();
+  /**
+   * @brief Gets the path of the installed dataset, empty if there is none.
+   */
+  QString datasetPath() const;
+  /**
+   * @brief Reference to the app assets directory.
+   */
+  const QDir& m_assetsDir;
+  /**
+   * @brief Reference to the user data (downloads) directory.
+   */
+  const QDir& m_downloadsDir;
+  /**
+   * @brief The mapped morphology.
+   */
+  Morphology m_morphology;
+  /**
+   * @brief Whether an installed dataset was prepared, a dataset that couldn't
+   * be read or compiled isn't retried until the next launch.
+   */
+  bool m_prepared = false;
+  /**
+   * @brief Guards the first use of the morphology.
+   */
+  QMutex m_lock;
+};
+
+#endif // MORPHOLOGYREPOSITORY_H
@@ -0,0 +1,56 @@
+#include "querycacherepository.h"
+#include <QFile>
+#include <utils/indexfile.h>
+
+QueryCacheRepository&
+QueryCacheRepository::getInstance()
+{
+  static QueryCacheRepository qcrdb;
+  return qcrdb;
+}
+
+QueryCacheRepository::QueryCacheRepository()
+  : m_assetsDir(DirManager::getInstance().assetsDir())
+  , m_configDir(DirManager::getInstance().configDir())
+{
+}
+
+QueryCache&
+QueryCacheRepository::cache()
+{
+  QMutexLocker locker(&m_lock);
+  if (m_prepared)
+    return m_cache;
+  m_prepared = true;
+
+  m_stamp = IndexFile::stamp({ m_assetsDir.absoluteFilePath("quran.db") });
+
+  QFile file(m_configDir.absoluteFilePath("search.cache"));
+  if (!m_stamp.isEmpty() && file.open(QIODevice::ReadOnly) &&
+      !m_cache.load(file, m_stamp))
+    qInfo() << "Discarded outdated search cache";
+  return m_cache;
+}
+
+void
+QueryCacheRepository::save()
+{
+  QMutexLocker locker(&m_lock);
+  if (!m_prepared)
+    return;
+
+  const QueryCache::Statistics stats = m_cache.statistics();
+  qInfo().nospace() << "Search cache: " << stats.hits << " hits, "
+                    << stats.misses << " misses ("
+                    << qRound(stats.hitRate() * 100) << "% hit rate), "
+                    << stats.entries << " entries";
+  // a cache without the stamp of quran.db couldn't be verified when loaded
+  if (!m_cache.isModified() || m_stamp.isEmpty())
+    return;
+
+  const QString path = m_configDir.absoluteFilePath("search.cache");
+  if (!IndexFile::write(path, [this](QIODevice& part) {
+        return m_cache.save(part, m_stamp);
+      }))
+    qWarning() << "Couldn't write search cache" << path;
+}
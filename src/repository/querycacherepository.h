@@ -0,0 +1,60 @@
+#ifndef QUERYCACHEREPOSITORY_H
+#define QUERYCACHEREPOSITORY_H
+
+#include <QDir>
+#include <QMutex>
+#include <search/querycache.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class QueryCacheRepository
+ * @brief Keeps the search result cache across sessions.
+ *
+ * The QueryCache is loaded from `search.cache` in the config directory on
+ * first use and saved back on exit. The file is stamped with a hash of
+ * `quran.db`, cached results of a different database are discarded.
+ */
+class QueryCacheRepository
+{
+public:
+  /**
+   * @brief Get a reference to the singleton instance.
+   * @return Reference to the static class instance.
+   */
+  static QueryCacheRepository& getInstance();
+  /**
+   * @brief Gets the cache, loading the saved results on first use.
+   * @return Reference to the QueryCache.
+   */
+  QueryCache& cache();
+  /**
+   * @brief Saves the cache if it was used and changed, and logs its hit rate.
+   */
+  void save();
+
+private:
+  QueryCacheRepository();
+  /**
+   * @brief Reference to the app assets directory.
+   */
+  const QDir& m_assetsDir;
+  /**
+   * @brief Reference to the app config directory.
+   */
+  const QDir& m_configDir;
+  QueryCache m_cache;
+  /**
+   * @brief Content stamp of the cache, empty if quran.db couldn't be read.
+   */
+  QByteArray m_stamp;
+  /**
+   * @brief Whether the cache file was loaded, on the first use of the cache.
+   */
+  bool m_prepared = false;
+  /**
+   * @brief Guards the first use of the cache.
+   */
+  QMutex m_lock;
+};
+
+#endif // QUERYCACHEREPOSITORY_H
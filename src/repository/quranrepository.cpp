@@ -1,6 +1,6 @@
 #include "quranrepository.h"
-#include <QRandomGenerator>
-#include <QSqlError>
+#include <algorithm>
+#include <generated/quranmetadata.h>
 
 QuranRepository&
 QuranRepository::getInstance()
@@ -13,27 +13,120 @@ QuranRepository::QuranRepository()
   : QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "QuranCon"))
   , m_assetsDir(DirManager::getInstance().assetsDir())
   , m_config(Configuration::getInstance())
+  , m_statements("QuranCon")
+  , m_searchIndex(SearchIndexRepository::getInstance())
 {
   QuranRepository::open();
   for (int i = 1; i <= 114; i++)
     m_surahNames.append(surahName(i));
 }
 
-bool
-QuranRepository::executeQuery(QSqlQuery& query, QString errMsg) const
-{
-  bool success = query.exec();
-  if (!success)
-    qCritical() << errMsg;
-  return success;
-}
-
 void
 QuranRepository::open()
 {
+  m_statements.clear();
   setDatabaseName(m_assetsDir.absoluteFilePath("quran.db"));
   if (!QSqlDatabase::open())
     qFatal("Error opening quran db");
+  prepareStatements();
+}
+
+void
+QuranRepository::prepareStatements()
+{
+  // the QCF version is fixed for the session, so is the verses table
+  const QString table = "verses_v" + QString::number(m_config.qcfVersion());
+  const QString verseColumns = "SELECT page,sura_no,aya_no FROM " + table;
+
+  m_statements.prepare(
+    "pageMetadata",
+    "SELECT sura_no,jozz FROM verses_v1 WHERE page=? ORDER BY id LIMIT 1");
+  m_statements.prepare(
+    "versePage", "SELECT page FROM " + table + " WHERE sura_no=? AND aya_no=?");
+  m_statements.prepare(
+    "verseJuz",
+    "SELECT jozz FROM verses_v1 WHERE page=? AND sura_no=? AND aya_no=?");
+  m_statements.prepare(
+    "verseInfoList",
+    "SELECT sura_no,aya_no FROM " + table + " WHERE page=? ORDER BY id");
+  m_statements.prepare("firstInPage",
+                       "SELECT sura_no,aya_no FROM " + table +
+                         " WHERE page=? ORDER BY id LIMIT 1");
+  m_statements.prepare(
+    "verseText", "SELECT aya_text FROM verses_v1 WHERE sura_no=? AND aya_no=?");
+  m_statements.prepare("verseTextAnnotated",
+                       "SELECT aya_text_annotated FROM verses_v1 "
+                       "WHERE sura_no=? AND aya_no=?");
+  m_statements.prepare(
+    "verseTextWarsh",
+    "SELECT aya_text_warsh FROM verses_v1 WHERE sura_no=? AND aya_no=?");
+  m_statements.prepare(
+    "verseTextRange",
+    "SELECT aya_text FROM verses_v1 WHERE id BETWEEN ? AND ? ORDER BY id");
+  m_statements.prepare("verseTextRangeAnnotated",
+                       "SELECT aya_text_annotated FROM verses_v1 WHERE id "
+                       "BETWEEN ? AND ? ORDER BY id");
+  m_statements.prepare("verseTextRangeWarsh",
+                       "SELECT aya_text_warsh FROM verses_v1 WHERE id BETWEEN "
+                       "? AND ? ORDER BY id");
+  // the id list is bound as ",1,2,3," and matched against ",id,", the id
+  // range lets the primary key narrow down the rows first
+  m_statements.prepare("verseTextsById",
+                       "SELECT id,aya_text FROM verses_v1 WHERE id BETWEEN ? "
+                       "AND ? AND instr(?, ',' || id || ',') > 0");
+  m_statements.prepare("verseTextsByIdAnnotated",
+                       "SELECT id,aya_text_annotated FROM verses_v1 WHERE id "
+                       "BETWEEN ? AND ? AND instr(?, ',' || id || ',') > 0");
+  m_statements.prepare("verseTextsByIdWarsh",
+                       "SELECT id,aya_text_warsh FROM verses_v1 WHERE id "
+                       "BETWEEN ? AND ? AND instr(?, ',' || id || ',') > 0");
+  m_statements.prepare("verseById", verseColumns + " WHERE id=?");
+  m_statements.prepare("verseInfoRange",
+                       verseColumns + " WHERE id BETWEEN ? AND ? ORDER BY id");
+  m_statements.prepare("searchSurahNames",
+                       "SELECT DISTINCT sura_no FROM verses_v1 WHERE "
+                       "sura_name_ar LIKE ? OR sura_name_en LIKE ?");
+  // the surah list is bound as ",1,2,3," and matched against ",sura_no,"
+  m_statements.prepare("searchSurahs",
+                       verseColumns +
+                         " WHERE instr(?, ',' || sura_no || ',') > 0 "
+                         "AND aya_text_emlaey LIKE ? ORDER BY id");
+  m_statements.prepare("searchSurahsWhole",
+                       verseColumns +
+                         " WHERE instr(?, ',' || sura_no || ',') > 0 "
+                         "AND (aya_text_emlaey LIKE ? OR aya_text_emlaey "
+                         "LIKE ?) ORDER BY id");
+  m_statements.prepare("searchVerses",
+                       verseColumns + " WHERE page BETWEEN ? AND ? "
+                                      "AND aya_text_emlaey LIKE ? ORDER BY id");
+  m_statements.prepare("searchVersesWhole",
+                       verseColumns +
+                         " WHERE page BETWEEN ? AND ? AND (aya_text_emlaey "
+                         "LIKE ? OR aya_text_emlaey LIKE ?) ORDER BY id");
+  m_statements.prepare("randomVerse",
+                       verseColumns + " WHERE id=(ABS(RANDOM()) % 6236) + 1");
+  m_statements.prepare("emlaeyTexts",
+                       "SELECT aya_text_emlaey FROM verses_v1 ORDER BY id");
+  m_statements.prepare("verseTexts",
+                       "SELECT aya_text FROM verses_v1 ORDER BY id");
+  m_statements.prepare("verseTextsAnnotated",
+                       "SELECT aya_text_annotated FROM verses_v1 ORDER BY id");
+  m_statements.prepare("verseTextsWarsh",
+                       "SELECT aya_text_warsh FROM verses_v1 ORDER BY id");
+}
+
+/**
+ * @brief read the (page, sura_no, aya_no) rows of an executed query
+ */
+static QList<Verse>
+readVerses(QSqlQuery& query)
+{
+  QList<Verse> verses;
+  while (query.next()) {
+    verses.append(Verse(
+      query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt()));
+  }
+  return verses;
 }
 
 DbConnection::Type
@@ -45,32 +138,24 @@ QuranRepository::type()
 QPair<int, int>
 QuranRepository::pageMetadata(const int page) const
 {
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare(
-    "SELECT sura_no,jozz FROM verses_v1 WHERE page=:p ORDER BY id");
-  dbQuery.bindValue(0, page);
-
-  executeQuery(dbQuery,
-               "Error occurred during getPageMetadata SQL statment exec");
-
-  dbQuery.next();
+  QSqlQuery& query = m_statements.exec("pageMetadata", { page });
+  query.next();
   // { surahIdx, jozz }
-  return { dbQuery.value(0).toInt(), dbQuery.value(1).toInt() };
+  return { query.value(0).toInt(), query.value(1).toInt() };
 }
 
 std::optional<QPair<int, int>>
 QuranRepository::getRubStartingInPage(const int page) const
 {
   std::optional<QPair<int, int>> result = std::nullopt;
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare(
-    "SELECT rub % 4, hizb FROM verses_v1 GROUP BY rub HAVING MIN(page) = ?");
-  dbQuery.addBindValue(page);
+  if (page < 1 || page > QuranMetadata::pageTotal)
+    return result;
 
-  executeQuery(dbQuery, "Error during fetching rub starting at page");
-  if (dbQuery.next())
-    result.emplace(
-      std::make_pair(dbQuery.value(0).toInt(), dbQuery.value(1).toInt()));
+  // rub boundaries are resolved against QCF v1 pages
+  int rub = QuranMetadata::pageRubStart[0][page];
+  if (rub)
+    result.emplace(std::make_pair(
+      rub % 4, QuranMetadata::hizbOf(QuranMetadata::rubFirstVerse[rub])));
 
   return result;
 }
@@ -78,75 +163,33 @@ QuranRepository::getRubStartingInPage(const int page) const
 int
 QuranRepository::getVersePage(const int& surahIdx, const int& verse) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString query = "SELECT page FROM verses_v%0 WHERE sura_no=%1 AND aya_no=%2";
-  dbQuery.prepare(query.arg(QString::number(m_config.qcfVersion()),
-                            QString::number(surahIdx),
-                            QString::number(verse)));
-
-  executeQuery(dbQuery, "Error occurred during getVersePage SQL statment exec");
-  dbQuery.next();
-
-  return dbQuery.value(0).toInt();
+  return m_statements.scalar<int>("versePage", { surahIdx, verse });
 }
 
 Verse
 QuranRepository::getJuzStart(const int juz) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString query = QString::asprintf(
-    "SELECT page,sura_no,aya_no FROM verses_v%i WHERE jozz=%i",
-    m_config.qcfVersion(),
-    juz);
-  dbQuery.prepare(query);
-
-  executeQuery(dbQuery,
-               "Error occurred during getJuzStartPage SQL statment exec");
-  dbQuery.next();
-
-  return Verse(dbQuery.value(0).toInt(),
-               dbQuery.value(1).toInt(),
-               dbQuery.value(2).toInt());
+  int id = QuranMetadata::juzFirstVerse[juz];
+  int surah = QuranMetadata::surahOf(id);
+  return Verse(QuranMetadata::versePage[m_config.qcfVersion() - 1][id - 1],
+               surah,
+               id - QuranMetadata::surahOffset[surah - 1]);
 }
 
 int
 QuranRepository::getVerseJuz(const Verse verse) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString query =
-    "SELECT jozz FROM verses_v1 WHERE page=? AND sura_no=? AND aya_no=?";
-  dbQuery.prepare(query);
-  dbQuery.addBindValue(verse.page());
-  dbQuery.addBindValue(verse.surah());
-  dbQuery.addBindValue(verse.number());
-
-  executeQuery(dbQuery, "Error occurred during getJuzOfPage SQL statment exec");
-  dbQuery.next();
-
-  return dbQuery.value(0).toInt();
+  return m_statements.scalar<int>(
+    "verseJuz", { verse.page(), verse.surah(), verse.number() });
 }
 
 QList<Verse>
 QuranRepository::verseInfoList(const int page) const
 {
   QList<Verse> viList;
-  QSqlQuery dbQuery(*this);
-
-  QString query =
-    "SELECT sura_no,aya_no FROM verses_v%0 WHERE page=%1 ORDER BY id";
-  dbQuery.prepare(
-    query.arg(QString::number(m_config.qcfVersion()), QString::number(page)));
-
-  executeQuery(dbQuery,
-               "Error occurred during getVerseInfoList SQL statment exec");
-
-  while (dbQuery.next()) {
-    viList.append(
-      Verse(page, dbQuery.value(0).toInt(), dbQuery.value(1).toInt()));
-  }
+  QSqlQuery& query = m_statements.exec("verseInfoList", { page });
+  while (query.next())
+    viList.append(Verse(page, query.value(0).toInt(), query.value(1).toInt()));
 
   return viList;
 }
@@ -154,136 +197,156 @@ QuranRepository::verseInfoList(const int page) const
 Verse
 QuranRepository::firstInPage(int page) const
 {
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare("SELECT sura_no,aya_no FROM verses_v" +
-                  QString::number(m_config.qcfVersion()) +
-                  " WHERE page = ? ORDER BY id LIMIT 1");
-  dbQuery.addBindValue(page);
-
-  executeQuery(dbQuery, "Error during finding first verse in page");
-
-  dbQuery.next();
+  QSqlQuery& query = m_statements.exec("firstInPage", { page });
+  query.next();
 
-  return Verse(page, dbQuery.value(0).toInt(), dbQuery.value(1).toInt());
+  return Verse(page, query.value(0).toInt(), query.value(1).toInt());
 }
 
 QString
 QuranRepository::verseText(const int sIdx, const int vIdx) const
 {
-  QSqlQuery dbQuery(*this);
-  QString columnName;
+  QString statement;
   switch (m_config.verseType()) {
     case ConfigurationSchema::HafsAnnotated:
-      columnName = "aya_text_annotated";
+      statement = "verseTextAnnotated";
       break;
     case ConfigurationSchema::Warsh:
-      columnName = "aya_text_warsh";
+      statement = "verseTextWarsh";
       break;
     default:
-      columnName = "aya_text";
+      statement = "verseText";
       break;
   }
 
-  dbQuery.prepare("SELECT " + columnName +
-                  " FROM verses_v1 WHERE sura_no=:s "
-                  "AND aya_no=:v");
-  dbQuery.bindValue(0, sIdx);
-  dbQuery.bindValue(1, vIdx);
+  return m_statements.scalar<QString>(statement, { sIdx, vIdx });
+}
+
+QStringList
+QuranRepository::verseTexts(const int surah, const int from, const int to) const
+{
+  return verseTextRange(QuranMetadata::verseId(surah, from),
+                        QuranMetadata::verseId(surah, to));
+}
 
-  executeQuery(dbQuery, "Error occurred during getVerseText SQL statment exec");
-  dbQuery.next();
+QStringList
+QuranRepository::verseTextRange(const int fromId, const int toId) const
+{
+  QString statement;
+  switch (m_config.verseType()) {
+    case ConfigurationSchema::HafsAnnotated:
+      statement = "verseTextRangeAnnotated";
+      break;
+    case ConfigurationSchema::Warsh:
+      statement = "verseTextRangeWarsh";
+      break;
+    default:
+      statement = "verseTextRange";
+      break;
+  }
 
-  return dbQuery.value(0).toString();
+  return m_statements.column<QString>(statement, { fromId, toId });
 }
 
-int
-QuranRepository::surahStartPage(int surahIdx) const
+QStringList
+QuranRepository::verseTextsById(const QList<int>& ids) const
 {
-  QSqlQuery dbQuery(*this);
+  if (ids.isEmpty())
+    return {};
+
+  QString statement;
+  switch (m_config.verseType()) {
+    case ConfigurationSchema::HafsAnnotated:
+      statement = "verseTextsByIdAnnotated";
+      break;
+    case ConfigurationSchema::Warsh:
+      statement = "verseTextsByIdWarsh";
+      break;
+    default:
+      statement = "verseTextsById";
+      break;
+  }
 
-  dbQuery.prepare("SELECT page FROM verses_v" +
-                  QString::number(m_config.qcfVersion()) +
-                  " WHERE sura_no=? AND aya_no=1");
-  dbQuery.addBindValue(surahIdx);
+  const auto [first, last] = std::minmax_element(ids.cbegin(), ids.cend());
+  QString idList = ",";
+  for (int id : ids)
+    idList.append(QString::number(id) + ',');
+
+  QHash<int, QString> texts;
+  QSqlQuery& query = m_statements.exec(statement, { *first, *last, idList });
+  while (query.next())
+    texts.insert(query.value(0).toInt(), query.value(1).toString());
+
+  QStringList ordered;
+  ordered.reserve(ids.size());
+  for (int id : ids)
+    ordered.append(texts.value(id));
+  return ordered;
+}
 
-  executeQuery(dbQuery,
-               "Error occurred during getSurahStartPage SQL statment exec");
-  dbQuery.next();
+QStringList
+QuranRepository::pageVerseTexts(const int page) const
+{
+  if (page < 1 || page > QuranMetadata::pageTotal)
+    return {};
+  const int v = m_config.qcfVersion() - 1;
+  return verseTextRange(QuranMetadata::pageFirstVerse[v][page],
+                        QuranMetadata::pageFirstVerse[v][page + 1] - 1);
+}
 
-  return dbQuery.value(0).toInt();
+QList<Verse>
+QuranRepository::verseInfoRange(const int fromId, const int toId) const
+{
+  return readVerses(m_statements.exec("verseInfoRange", { fromId, toId }));
+}
+
+int
+QuranRepository::surahStartPage(int surahIdx) const
+{
+  int id = QuranMetadata::verseId(surahIdx, 1);
+  return QuranMetadata::versePage[m_config.qcfVersion() - 1][id - 1];
 }
 
 QString
 QuranRepository::surahName(const int sIdx, bool ar) const
 {
-  QSqlQuery dbQuery(*this);
+  if (sIdx < 1 || sIdx > QuranMetadata::surahTotal)
+    return QString();
 
   if (m_config.language() == QLocale::Arabic || ar)
-    dbQuery.prepare("SELECT sura_name_ar FROM verses_v1 WHERE sura_no=:i");
-  else
-    dbQuery.prepare("SELECT sura_name_en FROM verses_v1 WHERE sura_no=:i");
-
-  dbQuery.bindValue(0, sIdx);
-  executeQuery(dbQuery, "Error occurred during getSurahName SQL statment exec");
-
-  dbQuery.next();
-  return dbQuery.value(0).toString();
+    return QString::fromUtf8(QuranMetadata::surahNamesAr[sIdx - 1]);
+  return QString::fromUtf8(QuranMetadata::surahNamesEn[sIdx - 1]);
 }
 
 Verse
 QuranRepository::verseById(const int id) const
 {
-  QSqlQuery dbQuery(*this);
-  dbQuery.prepare("SELECT page,sura_no,aya_no FROM verses_v" +
-                  QString::number(m_config.qcfVersion()) + " WHERE id=:i");
-  dbQuery.bindValue(0, id);
-
-  executeQuery(dbQuery,
-               "Error occurred during getVerseById SQL statement exec");
-  dbQuery.next();
-
-  return Verse(dbQuery.value(0).toInt(),
-               dbQuery.value(1).toInt(),
-               dbQuery.value(2).toInt());
+  QList<Verse> verses = readVerses(m_statements.exec("verseById", { id }));
+  return verses.isEmpty() ? Verse(0, 0, 0) : verses.first();
 }
 
 int
 QuranRepository::versePage(const int& surahIdx, const int& verse) const
 {
-  QSqlQuery dbQuery(*this);
-
-  QString query = "SELECT page FROM verses_v%0 WHERE sura_no=%1 AND aya_no=%2";
-  dbQuery.prepare(query.arg(QString::number(m_config.qcfVersion()),
-                            QString::number(surahIdx),
-                            QString::number(verse)));
-
-  executeQuery(dbQuery, "Error occurred during getVersePage SQL statment exec");
-  dbQuery.next();
-
-  return dbQuery.value(0).toInt();
+  return m_statements.scalar<int>("versePage", { surahIdx, verse });
 }
 
 QList<int>
 QuranRepository::searchSurahNames(QString text) const
 {
-  QList<int> results;
-  QSqlQuery dbQuery(*this);
-  QString q =
-    "SELECT DISTINCT sura_no FROM verses_v1 WHERE (sura_name_ar like '%" +
-    text +
-    "%' OR "
-    "sura_name_en like '%" +
-    text + "%')";
-
-  dbQuery.prepare(q);
-  executeQuery(dbQuery,
-               "Error occurred during searchSurahNames SQL statment exec");
-
-  while (dbQuery.next()) {
-    results.append(dbQuery.value(0).toInt());
-  }
+  const QString pattern = '%' + text + '%';
+  return m_statements.column<int>("searchSurahNames", { pattern, pattern });
+}
+
+QList<Verse>
+QuranRepository::versesFromIds(const QList<int>& ids) const
+{
+  QList<Verse> verses;
+  verses.reserve(ids.size());
+  for (int id : ids)
+    verses.append(Verse::fromId(id, m_config.qcfVersion()));
 
-  return results;
+  return verses;
 }
 
 QList<Verse>
@@ -291,34 +354,24 @@ QuranRepository::searchSurahs(QString searchText,
                               const QList<int> surahs,
                               const bool whole) const
 {
-  QList<Verse> results;
-  QSqlQuery dbQuery(*this);
+  // partial words are matched by substring, which the index can't answer
+  std::optional<QList<int>> ids;
+  if (whole)
+    ids = m_searchIndex.searchSurahs(searchText, surahs);
+  if (ids.has_value())
+    return versesFromIds(ids.value());
 
-  QString q = "SELECT page,sura_no,aya_no FROM verses_v" +
-              QString::number(m_config.qcfVersion()) + " WHERE (";
-  for (int i = 0; i < surahs.size(); i++) {
-    q.append("sura_no=" + QString::number(surahs.at(i)) + ' ');
-    if (i != surahs.size() - 1)
-      q.append("OR ");
-  }
+  QString surahList = ",";
+  for (int surah : surahs)
+    surahList.append(QString::number(surah) + ',');
 
   if (whole)
-    q.append(") AND (aya_text_emlaey like '" + searchText +
-             " %' OR aya_text_emlaey like '% " + searchText +
-             " %') ORDER BY id");
-  else
-    q.append(") AND (aya_text_emlaey like '%" + searchText + "%') ORDER BY id");
-
-  dbQuery.prepare(q);
-  executeQuery(dbQuery, "Error occurred during searchSurahs SQL statment exec");
-
-  while (dbQuery.next()) {
-    results.append(Verse(dbQuery.value(0).toInt(),
-                         dbQuery.value(1).toInt(),
-                         dbQuery.value(2).toInt()));
-  }
+    return readVerses(m_statements.exec(
+      "searchSurahsWhole",
+      { surahList, searchText + " %", "% " + searchText + " %" }));
 
-  return results;
+  return readVerses(
+    m_statements.exec("searchSurahs", { surahList, '%' + searchText + '%' }));
 }
 
 QList<Verse>
@@ -326,47 +379,34 @@ QuranRepository::searchVerses(QString searchText,
                               const int range[],
                               const bool whole) const
 {
-  QList<Verse> results;
-  QSqlQuery dbQuery(*this);
-
-  QString q = "SELECT page,sura_no,aya_no FROM verses_v" +
-              QString::number(m_config.qcfVersion()) +
-              " WHERE (page >= " + QString::number(range[0]) +
-              " AND page <= " + QString::number(range[1]) + ")";
+  // a page range is a contiguous range of verse ids
+  const int v = m_config.qcfVersion() - 1;
+  const int first = std::clamp(range[0], 1, QuranMetadata::pageTotal);
+  const int last = std::clamp(range[1], first, QuranMetadata::pageTotal);
+  // partial words are matched by substring, which the index can't answer
+  std::optional<QList<int>> ids;
+  if (whole) {
+    const int fromId = QuranMetadata::pageFirstVerse[v][first];
+    const int toId = QuranMetadata::pageFirstVerse[v][last + 1] - 1;
+    ids = m_searchIndex.searchVerses(searchText, fromId, toId);
+  }
+  if (ids.has_value())
+    return versesFromIds(ids.value());
 
   if (whole)
-    q.append(" AND (aya_text_emlaey like '" + searchText +
-             " %' OR aya_text_emlaey like '% " + searchText +
-             " %') ORDER BY id");
-  else
-    q.append(" AND (aya_text_emlaey like '%" + searchText + "%') ORDER BY id");
-
-  dbQuery.prepare(q);
-  executeQuery(dbQuery, "Error occurred during searchVerses SQL statment exec");
-
-  while (dbQuery.next()) {
-    results.append(Verse(dbQuery.value(0).toInt(),
-                         dbQuery.value(1).toInt(),
-                         dbQuery.value(2).toInt()));
-  }
+    return readVerses(m_statements.exec(
+      "searchVersesWhole",
+      { range[0], range[1], searchText + " %", "% " + searchText + " %" }));
 
-  return results;
+  return readVerses(m_statements.exec(
+    "searchVerses", { range[0], range[1], '%' + searchText + '%' }));
 }
 
 Verse
 QuranRepository::randomVerse() const
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare("SELECT page,sura_no,aya_no FROM verses_v" +
-                  QString::number(m_config.qcfVersion()) +
-                  " WHERE id = (ABS(RANDOM()) % 6236) + 1");
-
-  executeQuery(dbQuery, "Error occurred during randomVerse SQL statment exec");
-  dbQuery.next();
-  return Verse(dbQuery.value(0).toInt(),
-               dbQuery.value(1).toInt(),
-               dbQuery.value(2).toInt());
+  QList<Verse> verses = readVerses(m_statements.exec("randomVerse"));
+  return verses.isEmpty() ? Verse(0, 0, 0) : verses.first();
 }
 
 QStringList
@@ -409,3 +449,22 @@ QuranRepository::previous(const Verse& verse, bool withBasmallah) const
   nxt = verseById(nxt.id(nxt.surah(), nxt.number()) - 1);
   return nxt;
 }
+
+QStringList
+QuranRepository::emlaeyTexts() const
+{
+  return m_statements.column<QString>("emlaeyTexts");
+}
+
+QStringList
+QuranRepository::displayTexts(ConfigurationSchema::VerseType type) const
+{
+  switch (type) {
+    case ConfigurationSchema::HafsAnnotated:
+      return m_statements.column<QString>("verseTextsAnnotated");
+    case ConfigurationSchema::Warsh:
+      return m_statements.column<QString>("verseTextsWarsh");
+    default:
+      return m_statements.column<QString>("verseTexts");
+  }
+}
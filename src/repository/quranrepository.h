@@ -5,6 +5,8 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <repository/dbconnection.h>
+#include <repository/searchindexrepository.h>
+#include <repository/statementregistry.h>
 #include <types/verse.h>
 #include <utils/configuration.h>
 #include <utils/dirmanager.h>
@@ -89,6 +91,40 @@ public:
    * @return The text of the specified verse.
    */
   QString verseText(const int sIdx, const int vIdx) const;
+  /**
+   * @brief Get the texts of a range of verses in a surah in a single query.
+   * @param surah The surah index of the verses.
+   * @param from The first verse number.
+   * @param to The last verse number.
+   * @return The texts of the verses in order.
+   */
+  QStringList verseTexts(const int surah, const int from, const int to) const;
+  /**
+   * @brief Get the texts of a range of verse ids in a single query.
+   * @param fromId The first verse id.
+   * @param toId The last verse id.
+   * @return The texts of the verses in mushaf order.
+   */
+  QStringList verseTextRange(const int fromId, const int toId) const;
+  /**
+   * @brief Get the texts of any set of verses in a single query.
+   * @param ids QList of verse ids.
+   * @return The texts of the verses in the order of the given ids.
+   */
+  QStringList verseTextsById(const QList<int>& ids) const;
+  /**
+   * @brief Get the texts of all verses of a page in a single query.
+   * @param page The page number in the active QCF version.
+   * @return The texts of the page verses in order.
+   */
+  QStringList pageVerseTexts(const int page) const;
+  /**
+   * @brief Get the verses of a range of verse ids in a single query.
+   * @param fromId The first verse id.
+   * @param toId The last verse id.
+   * @return The verses in mushaf order.
+   */
+  QList<Verse> verseInfoRange(const int fromId, const int toId) const;
   /**
    * @brief Get the starting page of a specific surah.
    * @param surahIdx The surah index.
@@ -172,6 +208,17 @@ public:
    * @return The previous verse.
    */
   Verse previous(const Verse& verse, bool withBasmallah) const;
+  /**
+   * @brief Get the emlaey (plain spelling) text of every verse.
+   * @return A list of the verse texts ordered by verse id.
+   */
+  QStringList emlaeyTexts() const;
+  /**
+   * @brief Get the displayed text of every verse.
+   * @param type The verse text variant, the Uthmani text is returned for QCF.
+   * @return A list of the verse texts ordered by verse id.
+   */
+  QStringList displayTexts(ConfigurationSchema::VerseType type) const;
 
 private:
   /**
@@ -180,12 +227,17 @@ private:
    */
   QuranRepository();
   /**
-   * @brief Execute a SQL query and handle errors.
-   * @param query The SQL query to execute.
-   * @param errMsg Error message to log if the query fails.
-   * @return True if the query was successful, false otherwise.
+   * @brief Prepare the statements used by the repository queries against the
+   * verses table of the active QCF version.
+   */
+  void prepareStatements();
+  /**
+   * @brief Construct the verses matching the given ids using the active QCF
+   * version pages.
+   * @param ids QList of verse ids.
+   * @return QList of Verse instances in the same order.
    */
-  bool executeQuery(QSqlQuery& query, QString errMsg) const;
+  QList<Verse> versesFromIds(const QList<int>& ids) const;
   /**
    * @brief Reference to the singleton Configuration instance.
    */
@@ -201,6 +253,15 @@ private:
    * English).
    */
   QStringList m_surahNames;
+  /**
+   * @brief Statements prepared once when the connection is opened.
+   */
+  mutable StatementRegistry m_statements;
+  /**
+   * @brief Reference to the full-text search index, searches fall back to
+   * scanning the verses table until it is ready.
+   */
+  SearchIndexRepository& m_searchIndex;
 };
 
 #endif // QURANREPOSITORY_H
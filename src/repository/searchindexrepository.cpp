@@ -0,0 +1,250 @@
+#include "searchindexrepository.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QtConcurrent>
+#include <utils/arabicnormalizer.h>
+#include <utils/indexfile.h>
+
+/**
+ * @brief bumped whenever the index schema or the text normalization changes
+ */
+static const int indexFormatVersion = 1;
+
+SearchIndexRepository&
+SearchIndexRepository::getInstance()
+{
+  static SearchIndexRepository sidb;
+  return sidb;
+}
+
+SearchIndexRepository::SearchIndexRepository()
+  : QSqlDatabase(QSqlDatabase::addDatabase("QSQLITE", "SearchIndexCon"))
+  , m_assetsDir(DirManager::getInstance().assetsDir())
+  , m_downloadsDir(DirManager::getInstance().downloadsDir())
+  , m_statements("SearchIndexCon")
+{
+  // the build holds its own connections and writes search.db, let it stop
+  // before the database drivers are torn down
+  connect(qApp, &QCoreApplication::aboutToQuit, this, [this]() {
+    m_cancelled = true;
+    QMutexLocker locker(&m_buildLock);
+    m_build.waitForFinished();
+  });
+}
+
+void
+SearchIndexRepository::startBuild()
+{
+  QMutexLocker locker(&m_buildLock);
+  if (m_build.isValid() || m_cancelled)
+    return;
+
+  const QString quranDbPath = m_assetsDir.absoluteFilePath("quran.db");
+  const QString indexPath = m_downloadsDir.absoluteFilePath("search.db");
+  m_build = QtConcurrent::run([this, quranDbPath, indexPath]() {
+    if (prepareIndex(quranDbPath, indexPath, m_cancelled))
+      m_ready = true;
+  });
+}
+
+void
+SearchIndexRepository::open()
+{
+  m_statements.clear();
+  setDatabaseName(m_downloadsDir.absoluteFilePath("search.db"));
+  setConnectOptions("QSQLITE_OPEN_READONLY");
+  if (!QSqlDatabase::open()) {
+    qWarning() << "Couldn't open search index:" << lastError();
+    m_ready = false;
+    return;
+  }
+
+  m_statements.prepare("searchRange",
+                       "SELECT rowid FROM verses_fts WHERE verses_fts MATCH ? "
+                       "AND rowid BETWEEN ? AND ? ORDER BY rowid");
+  // the surah list is bound as ",1,2,3," and matched against ",surah,"
+  m_statements.prepare("searchSurahs",
+                       "SELECT rowid FROM verses_fts WHERE verses_fts MATCH ? "
+                       "AND instr(?, ',' || surah || ',') > 0 ORDER BY rowid");
+}
+
+DbConnection::Type
+SearchIndexRepository::type()
+{
+  return DbConnection::SearchIndex;
+}
+
+bool
+SearchIndexRepository::isReady() const
+{
+  return m_ready;
+}
+
+bool
+SearchIndexRepository::ensureOpen()
+{
+  if (!m_ready) {
+    startBuild();
+    return false;
+  }
+  // other threads query a clone of the connection, which only exists once
+  // the main thread has opened it
+  if (!isOpen() && QThread::currentThread() == qApp->thread())
+    SearchIndexRepository::open();
+  return isOpen();
+}
+
+std::optional<QList<int>>
+SearchIndexRepository::searchVerses(const QString& text,
+                                    int fromId,
+                                    int toId)
+{
+  if (!ensureOpen())
+    return std::nullopt;
+
+  const QString expression = matchExpression(text);
+  if (expression.isEmpty())
+    return QList<int>();
+
+  return m_statements.column<int>("searchRange", { expression, fromId, toId });
+}
+
+std::optional<QList<int>>
+SearchIndexRepository::searchSurahs(const QString& text,
+                                    const QList<int>& surahs)
+{
+  if (!ensureOpen())
+    return std::nullopt;
+
+  const QString expression = matchExpression(text);
+  if (expression.isEmpty())
+    return QList<int>();
+
+  QString surahList = ",";
+  for (int surah : surahs)
+    surahList.append(QString::number(surah) + ',');
+
+  return m_statements.column<int>("searchSurahs", { expression, surahList });
+}
+
+QString
+SearchIndexRepository::matchExpression(const QString& text)
+{
+  QStringList tokens = ArabicNormalizer::tokens(text);
+  for (QString& token : tokens)
+    token.remove('"');
+  tokens.removeAll(QString());
+  if (tokens.isEmpty())
+    return QString();
+
+  // a single quoted phrase, words inside it are matched in sequence
+  return '"' + tokens.join(' ') + '"';
+}
+
+bool
+SearchIndexRepository::prepareIndex(const QString& quranDbPath,
+                                    const QString& indexPath,
+                                    const std::atomic_bool& cancelled)
+{
+  const QByteArray sourceStamp = IndexFile::stamp({ quranDbPath });
+  if (sourceStamp.isEmpty()) {
+    qWarning() << "Couldn't read quran db for the search index";
+    return false;
+  }
+  const QString stamp = QString::number(indexFormatVersion) + ':' + sourceStamp;
+
+  QString existing;
+  if (QFile::exists(indexPath)) {
+    {
+      QSqlDatabase db =
+        QSqlDatabase::addDatabase("QSQLITE", "SearchIndexCheckCon");
+      db.setDatabaseName(indexPath);
+      db.setConnectOptions("QSQLITE_OPEN_READONLY");
+      if (db.open()) {
+        QSqlQuery query(db);
+        if (query.exec("SELECT value FROM meta WHERE key='version'") &&
+            query.next())
+          existing = query.value(0).toString();
+      }
+    }
+    QSqlDatabase::removeDatabase("SearchIndexCheckCon");
+  }
+
+  if (existing == stamp)
+    return true;
+
+  qInfo() << "Building verse search index";
+  return IndexFile::replace(indexPath, [&](const QString& partPath) {
+    return writeIndex(quranDbPath, partPath, stamp, cancelled);
+  });
+}
+
+bool
+SearchIndexRepository::writeIndex(const QString& quranDbPath,
+                                  const QString& indexPath,
+                                  const QString& stamp,
+                                  const std::atomic_bool& cancelled)
+{
+  bool success = false;
+  {
+    QSqlDatabase quranDb =
+      QSqlDatabase::addDatabase("QSQLITE", "SearchIndexQuranCon");
+    quranDb.setDatabaseName(quranDbPath);
+    quranDb.setConnectOptions("QSQLITE_OPEN_READONLY");
+    QSqlDatabase indexDb =
+      QSqlDatabase::addDatabase("QSQLITE", "SearchIndexBuildCon");
+    indexDb.setDatabaseName(indexPath);
+
+    if (quranDb.open() && indexDb.open()) {
+      QSqlQuery index(indexDb);
+      // verse text is normalized before insertion, unicode61 only has to
+      // split on whitespace and punctuation
+      success =
+        index.exec("CREATE VIRTUAL TABLE verses_fts USING "
+                   "fts5(text, surah UNINDEXED, tokenize='unicode61')") &&
+        index.exec("CREATE TABLE meta(key TEXT PRIMARY KEY, value TEXT)") &&
+        indexDb.transaction();
+      if (!success)
+        qWarning() << "Couldn't create search index:" << index.lastError();
+
+      QSqlQuery verses(quranDb);
+      verses.setForwardOnly(true);
+      success = success &&
+                verses.exec("SELECT id,sura_no,aya_text_emlaey FROM verses_v1 "
+                            "ORDER BY id") &&
+                index.prepare(
+                  "INSERT INTO verses_fts(rowid, text, surah) VALUES(?, ?, ?)");
+
+      while (success && verses.next()) {
+        if (cancelled) {
+          success = false;
+          break;
+        }
+        const QString text = verses.value(2).toString();
+        index.bindValue(0, verses.value(0));
+        index.bindValue(1, ArabicNormalizer::normalize(text));
+        index.bindValue(2, verses.value(1));
+        success = index.exec();
+      }
+
+      success = success &&
+                index.exec(
+                  "INSERT INTO verses_fts(verses_fts) VALUES('optimize')") &&
+                index.prepare("INSERT INTO meta VALUES('version', ?)");
+      if (success) {
+        index.bindValue(0, stamp);
+        success = index.exec() && indexDb.commit();
+      }
+      if (!success) {
+        if (!cancelled)
+          qWarning() << "Couldn't build search index:" << index.lastError();
+        indexDb.rollback();
+      }
+    }
+  }
+  QSqlDatabase::removeDatabase("SearchIndexBuildCon");
+  QSqlDatabase::removeDatabase("SearchIndexQuranCon");
+  return success;
+}
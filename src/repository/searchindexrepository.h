@@ -0,0 +1,147 @@
+#ifndef SEARCHINDEXREPOSITORY_H
+#define SEARCHINDEXREPOSITORY_H
+
+#include <QDir>
+#include <QFuture>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <atomic>
+#include <optional>
+#include <repository/dbconnection.h>
+#include <repository/statementregistry.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class SearchIndexRepository
+ * @brief Manages the FTS5 full-text index of the verse texts.
+ *
+ * The index (`search.db` in the downloads directory) holds the normalized
+ * emlaey text of every verse keyed by verse id. It is verified against
+ * `quran.db` and (re)built on a background thread when first searched, the
+ * in-memory search never needs it. Searches return std::nullopt until it is
+ * ready so callers can fall back to scanning the verses table.
+ *
+ * Only whole word searches are answered by the index, partial words are
+ * matched by substring through the verses table so results don't change once
+ * the index is ready.
+ */
+class SearchIndexRepository
+  : public DbConnection
+  , QSqlDatabase
+{
+public:
+  /**
+   * @brief Get a reference to the singleton instance of SearchIndexRepository.
+   * @return Reference to the static class instance.
+   */
+  static SearchIndexRepository& getInstance();
+  /**
+   * @brief Open the connection to the index database.
+   */
+  void open() override;
+  /**
+   * @brief Get the type of the database connection.
+   * @return The type of the database connection (SearchIndex).
+   */
+  Type type() override;
+  /**
+   * @brief Check whether the index is built and matches quran.db.
+   * @return True if searches are answered by the index.
+   */
+  bool isReady() const;
+  /**
+   * @brief Search for verses within a range of verse ids matching the text as
+   * whole words.
+   * @param text The searched word or phrase.
+   * @param fromId The first verse id to search in.
+   * @param toId The last verse id to search in.
+   * @return Ordered QList of matching verse ids, std::nullopt if the index is
+   * not ready.
+   */
+  std::optional<QList<int>> searchVerses(const QString& text,
+                                         int fromId,
+                                         int toId);
+  /**
+   * @brief Search for verses in the given surahs matching the text as whole
+   * words.
+   * @param text The searched word or phrase.
+   * @param surahs QList of surah numbers to search in.
+   * @return Ordered QList of matching verse ids, std::nullopt if the index is
+   * not ready.
+   */
+  std::optional<QList<int>> searchSurahs(const QString& text,
+                                         const QList<int>& surahs);
+
+private:
+  SearchIndexRepository();
+  /**
+   * @brief Verifies the index file against quran.db and rebuilds it if
+   * needed. Runs on a worker thread using its own connections.
+   * @param quranDbPath Path to quran.db.
+   * @param indexPath Path to the index database.
+   * @param cancelled Flag set when the application is quitting.
+   * @return True if the index file is up to date.
+   */
+  static bool prepareIndex(const QString& quranDbPath,
+                           const QString& indexPath,
+                           const std::atomic_bool& cancelled);
+  /**
+   * @brief Writes a new index database.
+   * @param quranDbPath Path to quran.db.
+   * @param indexPath Path to the index database to write.
+   * @param stamp Version stamp stored in the index meta table.
+   * @param cancelled Flag set when the application is quitting.
+   * @return True if the index was written completely.
+   */
+  static bool writeIndex(const QString& quranDbPath,
+                         const QString& indexPath,
+                         const QString& stamp,
+                         const std::atomic_bool& cancelled);
+  /**
+   * @brief Builds an FTS5 MATCH expression for the given search text.
+   * @param text The searched word or phrase.
+   * @return QString of the MATCH expression, empty if the text has no tokens.
+   */
+  static QString matchExpression(const QString& text);
+  /**
+   * @brief Starts verifying or building the index in the background, once.
+   */
+  void startBuild();
+  /**
+   * @brief Starts the build on first use and opens the index connection once
+   * the index is ready.
+   * @return True if the index can be queried.
+   */
+  bool ensureOpen();
+  /**
+   * @brief Reference to the app assets directory.
+   */
+  const QDir& m_assetsDir;
+  /**
+   * @brief Reference to the user data (downloads) directory.
+   */
+  const QDir& m_downloadsDir;
+  /**
+   * @brief Set by the worker once the index file is up to date.
+   */
+  std::atomic_bool m_ready = false;
+  /**
+   * @brief Set when the application quits to stop an ongoing build.
+   */
+  std::atomic_bool m_cancelled = false;
+  /**
+   * @brief Future of the background verification/build task, invalid until
+   * the first search.
+   */
+  QFuture<void> m_build;
+  /**
+   * @brief Guards m_build, the first search may run on a worker thread.
+   */
+  QMutex m_buildLock;
+  /**
+   * @brief Statements prepared once when the connection is opened.
+   */
+  StatementRegistry m_statements;
+};
+
+#endif // SEARCHINDEXREPOSITORY_H
@@ -0,0 +1,61 @@
+#include "similarityrepository.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <repository/quranrepository.h>
+
+SimilarityRepository&
+SimilarityRepository::getInstance()
+{
+  static SimilarityRepository smdb;
+  return smdb;
+}
+
+SimilarityRepository::SimilarityRepository()
+  : m_downloadsDir(DirManager::getInstance().downloadsDir())
+{
+  // the build writes the cache file, stop it before the database drivers are
+  // torn down
+  QObject::connect(qApp, &QCoreApplication::aboutToQuit, [this]() {
+    m_cancelled = true;
+    QMutexLocker locker(&m_buildLock);
+    m_build.waitForFinished();
+  });
+}
+
+QFuture<void>
+SimilarityRepository::startBuild()
+{
+  QMutexLocker locker(&m_buildLock);
+  if (m_build.isValid() || m_cancelled)
+    return m_build;
+
+  const QString path = m_downloadsDir.absoluteFilePath("similarity.cache");
+  m_build = QtConcurrent::run([this, path]() {
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList texts = QuranRepository::getInstance().emlaeyTexts();
+    std::optional<SimilarityIndex> index =
+      SimilarityIndex::cached(texts, path, &m_cancelled);
+    if (!index)
+      return;
+    m_index = std::move(*index);
+    m_ready = true;
+    qInfo() << "Similarity index ready in" << timer.elapsed() << "ms";
+  });
+  return m_build;
+}
+
+bool
+SimilarityRepository::isReady() const
+{
+  return m_ready;
+}
+
+const SimilarityIndex&
+SimilarityRepository::index()
+{
+  if (!m_ready)
+    startBuild().waitForFinished();
+  return m_index;
+}
@@ -0,0 +1,74 @@
+#ifndef SIMILARITYREPOSITORY_H
+#define SIMILARITYREPOSITORY_H
+
+#include <QDir>
+#include <QFuture>
+#include <QMutex>
+#include <atomic>
+#include <search/similarityindex.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class SimilarityRepository
+ * @brief Manages the similarity index of the verse texts.
+ *
+ * The index is loaded from its cache file (`similarity.cache` in the
+ * downloads directory), or built from the emlaey text of every verse and
+ * cached, on a worker thread started by the first lookup, which waits for it.
+ * A build running when the application quits is cancelled.
+ */
+class SimilarityRepository
+{
+public:
+  /**
+   * @brief Get a reference to the singleton instance.
+   * @return Reference to the static class instance.
+   */
+  static SimilarityRepository& getInstance();
+  /**
+   * @brief Check whether the index is loaded or built.
+   */
+  bool isReady() const;
+  /**
+   * @brief Gets the similarity index, starting its load or build and waiting
+   * for it if not ready yet.
+   * @return Reference to the SimilarityIndex, empty if the build was
+   * cancelled.
+   */
+  const SimilarityIndex& index();
+
+private:
+  SimilarityRepository();
+  /**
+   * @brief Starts loading or building the index in the background, once.
+   * @return QFuture of the load or build.
+   */
+  QFuture<void> startBuild();
+  /**
+   * @brief Reference to the user data (downloads) directory.
+   */
+  const QDir& m_downloadsDir;
+  /**
+   * @brief The loaded or built index, written by the build only.
+   */
+  SimilarityIndex m_index;
+  /**
+   * @brief Set once m_index is complete.
+   */
+  std::atomic_bool m_ready = false;
+  /**
+   * @brief Set when the application quits to stop an ongoing build.
+   */
+  std::atomic_bool m_cancelled = false;
+  /**
+   * @brief Background load or build of the index, invalid until the first
+   * lookup.
+   */
+  QFuture<void> m_build;
+  /**
+   * @brief Guards m_build, lookups may come from worker threads.
+   */
+  QMutex m_buildLock;
+};
+
+#endif // SIMILARITYREPOSITORY_H
@@ -0,0 +1,205 @@
+#include "statementregistry.h"
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <algorithm>
+
+/**
+ * @brief A thread's clone of a registry connection and its statements.
+ */
+struct StatementRegistry::ThreadClone
+{
+  ThreadClone(const QString& source, const QString& name, int generation)
+    : generation(generation)
+    , registry(name)
+  {
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(source, name);
+    if (!db.open())
+      qCritical() << "Couldn't open" << name << ':' << db.lastError();
+  }
+  ~ThreadClone()
+  {
+    const QString name = registry.m_connectionName;
+    registry.clear();
+    QSqlDatabase::removeDatabase(name);
+  }
+  const int generation;
+  StatementRegistry registry;
+};
+
+/**
+ * @brief Connection clones of a single thread by source registry, deleted
+ * with the thread.
+ */
+struct StatementRegistry::ThreadClones
+{
+  ~ThreadClones() { qDeleteAll(clones); }
+  QHash<const StatementRegistry*, ThreadClone*> clones;
+};
+
+QList<StatementRegistry*> StatementRegistry::s_registries;
+QMutex StatementRegistry::s_registriesLock;
+QThreadStorage<StatementRegistry::ThreadClones*>
+  StatementRegistry::s_threadClones;
+
+StatementRegistry::StatementRegistry(const QString& connectionName)
+  : m_connectionName(connectionName)
+  , m_thread(QThread::currentThread())
+{
+  QMutexLocker locker(&s_registriesLock);
+  s_registries.append(this);
+}
+
+StatementRegistry::~StatementRegistry()
+{
+  QMutexLocker locker(&s_registriesLock);
+  s_registries.removeAll(this);
+}
+
+bool
+StatementRegistry::prepare(const QString& name, const QString& sql)
+{
+  QSharedPointer<Statement> statement(new Statement{
+    QSqlQuery(QSqlDatabase::database(m_connectionName, false)) });
+  statement->query.setForwardOnly(true);
+  if (!statement->query.prepare(sql)) {
+    qCritical() << "Couldn't prepare" << name << "statement on"
+                << m_connectionName << ':' << statement->query.lastError();
+    return false;
+  }
+
+  {
+    QMutexLocker locker(&m_sqlLock);
+    m_sql.insert(name, sql);
+  }
+
+  QMutexLocker locker(&m_statisticsLock);
+  if (m_dropped.contains(name)) {
+    QPair<int, qint64> previous = m_dropped.take(name);
+    statement->executions = previous.first;
+    statement->totalNsecs = previous.second;
+  }
+
+  m_statements.insert(name, statement);
+  return true;
+}
+
+void
+StatementRegistry::clear()
+{
+  {
+    QMutexLocker locker(&m_sqlLock);
+    m_sql.clear();
+  }
+  m_generation++;
+
+  QMutexLocker locker(&m_statisticsLock);
+  for (auto it = m_statements.cbegin(); it != m_statements.cend(); ++it) {
+    QPair<int, qint64>& dropped = m_dropped[it.key()];
+    dropped.first += it.value()->executions;
+    dropped.second += it.value()->totalNsecs;
+  }
+  m_statements.clear();
+}
+
+StatementRegistry&
+StatementRegistry::threadRegistry()
+{
+  if (!s_threadClones.hasLocalData())
+    s_threadClones.setLocalData(new ThreadClones);
+
+  ThreadClone*& clone = s_threadClones.localData()->clones[this];
+  const int generation = m_generation;
+  if (clone && clone->generation != generation) {
+    delete clone;
+    clone = nullptr;
+  }
+  if (!clone) {
+    const QString name =
+      m_connectionName + '@' +
+      QString::number(reinterpret_cast<quintptr>(QThread::currentThread()), 16);
+    clone = new ThreadClone(m_connectionName, name, generation);
+  }
+
+  return clone->registry;
+}
+
+QSqlQuery&
+StatementRegistry::exec(const QString& name, const QVariantList& values)
+{
+  if (QThread::currentThread() != m_thread) {
+    StatementRegistry& local = threadRegistry();
+    if (!local.m_statements.contains(name)) {
+      QString sql;
+      {
+        QMutexLocker locker(&m_sqlLock);
+        sql = m_sql.value(name);
+      }
+      if (!sql.isEmpty())
+        local.prepare(name, sql);
+    }
+    return local.exec(name, values);
+  }
+
+  const QSharedPointer<Statement> statement = m_statements.value(name);
+  if (statement.isNull()) {
+    qCritical() << "Statement" << name << "is not registered on"
+                << m_connectionName;
+    m_inactive = QSqlQuery();
+    return m_inactive;
+  }
+
+  QSqlQuery& query = statement->query;
+  query.finish();
+  for (int i = 0; i < values.size(); i++)
+    query.bindValue(i, values.at(i));
+
+  QElapsedTimer timer;
+  timer.start();
+  if (!query.exec())
+    qCritical() << "Couldn't execute" << name << "statement on"
+                << m_connectionName << ':' << query.lastError();
+
+  const qint64 elapsed = timer.nsecsElapsed();
+  QMutexLocker locker(&m_statisticsLock);
+  statement->executions++;
+  statement->totalNsecs += elapsed;
+  return query;
+}
+
+QList<StatementRegistry::Statistics>
+StatementRegistry::statistics() const
+{
+  QMutexLocker locker(&m_statisticsLock);
+  QHash<QString, QPair<int, qint64>> totals = m_dropped;
+  for (auto it = m_statements.cbegin(); it != m_statements.cend(); ++it) {
+    QPair<int, qint64>& total = totals[it.key()];
+    total.first += it.value()->executions;
+    total.second += it.value()->totalNsecs;
+  }
+
+  QList<Statistics> stats;
+  for (auto it = totals.cbegin(); it != totals.cend(); ++it)
+    stats.append({ it.key(), it.value().first, it.value().second });
+
+  std::sort(stats.begin(),
+            stats.end(),
+            [](const Statistics& a, const Statistics& b) {
+              return a.totalNsecs > b.totalNsecs;
+            });
+  return stats;
+}
+
+void
+StatementRegistry::logStatistics()
+{
+  QMutexLocker locker(&s_registriesLock);
+  for (const StatementRegistry* registry : s_registries) {
+    for (const Statistics& stat : registry->statistics()) {
+      if (!stat.executions)
+        continue;
+      qInfo().nospace() << registry->m_connectionName << '/' << stat.name
+                        << ": " << stat.executions << " executions, "
+                        << stat.totalNsecs / 1000 << "us total";
+    }
+  }
+}
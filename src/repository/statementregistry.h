@@ -0,0 +1,187 @@
+#ifndef STATEMENTREGISTRY_H
+#define STATEMENTREGISTRY_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QSqlQuery>
+#include <QString>
+#include <QThread>
+#include <QThreadStorage>
+#include <QVariant>
+#include <atomic>
+
+/**
+ * @class StatementRegistry
+ * @brief Per-connection registry of named, pre-prepared SQL statements.
+ *
+ * Repositories register their statements once when the connection is opened,
+ * so SQLite parses and plans each statement a single time. Statements are
+ * executed by name with positionally bound values, and the registry keeps
+ * the number of executions and the total execution time of each statement.
+ *
+ * Statements executed from a thread other than the one that created the
+ * registry run on a clone of the connection owned by that thread, prepared
+ * on first use from the registered SQL and dropped when the thread exits or
+ * the registry is cleared.
+ */
+class StatementRegistry
+{
+public:
+  /**
+   * @brief Execution statistics of a single registered statement.
+   */
+  struct Statistics
+  {
+    QString name;      ///< name the statement was registered with
+    int executions;    ///< number of times the statement was executed
+    qint64 totalNsecs; ///< accumulated execution time in nanoseconds
+  };
+  /**
+   * @brief Creates an empty registry for the given connection.
+   * @param connectionName The name of the QSqlDatabase connection the
+   * statements are prepared on.
+   */
+  explicit StatementRegistry(const QString& connectionName);
+  ~StatementRegistry();
+  /**
+   * @brief Prepares a statement and registers it under the given name.
+   * @param name The name used to execute the statement later.
+   * @param sql The SQL statement, values are bound to '?' placeholders.
+   * @return True if the statement was prepared successfully.
+   */
+  bool prepare(const QString& name, const QString& sql);
+  /**
+   * @brief Drops all registered statements.
+   *
+   * Must be called before the underlying connection is closed or re-opened.
+   */
+  void clear();
+  /**
+   * @brief Binds the given values and executes the named statement.
+   * @param name The name of the registered statement.
+   * @param values Values bound in order to the statement placeholders.
+   * @return Reference to the executed query, positioned before the first row,
+   * or to an inactive query if no statement is registered under the name.
+   *
+   * The query is shared by every execution of the statement on the calling
+   * thread, executing the statement again resets it. Its rows must be read
+   * before the same statement is executed again, e.g. by a helper called while
+   * iterating them.
+   */
+  QSqlQuery& exec(const QString& name, const QVariantList& values = {});
+  /**
+   * @brief Executes the named statement and converts the first column of the
+   * first result row.
+   * @param name The name of the registered statement.
+   * @param values Values bound in order to the statement placeholders.
+   * @return The converted value, or a default constructed T if there is no
+   * result row.
+   */
+  template<typename T>
+  T scalar(const QString& name, const QVariantList& values = {});
+  /**
+   * @brief Executes the named statement and converts the first column of all
+   * result rows.
+   * @param name The name of the registered statement.
+   * @param values Values bound in order to the statement placeholders.
+   * @return QList of the converted values.
+   */
+  template<typename T>
+  QList<T> column(const QString& name, const QVariantList& values = {});
+  /**
+   * @brief Gets the execution statistics of all registered statements.
+   * @return QList of Statistics ordered by the total execution time.
+   */
+  QList<Statistics> statistics() const;
+  /**
+   * @brief Logs the execution statistics of every live registry.
+   */
+  static void logStatistics();
+
+private:
+  struct Statement
+  {
+    QSqlQuery query;
+    int executions = 0;
+    qint64 totalNsecs = 0;
+  };
+  struct ThreadClone;
+  struct ThreadClones;
+  /**
+   * @brief Gets the registry of the calling thread's clone of the connection.
+   */
+  StatementRegistry& threadRegistry();
+  /**
+   * @brief Registries alive in the application, used for logging statistics.
+   */
+  static QList<StatementRegistry*> s_registries;
+  static QMutex s_registriesLock;
+  /**
+   * @brief Connection clones of the registries per thread.
+   */
+  static QThreadStorage<ThreadClones*> s_threadClones;
+  /**
+   * @brief Name of the connection the statements are prepared on.
+   */
+  const QString m_connectionName;
+  /**
+   * @brief Thread the registry and its connection belong to.
+   */
+  QThread* const m_thread;
+  /**
+   * @brief Registered statements by name.
+   */
+  QHash<QString, QSharedPointer<Statement>> m_statements;
+  /**
+   * @brief Accumulated statistics of statements dropped by clear().
+   */
+  QHash<QString, QPair<int, qint64>> m_dropped;
+  /**
+   * @brief Guards m_statements, m_dropped and the statement statistics, which
+   * are read by logStatistics() from other threads.
+   */
+  mutable QMutex m_statisticsLock;
+  /**
+   * @brief SQL of the registered statements, used to prepare them on the
+   * connection clones of other threads.
+   */
+  QHash<QString, QString> m_sql;
+  /**
+   * @brief Guards m_sql against concurrent access from other threads.
+   */
+  QMutex m_sqlLock;
+  /**
+   * @brief Incremented by clear() to invalidate the connection clones.
+   */
+  std::atomic_int m_generation = 0;
+  /**
+   * @brief Inactive query returned when executing an unregistered statement.
+   */
+  QSqlQuery m_inactive;
+};
+
+template<typename T>
+T
+StatementRegistry::scalar(const QString& name, const QVariantList& values)
+{
+  QSqlQuery& query = exec(name, values);
+  if (!query.next())
+    return T();
+  return qvariant_cast<T>(query.value(0));
+}
+
+template<typename T>
+QList<T>
+StatementRegistry::column(const QString& name, const QVariantList& values)
+{
+  QList<T> result;
+  QSqlQuery& query = exec(name, values);
+  while (query.next())
+    result.append(qvariant_cast<T>(query.value(0)));
+  return result;
+}
+
+#endif // STATEMENTREGISTRY_H
@@ -1,5 +1,4 @@
 #include "tafsirrepository.h"
-#include <QSqlQuery>
 #include <types/tafsir.h>
 
 TafsirRepository&
@@ -14,6 +13,7 @@ TafsirRepository::TafsirRepository()
   , m_config(Configuration::getInstance())
   , m_dirMgr(DirManager::getInstance())
   , m_tafasir(Tafsir::tafasir)
+  , m_statements("TafsirCon")
 {
   loadTafsir();
 }
@@ -21,9 +21,13 @@ TafsirRepository::TafsirRepository()
 void
 TafsirRepository::open()
 {
+  // re-opening the connection finalizes the statements prepared on it
+  m_statements.clear();
   setDatabaseName(m_tafsirFile.absoluteFilePath());
   if (!QSqlDatabase::open())
     qFatal("Error opening tafsir db");
+  m_statements.prepare("content",
+                       "SELECT text FROM content WHERE sura=? AND aya=?");
 }
 
 DbConnection::Type
@@ -68,18 +72,7 @@ TafsirRepository::setCurrentTafsir(QString id)
 QString
 TafsirRepository::getTafsir(const int sIdx, const int vIdx)
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare("SELECT text FROM content WHERE sura=:s AND aya=:v");
-  dbQuery.bindValue(0, sIdx);
-  dbQuery.bindValue(1, vIdx);
-
-  if (!dbQuery.exec())
-    qCritical("Couldn't execute getTafsir query!");
-
-  dbQuery.next();
-
-  return dbQuery.value(0).toString();
+  return m_statements.scalar<QString>("content", { sIdx, vIdx });
 }
 
 std::optional<const Tafsir>
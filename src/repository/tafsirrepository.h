@@ -6,6 +6,7 @@
 #include <QSharedPointer>
 #include <QSqlDatabase>
 #include <repository/dbconnection.h>
+#include <repository/statementregistry.h>
 #include <types/tafsir.h>
 #include <utils/configuration.h>
 #include <utils/dirmanager.h>
@@ -97,6 +98,10 @@ private:
    * @brief Path to the currently active tafsir database file.
    */
   QFileInfo m_tafsirFile;
+  /**
+   * @brief Statements prepared each time a tafsir database is opened.
+   */
+  mutable StatementRegistry m_statements;
 };
 
 #endif // TAFSIRREPOSITORY_H
@@ -0,0 +1,175 @@
+#include "tafsirsearchrepository.h"
+#include <QFile>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <generated/quranmetadata.h>
+#include <utils/arabicnormalizer.h>
+#include <utils/htmlstripper.h>
+
+/**
+ * @brief bumped whenever the index schema, the HTML stripping or the text
+ * normalization changes
+ */
+static const int indexFormatVersion = 1;
+
+/**
+ * @brief characters surrounding the matches in FTS5 snippets, they never
+ * occur in stripped and normalized text
+ */
+static const QChar matchOpen(0x02);
+static const QChar matchClose(0x03);
+
+TafsirSearchRepository&
+TafsirSearchRepository::getInstance()
+{
+  static TafsirSearchRepository tsdb;
+  return tsdb;
+}
+
+TafsirSearchRepository::TafsirSearchRepository()
+  : ContentSearchRepository("Tafsir", indexFormatVersion)
+  , m_downloadsDir(DirManager::getInstance().downloadsDir())
+{
+}
+
+QFuture<bool>
+TafsirSearchRepository::prepareIndex(const ::Tafsir& tafsir, bool recheck)
+{
+  const QDir& baseDir =
+    tafsir.isExtra() ? m_downloadsDir : DirManager::getInstance().assetsDir();
+  return ContentSearchRepository::prepareIndex(
+    tafsir.id(),
+    baseDir.absoluteFilePath("tafasir/" + tafsir.filename()),
+    indexPath(tafsir),
+    recheck);
+}
+
+QList<int>
+TafsirSearchRepository::search(const QString& text,
+                               const ::Tafsir& tafsir,
+                               bool whole)
+{
+  const QString expression = matchExpression(text, whole);
+  if (expression.isEmpty() || !tafsir.isAvailable())
+    return {};
+
+  QFuture<bool> build = prepareIndex(tafsir);
+  if (!build.result())
+    return {};
+  return searchIndex(indexPath(tafsir), expression);
+}
+
+QList<TafsirSnippet>
+TafsirSearchRepository::snippets(const QStringList& phrases,
+                                 const ::Tafsir& tafsir,
+                                 bool whole,
+                                 const QList<int>& verses)
+{
+  // any of the phrases is highlighted, a verse matches at least one of them
+  QStringList expressions;
+  for (const QString& phrase : phrases) {
+    const QString expression = matchExpression(phrase, whole);
+    if (!expression.isEmpty())
+      expressions.append(expression);
+  }
+  const QString expression = expressions.join(" OR ");
+  const QString path = indexPath(tafsir);
+  if (expression.isEmpty() || verses.isEmpty() || !QFile::exists(path))
+    return {};
+
+  QList<TafsirSnippet> result;
+  withIndex(path, [&](QSqlDatabase& db) {
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    // about 24 tokens around the best matching part of the text
+    bool ok = query.prepare(
+      "SELECT snippet(content_fts, 0, char(2), char(3), '…', 24) FROM "
+      "content_fts WHERE content_fts MATCH ? AND rowid=?");
+    for (int i = 0; ok && i < verses.size(); i++) {
+      query.bindValue(0, expression);
+      query.bindValue(1, verses.at(i));
+      ok = query.exec();
+      if (!ok || !query.next())
+        continue;
+
+      // the markers are dropped, their positions give the match offsets
+      const QString marked = query.value(0).toString();
+      TafsirSnippet snippet{ verses.at(i), QString(), {} };
+      snippet.text.reserve(marked.size());
+      int start = -1;
+      for (const QChar c : marked) {
+        if (c == matchOpen) {
+          start = snippet.text.size();
+        } else if (c == matchClose && start >= 0) {
+          snippet.matches.append({ start, snippet.text.size() - start });
+          start = -1;
+        } else {
+          snippet.text.append(c);
+        }
+      }
+      result.append(snippet);
+      query.finish();
+    }
+    if (!ok)
+      qWarning() << "Couldn't get snippets from" << path << ':'
+                 << query.lastError();
+  });
+  return result;
+}
+
+bool
+TafsirSearchRepository::writeContent(const QString& id,
+                                     QSqlDatabase& sourceDb,
+                                     QSqlDatabase& indexDb)
+{
+  QSqlQuery index(indexDb);
+  QSqlQuery content(sourceDb);
+  content.setForwardOnly(true);
+  int total = 0;
+  if (content.exec("SELECT COUNT(*) FROM content") && content.next())
+    total = content.value(0).toInt();
+  content.finish();
+
+  // rows are read one at a time, only the current row is held in memory
+  bool success =
+    content.exec("SELECT sura,aya,text FROM content") &&
+    index.prepare("INSERT INTO content_fts(rowid, text) VALUES(?, ?)");
+
+  int done = 0;
+  while (success && content.next()) {
+    if (isCancelled())
+      return false;
+    if (++done % commitInterval == 0) {
+      emit indexProgress(id, done, total);
+      success = indexDb.commit() && indexDb.transaction();
+    }
+
+    const int surah = content.value(0).toInt();
+    const int verse = content.value(1).toInt();
+    if (surah < 1 || surah > QuranMetadata::surahTotal || verse < 1 ||
+        verse > QuranMetadata::surahVerseCount(surah))
+      continue;
+    // verses sharing a tafsir with the previous one have empty rows
+    const QString text = ArabicNormalizer::normalize(
+      HtmlStripper::strip(content.value(2).toString()));
+    if (text.isEmpty())
+      continue;
+    index.bindValue(0, QuranMetadata::verseId(surah, verse));
+    index.bindValue(1, text);
+    success = success && index.exec();
+  }
+  emit indexProgress(id, done, total);
+
+  if (!success)
+    qWarning() << "Couldn't index tafsir content:"
+               << (content.lastError().isValid() ? content.lastError()
+                                                 : index.lastError());
+  return success;
+}
+
+QString
+TafsirSearchRepository::indexPath(const ::Tafsir& tafsir) const
+{
+  return m_downloadsDir.absoluteFilePath("tafasir/" + tafsir.id() +
+                                         ".fts.db");
+}
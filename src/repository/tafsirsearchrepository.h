@@ -0,0 +1,97 @@
+#ifndef TAFSIRSEARCHREPOSITORY_H
+#define TAFSIRSEARCHREPOSITORY_H
+
+#include <QDir>
+#include <repository/contentsearchrepository.h>
+#include <types/tafsir.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class TafsirSearchRepository
+ * @brief Manages the FTS5 full-text indices of the tafsir databases.
+ *
+ * Each tafsir gets its own index (`tafasir/<id>.fts.db` in the downloads
+ * directory) holding the plain text of its `content` table, with the HTML
+ * markup stripped, keyed by verse id. Indices are built on a worker thread
+ * right after a tafsir is downloaded, or on the first search of a tafsir
+ * that was never indexed, and are rebuilt when the tafsir file changes.
+ *
+ * Tafsir files reach hundreds of megabytes, builds stream the content rows
+ * one at a time and commit in batches so memory use does not grow with the
+ * size of the tafsir. Build progress is reported through indexProgress().
+ */
+class TafsirSearchRepository : public ContentSearchRepository
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Get a reference to the singleton instance.
+   * @return Reference to the static class instance.
+   */
+  static TafsirSearchRepository& getInstance();
+  /**
+   * @brief Starts verifying or building the index of a tafsir in the
+   * background, if not already started.
+   * @param tafsir The tafsir to index.
+   * @param recheck If true, the index is verified again even if it was up to
+   * date, used after the tafsir file is downloaded again.
+   * @return QFuture holding true once the index is up to date.
+   */
+  QFuture<bool> prepareIndex(const ::Tafsir& tafsir, bool recheck = false);
+  /**
+   * @brief Searches the tafsir of all verses, indexing the tafsir first if
+   * needed.
+   * @param text The searched word or phrase.
+   * @param tafsir The tafsir to search.
+   * @param whole If false, the last word is matched as a prefix.
+   * @return Ascending QList of the ids of verses whose tafsir matches.
+   */
+  QList<int> search(const QString& text, const ::Tafsir& tafsir, bool whole);
+  /**
+   * @brief Gets excerpts of the tafsir of the given verses around the
+   * matches of a search.
+   * @param phrases The searched phrases, excerpts show the matches of any of
+   * them.
+   * @param tafsir The searched tafsir, must be indexed.
+   * @param whole If false, the last word is matched as a prefix.
+   * @param verses Ids of the verses to get excerpts for.
+   * @return QList of TafsirSnippet in the order of the given verses, verses
+   * whose tafsir does not match are skipped.
+   */
+  QList<TafsirSnippet> snippets(const QStringList& phrases,
+                                const ::Tafsir& tafsir,
+                                bool whole,
+                                const QList<int>& verses);
+
+signals:
+  /**
+   * @brief Emitted from the building thread while an index is built.
+   * @param id Id of the tafsir being indexed.
+   * @param done Number of content rows indexed so far.
+   * @param total Number of content rows in the tafsir.
+   */
+  void indexProgress(QString id, int done, int total);
+
+protected:
+  bool writeContent(const QString& id,
+                    QSqlDatabase& sourceDb,
+                    QSqlDatabase& indexDb) override;
+
+private:
+  TafsirSearchRepository();
+  /**
+   * @brief Get the path of the index of a tafsir.
+   */
+  QString indexPath(const ::Tafsir& tafsir) const;
+  /**
+   * @brief Number of content rows inserted per transaction while building.
+   */
+  static const int commitInterval = 512;
+  /**
+   * @brief Reference to the user data (downloads) directory.
+   */
+  const QDir& m_downloadsDir;
+};
+
+#endif // TAFSIRSEARCHREPOSITORY_H
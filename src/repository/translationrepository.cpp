@@ -1,5 +1,5 @@
 #include "translationrepository.h"
-#include <QSqlQuery>
+#include <generated/quranmetadata.h>
 
 TranslationRepository&
 TranslationRepository::getInstance()
@@ -13,15 +13,24 @@ TranslationRepository::TranslationRepository()
   , m_dirMgr(DirManager::getInstance())
   , m_config(Configuration::getInstance())
   , m_translations(Translation::translations)
+  , m_statements("TranslationCon")
 {
 }
 
 void
 TranslationRepository::open()
 {
+  // re-opening the connection finalizes the statements prepared on it
+  m_statements.clear();
   setDatabaseName(m_translationFile.absoluteFilePath());
   if (!QSqlDatabase::open())
     qFatal("Error opening translation db");
+  m_statements.prepare("content",
+                       "SELECT text FROM content WHERE sura=? AND aya=?");
+  // content ids follow the verse ids
+  m_statements.prepare(
+    "contentRange",
+    "SELECT text FROM content WHERE id BETWEEN ? AND ? ORDER BY id");
 }
 
 DbConnection::Type
@@ -67,18 +76,19 @@ TranslationRepository::setCurrentTranslation(QString id)
 QString
 TranslationRepository::getTranslation(const int sIdx, const int vIdx) const
 {
-  QSqlQuery dbQuery(*this);
-
-  dbQuery.prepare("SELECT text FROM content WHERE sura=:s AND aya=:v");
-  dbQuery.bindValue(0, sIdx);
-  dbQuery.bindValue(1, vIdx);
-
-  if (!dbQuery.exec())
-    qCritical("Couldn't execute getTranslation query!");
-
-  dbQuery.next();
+  return m_statements.scalar<QString>("content", { sIdx, vIdx });
+}
 
-  return dbQuery.value(0).toString();
+QStringList
+TranslationRepository::translationsForPage(const int page) const
+{
+  if (page < 1 || page > QuranMetadata::pageTotal)
+    return {};
+  const int v = m_config.qcfVersion() - 1;
+  return m_statements.column<QString>(
+    "contentRange",
+    { QuranMetadata::pageFirstVerse[v][page],
+      QuranMetadata::pageFirstVerse[v][page + 1] - 1 });
 }
 
 std::optional<const ::Translation>
@@ -6,6 +6,7 @@
 #include <QSharedPointer>
 #include <QSqlDatabase>
 #include <repository/dbconnection.h>
+#include <repository/statementregistry.h>
 #include <types/translation.h>
 #include <utils/configuration.h>
 #include <utils/dirmanager.h>
@@ -63,6 +64,13 @@ public:
    * @return The translation text for the specified surah and ayah.
    */
   QString getTranslation(const int sIdx, const int vIdx) const;
+  /**
+   * @brief Retrieves the translation of all verses of a page in a single
+   * query.
+   * @param page The page number in the active QCF version.
+   * @return QStringList of the translations of the page verses in order.
+   */
+  QStringList translationsForPage(const int page) const;
   /**
    * @brief Gets the currently selected translation.
    * @return An optional containing the current translation, or an empty
@@ -95,6 +103,10 @@ private:
    * @brief Path to the currently active translation database file.
    */
   QFileInfo m_translationFile;
+  /**
+   * @brief Statements prepared each time a translation database is opened.
+   */
+  mutable StatementRegistry m_statements;
 };
 
 #endif // TRANSLATIONREPOSITORY_H
@@ -0,0 +1,111 @@
+#include "translationsearchrepository.h"
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QtConcurrent>
+#include <generated/quranmetadata.h>
+#include <utils/arabicnormalizer.h>
+
+/**
+ * @brief bumped whenever the index schema or the text normalization changes
+ */
+static const int indexFormatVersion = 1;
+
+TranslationSearchRepository&
+TranslationSearchRepository::getInstance()
+{
+  static TranslationSearchRepository tsdb;
+  return tsdb;
+}
+
+TranslationSearchRepository::TranslationSearchRepository()
+  : ContentSearchRepository("Translation", indexFormatVersion)
+  , m_downloadsDir(DirManager::getInstance().downloadsDir())
+{
+}
+
+QFuture<bool>
+TranslationSearchRepository::prepareIndex(const ::Translation& translation,
+                                          bool recheck)
+{
+  const QDir& baseDir = translation.isExtra()
+                          ? m_downloadsDir
+                          : DirManager::getInstance().assetsDir();
+  return ContentSearchRepository::prepareIndex(
+    translation.id(),
+    baseDir.absoluteFilePath("translations/" + translation.filename()),
+    indexPath(translation),
+    recheck);
+}
+
+QList<int>
+TranslationSearchRepository::search(const QString& text,
+                                    const QList<::Translation>& translations,
+                                    bool whole)
+{
+  const QString expression = matchExpression(text, whole);
+  if (expression.isEmpty())
+    return {};
+
+  QList<QPair<QFuture<bool>, QString>> indices;
+  for (const ::Translation& translation : translations) {
+    if (translation.isAvailable())
+      indices.append({ prepareIndex(translation), indexPath(translation) });
+  }
+
+  const auto searchOne = [&](const QPair<QFuture<bool>, QString>& index) {
+    QFuture<bool> build = index.first;
+    if (!build.result())
+      return QList<int>();
+    return searchIndex(index.second, expression);
+  };
+  const auto merge = [](QList<int>& all, const QList<int>& ids) {
+    all.append(ids);
+  };
+
+  QList<int> ids = QtConcurrent::blockingMappedReduced<QList<int>>(
+    indices, searchOne, merge, QtConcurrent::UnorderedReduce);
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+bool
+TranslationSearchRepository::writeContent(const QString& id,
+                                          QSqlDatabase& sourceDb,
+                                          QSqlDatabase& indexDb)
+{
+  Q_UNUSED(id);
+  QSqlQuery index(indexDb);
+  QSqlQuery content(sourceDb);
+  content.setForwardOnly(true);
+  bool success =
+    content.exec("SELECT sura,aya,text FROM content") &&
+    index.prepare("INSERT INTO content_fts(rowid, text) VALUES(?, ?)");
+
+  while (success && content.next()) {
+    if (isCancelled())
+      return false;
+    const int surah = content.value(0).toInt();
+    const int verse = content.value(1).toInt();
+    if (surah < 1 || surah > QuranMetadata::surahTotal || verse < 1 ||
+        verse > QuranMetadata::surahVerseCount(surah))
+      continue;
+    index.bindValue(0, QuranMetadata::verseId(surah, verse));
+    index.bindValue(1,
+                    ArabicNormalizer::normalize(content.value(2).toString()));
+    success = index.exec();
+  }
+
+  if (!success)
+    qWarning() << "Couldn't index translation content:"
+               << (content.lastError().isValid() ? content.lastError()
+                                                 : index.lastError());
+  return success;
+}
+
+QString
+TranslationSearchRepository::indexPath(const ::Translation& translation) const
+{
+  return m_downloadsDir.absoluteFilePath("translations/" + translation.id() +
+                                         ".fts.db");
+}
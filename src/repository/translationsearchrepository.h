@@ -0,0 +1,70 @@
+#ifndef TRANSLATIONSEARCHREPOSITORY_H
+#define TRANSLATIONSEARCHREPOSITORY_H
+
+#include <QDir>
+#include <repository/contentsearchrepository.h>
+#include <types/translation.h>
+#include <utils/dirmanager.h>
+
+/**
+ * @class TranslationSearchRepository
+ * @brief Manages the FTS5 full-text indices of the translation databases.
+ *
+ * Each translation gets its own index (`translations/<id>.fts.db` in the
+ * downloads directory) holding the text of its `content` table keyed by verse
+ * id. Indices are built on a worker thread right after a translation is
+ * downloaded, or on the first search for translations that were never
+ * indexed, and are rebuilt when the translation file changes.
+ */
+class TranslationSearchRepository : public ContentSearchRepository
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Get a reference to the singleton instance.
+   * @return Reference to the static class instance.
+   */
+  static TranslationSearchRepository& getInstance();
+  /**
+   * @brief Starts verifying or building the index of a translation in the
+   * background, if not already started.
+   * @param translation The translation to index.
+   * @param recheck If true, the index is verified again even if it was up to
+   * date, used after the translation file is downloaded again.
+   * @return QFuture holding true once the index is up to date.
+   */
+  QFuture<bool> prepareIndex(const ::Translation& translation,
+                             bool recheck = false);
+  /**
+   * @brief Searches the given translations, each on a worker thread of the
+   * global thread pool, and merges the results.
+   * @details Translations that are not indexed yet are indexed first.
+   * @param text The searched word or phrase.
+   * @param translations QList of the translations to search.
+   * @param whole If false, the last word is matched as a prefix.
+   * @return Ascending QList of the ids of verses whose translation matches in
+   * any of the translations.
+   */
+  QList<int> search(const QString& text,
+                    const QList<::Translation>& translations,
+                    bool whole);
+
+protected:
+  bool writeContent(const QString& id,
+                    QSqlDatabase& sourceDb,
+                    QSqlDatabase& indexDb) override;
+
+private:
+  TranslationSearchRepository();
+  /**
+   * @brief Get the path of the index of a translation.
+   */
+  QString indexPath(const ::Translation& translation) const;
+  /**
+   * @brief Reference to the user data (downloads) directory.
+   */
+  const QDir& m_downloadsDir;
+};
+
+#endif // TRANSLATIONSEARCHREPOSITORY_H
@@ -0,0 +1,314 @@
+#include "concordance.h"
+#include <QHash>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cstring>
+#include <generated/quranmetadata.h>
+#include <numeric>
+#include <utils/arabicnormalizer.h>
+#include <utils/indexfile.h>
+
+/**
+ * @brief bumped whenever the tokenization or the file layout changes
+ */
+static const quint32 formatVersion = 1;
+static const quint32 fileMagic = 0x51434343; // "QCCC"
+
+bool
+Concordance::write(const QStringList& texts,
+                   const QString& path,
+                   const QByteArray& stamp)
+{
+  // tokenized per surah in parallel, merged in mushaf order
+  QList<int> surahs(QuranMetadata::surahTotal);
+  std::iota(surahs.begin(), surahs.end(), 1);
+  const QList<QList<QStringList>> tokenized =
+    QtConcurrent::blockingMapped<QList<QList<QStringList>>>(
+      surahs, [&texts](int surah) {
+        QList<QStringList> verses;
+        const int first = QuranMetadata::surahOffset[surah - 1];
+        const int last =
+          std::min<int>(QuranMetadata::surahOffset[surah], texts.size());
+        for (int i = first; i < last; i++)
+          verses.append(ArabicNormalizer::tokens(texts.at(i)));
+        return verses;
+      });
+
+  QStringList words;
+  QList<quint32> verseStart;
+  for (const QList<QStringList>& verses : tokenized) {
+    for (const QStringList& tokens : verses) {
+      verseStart.append(words.size());
+      words.append(tokens);
+    }
+  }
+  verseStart.append(words.size());
+
+  QStringList terms = words;
+  std::sort(terms.begin(), terms.end());
+  terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+  QHash<QString, quint32> termIndex;
+  termIndex.reserve(terms.size());
+  for (int i = 0; i < terms.size(); i++)
+    termIndex.insert(terms.at(i), i);
+
+  // occurrences grouped by term through a counting sort of the positions
+  QList<quint32> wordTerms(words.size());
+  QList<Term> table(terms.size(), Term{ 0, 0, 0, 0 });
+  for (int i = 0; i < words.size(); i++) {
+    wordTerms[i] = termIndex.value(words.at(i));
+    table[wordTerms.at(i)].count++;
+  }
+  quint32 charCount = 0, occurrenceCount = 0;
+  for (int i = 0; i < terms.size(); i++) {
+    table[i].textOffset = charCount;
+    table[i].textLength = terms.at(i).size();
+    table[i].firstOccurrence = occurrenceCount;
+    charCount += terms.at(i).size();
+    occurrenceCount += table.at(i).count;
+  }
+  QList<quint32> occurrences(words.size());
+  QList<quint32> filled(terms.size(), 0);
+  for (int i = 0; i < words.size(); i++) {
+    const quint32 term = wordTerms.at(i);
+    occurrences[table.at(term).firstOccurrence + filled[term]++] = i;
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = fileMagic;
+  header.version = formatVersion;
+  header.termCount = terms.size();
+  header.wordCount = words.size();
+  header.verseCount = verseStart.size() - 1;
+  header.charCount = charCount;
+  std::memcpy(header.stamp,
+              stamp.constData(),
+              std::min<size_t>(stamp.size(), sizeof(header.stamp)));
+
+  return IndexFile::write(path, [&](QIODevice& file) {
+    bool success =
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ==
+        sizeof(header) &&
+      file.write(reinterpret_cast<const char*>(table.constData()),
+                 table.size() * sizeof(Term)) == table.size() * sizeof(Term);
+    for (const QList<quint32>* section :
+         { &occurrences, &wordTerms, &verseStart })
+      success = success &&
+                file.write(reinterpret_cast<const char*>(section->constData()),
+                           section->size() * sizeof(quint32)) ==
+                  section->size() * sizeof(quint32);
+    for (const QString& term : terms)
+      success = success &&
+                file.write(reinterpret_cast<const char*>(term.constData()),
+                           term.size() * sizeof(QChar)) ==
+                  term.size() * sizeof(QChar);
+    return success;
+  });
+}
+
+bool
+Concordance::open(const QString& path, const QByteArray& stamp)
+{
+  if (m_file.isOpen())
+    m_file.close();
+  m_header = nullptr;
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly))
+    return false;
+
+  const qint64 size = m_file.size();
+  const uchar* data = size >= qint64(sizeof(Header)) ? m_file.map(0, size)
+                                                     : nullptr;
+  if (!data) {
+    m_file.close();
+    return false;
+  }
+
+  const Header* header = reinterpret_cast<const Header*>(data);
+  char expected[sizeof(header->stamp)] = {};
+  std::memcpy(expected,
+              stamp.constData(),
+              std::min<size_t>(stamp.size(), sizeof(expected)));
+  const qint64 expectedSize =
+    sizeof(Header) + qint64(header->termCount) * sizeof(Term) +
+    (2 * qint64(header->wordCount) + header->verseCount + 1) *
+      sizeof(quint32) +
+    qint64(header->charCount) * sizeof(char16_t);
+  if (header->magic != fileMagic || header->version != formatVersion ||
+      std::memcmp(header->stamp, expected, sizeof(expected)) != 0 ||
+      size != expectedSize) {
+    m_file.close();
+    return false;
+  }
+
+  m_header = header;
+  m_terms = reinterpret_cast<const Term*>(data + sizeof(Header));
+  m_occurrences =
+    reinterpret_cast<const quint32*>(m_terms + header->termCount);
+  m_words = m_occurrences + header->wordCount;
+  m_verseStart = m_words + header->wordCount;
+  m_chars = reinterpret_cast<const char16_t*>(m_verseStart +
+                                              header->verseCount + 1);
+  return true;
+}
+
+bool
+Concordance::isOpen() const
+{
+  return m_header != nullptr;
+}
+
+int
+Concordance::termCount() const
+{
+  return m_header ? m_header->termCount : 0;
+}
+
+int
+Concordance::wordCount() const
+{
+  return m_header ? m_header->wordCount : 0;
+}
+
+QList<QPair<QString, int>>
+Concordance::forms(QStringView token, bool prefix) const
+{
+  QList<QPair<QString, int>> result;
+  const QPair<int, int> range = termRange(token, prefix);
+  for (int i = range.first; i < range.second; i++)
+    result.append({ termText(i).toString(), int(m_terms[i].count) });
+  return result;
+}
+
+int
+Concordance::frequency(QStringView token, bool prefix) const
+{
+  int count = 0;
+  const QPair<int, int> range = termRange(token, prefix);
+  for (int i = range.first; i < range.second; i++)
+    count += m_terms[i].count;
+  return count;
+}
+
+QList<Concordance::Occurrence>
+Concordance::occurrences(QStringView token, bool prefix) const
+{
+  QList<quint32> positions;
+  const QPair<int, int> range = termRange(token, prefix);
+  for (int i = range.first; i < range.second; i++) {
+    const quint32* first = m_occurrences + m_terms[i].firstOccurrence;
+    positions.append(first, first + m_terms[i].count);
+  }
+  return toOccurrences(positions);
+}
+
+QList<Concordance::Occurrence>
+Concordance::occurrences(const QStringList& words) const
+{
+  QList<quint32> positions;
+  for (const QString& word : words) {
+    const QPair<int, int> range = termRange(word, false);
+    for (int i = range.first; i < range.second; i++) {
+      const quint32* first = m_occurrences + m_terms[i].firstOccurrence;
+      positions.append(first, first + m_terms[i].count);
+    }
+  }
+  return toOccurrences(positions);
+}
+
+Concordance::Line
+Concordance::context(const Occurrence& occurrence, int width) const
+{
+  Line line;
+  if (!m_header || occurrence.verse < 1 ||
+      occurrence.verse > int(m_header->verseCount))
+    return line;
+
+  const quint32 start = m_verseStart[occurrence.verse - 1];
+  const quint32 end = m_verseStart[occurrence.verse];
+  const quint32 position = start + occurrence.position;
+  if (position >= end)
+    return line;
+
+  QStringList before, after;
+  const quint32 from = std::max<qint64>(start, qint64(position) - width);
+  const quint32 to = std::min<quint32>(end, position + 1 + width);
+  for (quint32 i = from; i < position; i++)
+    before.append(termText(m_words[i]).toString());
+  for (quint32 i = position + 1; i < to; i++)
+    after.append(termText(m_words[i]).toString());
+
+  line.before = before.join(' ');
+  line.keyword = termText(m_words[position]).toString();
+  line.after = after.join(' ');
+  return line;
+}
+
+QList<int>
+Concordance::surahCounts(const QList<Occurrence>& occurrences)
+{
+  QList<int> counts(QuranMetadata::surahTotal, 0);
+  for (const Occurrence& occurrence : occurrences)
+    counts[QuranMetadata::surahOf(occurrence.verse) - 1]++;
+  return counts;
+}
+
+QList<int>
+Concordance::juzCounts(const QList<Occurrence>& occurrences)
+{
+  QList<int> counts(QuranMetadata::juzTotal, 0);
+  for (const Occurrence& occurrence : occurrences)
+    counts[QuranMetadata::juzOf(occurrence.verse) - 1]++;
+  return counts;
+}
+
+QPair<int, int>
+Concordance::termRange(QStringView token, bool prefix) const
+{
+  if (!m_header || token.isEmpty())
+    return { 0, 0 };
+
+  const Term* begin = m_terms;
+  const Term* end = m_terms + m_header->termCount;
+  const auto less = [this](const Term& term, QStringView t) {
+    return termText(&term - m_terms) < t;
+  };
+  const Term* first = std::lower_bound(begin, end, token, less);
+  const Term* last = first;
+  if (prefix) {
+    while (last != end && termText(last - m_terms).startsWith(token))
+      ++last;
+  } else if (last != end && termText(last - m_terms) == token) {
+    ++last;
+  }
+  return { int(first - begin), int(last - begin) };
+}
+
+QStringView
+Concordance::termText(int term) const
+{
+  const Term& entry = m_terms[term];
+  return QStringView(m_chars + entry.textOffset, entry.textLength);
+}
+
+QList<Concordance::Occurrence>
+Concordance::toOccurrences(QList<quint32> positions) const
+{
+  std::sort(positions.begin(), positions.end());
+  QList<Occurrence> result;
+  result.reserve(positions.size());
+  for (quint32 position : positions) {
+    const int verse = verseOf(position);
+    result.append({ verse, int(position - m_verseStart[verse - 1]) });
+  }
+  return result;
+}
+
+int
+Concordance::verseOf(quint32 position) const
+{
+  const quint32* end = m_verseStart + m_header->verseCount + 1;
+  return std::upper_bound(m_verseStart, end, position) - m_verseStart;
+}
@@ -0,0 +1,172 @@
+#ifndef CONCORDANCE_H
+#define CONCORDANCE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+/**
+ * @class Concordance
+ * @brief Word frequencies and occurrences of the whole mushaf, read from a
+ * memory-mapped file.
+ *
+ * The file holds a table of the distinct normalized words sorted for binary
+ * search, each with the number of its occurrences and the offset of its
+ * occurrence array. Occurrences are global word positions, and a word array
+ * of every position plus the first position of each verse give the verse of
+ * an occurrence and the words around it. Lookups only read the mapping, no
+ * data is copied when the file is opened.
+ */
+class Concordance
+{
+public:
+  /**
+   * @brief A single occurrence of a word.
+   */
+  struct Occurrence
+  {
+    int verse;    ///< verse id
+    int position; ///< 0-based position of the word in the verse
+  };
+  /**
+   * @brief Keyword-in-context line of an occurrence.
+   */
+  struct Line
+  {
+    QString before;  ///< words preceding the keyword in the verse
+    QString keyword; ///< the occurring word
+    QString after;   ///< words following the keyword in the verse
+  };
+  Concordance() = default;
+  Concordance(const Concordance&) = delete;
+  Concordance& operator=(const Concordance&) = delete;
+  /**
+   * @brief Writes a concordance file.
+   * @details The verses of each surah are tokenized on the global thread
+   * pool, the results are merged into the sorted word table.
+   * @param texts QList of the verse texts ordered by verse id.
+   * @param path Path of the file to write.
+   * @param stamp Version stamp open() must be given to accept the file.
+   * @return True if the file was written completely.
+   */
+  static bool write(const QStringList& texts,
+                    const QString& path,
+                    const QByteArray& stamp);
+  /**
+   * @brief Maps a concordance file, closing any previously open file.
+   * @param path Path of the file.
+   * @param stamp Expected version stamp.
+   * @return True if the file is valid and its stamp matches.
+   */
+  bool open(const QString& path, const QByteArray& stamp);
+  /**
+   * @brief Check whether a file is mapped.
+   */
+  bool isOpen() const;
+  /**
+   * @brief Gets the number of distinct words.
+   */
+  int termCount() const;
+  /**
+   * @brief Gets the number of words in the mushaf.
+   */
+  int wordCount() const;
+  /**
+   * @brief Gets the distinct words matching a token with their frequencies.
+   * @param token The normalized token to look up.
+   * @param prefix If true, words starting with the token match.
+   * @return QList of QPair of the word and its number of occurrences, in
+   * word order.
+   */
+  QList<QPair<QString, int>> forms(QStringView token, bool prefix) const;
+  /**
+   * @brief Gets the number of occurrences of the words matching a token.
+   * @param token The normalized token to look up.
+   * @param prefix If true, words starting with the token match.
+   */
+  int frequency(QStringView token, bool prefix) const;
+  /**
+   * @brief Gets the occurrences of the words matching a token.
+   * @param token The normalized token to look up.
+   * @param prefix If true, words starting with the token match.
+   * @return QList of Occurrence in mushaf order.
+   */
+  QList<Occurrence> occurrences(QStringView token, bool prefix) const;
+  /**
+   * @brief Gets the occurrences of the given words.
+   * @param words Normalized words, e.g. the forms of a root.
+   * @return QList of Occurrence in mushaf order.
+   */
+  QList<Occurrence> occurrences(const QStringList& words) const;
+  /**
+   * @brief Gets the keyword-in-context line of an occurrence.
+   * @param occurrence The occurrence.
+   * @param width Maximum number of words shown on each side.
+   */
+  Line context(const Occurrence& occurrence, int width) const;
+  /**
+   * @brief Counts occurrences per surah.
+   * @return QList of 114 counts, index i holds surah i + 1.
+   */
+  static QList<int> surahCounts(const QList<Occurrence>& occurrences);
+  /**
+   * @brief Counts occurrences per juz.
+   * @return QList of 30 counts, index i holds juz i + 1.
+   */
+  static QList<int> juzCounts(const QList<Occurrence>& occurrences);
+
+private:
+  /**
+   * @brief File header, followed by the term table, the occurrence array,
+   * the word array, the verse start array and the term characters.
+   */
+  struct Header
+  {
+    quint32 magic;
+    quint32 version;
+    quint32 termCount;
+    quint32 wordCount;
+    quint32 verseCount;
+    quint32 charCount;
+    char stamp[40]; ///< hex SHA-1 of the source, zero padded
+  };
+  /**
+   * @brief Entry of the sorted term table.
+   */
+  struct Term
+  {
+    quint32 textOffset;      ///< offset of the text in the character section
+    quint32 textLength;      ///< length of the text in UTF-16 code units
+    quint32 firstOccurrence; ///< index of the first occurrence of the term
+    quint32 count;           ///< number of occurrences of the term
+  };
+  /**
+   * @brief Gets the range of term indices matching a token.
+   */
+  QPair<int, int> termRange(QStringView token, bool prefix) const;
+  /**
+   * @brief Gets the text of a term.
+   */
+  QStringView termText(int term) const;
+  /**
+   * @brief Converts global word positions to occurrences.
+   */
+  QList<Occurrence> toOccurrences(QList<quint32> positions) const;
+  /**
+   * @brief Gets the verse id of a global word position.
+   */
+  int verseOf(quint32 position) const;
+  QFile m_file;
+  const Header* m_header = nullptr;
+  const Term* m_terms = nullptr;
+  const quint32* m_occurrences = nullptr;
+  const quint32* m_words = nullptr;
+  const quint32* m_verseStart = nullptr;
+  const char16_t* m_chars = nullptr;
+};
+
+#endif // CONCORDANCE_H
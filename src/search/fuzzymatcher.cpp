@@ -0,0 +1,95 @@
+#include "fuzzymatcher.h"
+#include <QVarLengthArray>
+
+FuzzyMatcher::FuzzyMatcher(const QString& pattern)
+  : m_length(pattern.size())
+{
+  m_peq.resize((m_length + 63) / 64);
+  for (auto& masks : m_peq)
+    masks.fill(0);
+
+  for (int i = 0; i < m_length; i++) {
+    const int cls = charClass(pattern.at(i));
+    // characters outside the Arabic block never match, even each other
+    if (cls != alphabetSize - 1)
+      m_peq[i / 64][cls] |= quint64(1) << (i % 64);
+  }
+}
+
+int
+FuzzyMatcher::length() const
+{
+  return m_length;
+}
+
+int
+FuzzyMatcher::charClass(QChar c)
+{
+  const char16_t u = c.unicode();
+  if (u >= 0x0600 && u <= 0x06FF)
+    return u - 0x0600;
+  if (u == ' ')
+    return 256;
+  return alphabetSize - 1;
+}
+
+int
+FuzzyMatcher::distance(const QString& text, int maxDistance) const
+{
+  if (!m_length)
+    return 0;
+
+  struct Block
+  {
+    quint64 pv; ///< positive vertical deltas
+    quint64 mv; ///< negative vertical deltas
+  };
+  const int blockCount = m_peq.size();
+  QVarLengthArray<Block, 8> blocks(blockCount);
+  for (Block& b : blocks)
+    b = { ~quint64(0), 0 };
+
+  // the last row of the last block holds the score of the whole pattern
+  const quint64 lastBit = quint64(1) << ((m_length - 1) % 64);
+  int score = m_length;
+  int best = m_length;
+
+  for (const QChar c : text) {
+    const int cls = charClass(c);
+    // a match may start anywhere in the text, so the top row never changes
+    int hin = 0;
+    for (int i = 0; i < blockCount; i++) {
+      Block& b = blocks[i];
+      quint64 eq = m_peq[i][cls];
+      const quint64 xv = eq | b.mv;
+      if (hin < 0)
+        eq |= 1;
+      const quint64 xh = (((eq & b.pv) + b.pv) ^ b.pv) | eq;
+      quint64 ph = b.mv | ~(xh | b.pv);
+      quint64 mh = b.pv & xh;
+
+      const quint64 high = i == blockCount - 1 ? lastBit : quint64(1) << 63;
+      const int hout = (ph & high) ? 1 : ((mh & high) ? -1 : 0);
+
+      ph <<= 1;
+      mh <<= 1;
+      if (hin < 0)
+        mh |= 1;
+      else if (hin > 0)
+        ph |= 1;
+
+      b.pv = mh | ~(xv | ph);
+      b.mv = ph & xv;
+      hin = hout;
+    }
+
+    score += hin;
+    if (score < best) {
+      best = score;
+      if (!best)
+        break;
+    }
+  }
+
+  return best > maxDistance ? maxDistance + 1 : best;
+}
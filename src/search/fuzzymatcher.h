@@ -0,0 +1,58 @@
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <QList>
+#include <QString>
+#include <array>
+
+/**
+ * @class FuzzyMatcher
+ * @brief Approximate substring matching with Myers' bit-parallel algorithm.
+ *
+ * Computes the smallest edit distance between the pattern and any substring
+ * of a text. Each column of the dynamic programming matrix is encoded as
+ * vertical delta bit vectors of 64 pattern characters per block, so a text
+ * character costs a few word operations per block. Texts are expected to be
+ * normalized with ArabicNormalizer like the pattern.
+ */
+class FuzzyMatcher
+{
+public:
+  /**
+   * @brief Prepares the per-character match masks of the pattern.
+   * @param pattern The normalized pattern.
+   */
+  explicit FuzzyMatcher(const QString& pattern);
+  /**
+   * @brief Gets the pattern length.
+   * @return Number of characters in the pattern.
+   */
+  int length() const;
+  /**
+   * @brief Computes the smallest edit distance between the pattern and a
+   * substring of the text.
+   * @param text The normalized text to search.
+   * @param maxDistance Distances above this value are not distinguished.
+   * @return The edit distance, or maxDistance + 1 if it exceeds maxDistance.
+   */
+  int distance(const QString& text, int maxDistance) const;
+
+private:
+  /**
+   * @brief Number of distinct character classes: the Arabic block, space and
+   * a class for every other character.
+   */
+  static constexpr int alphabetSize = 258;
+  /**
+   * @brief Maps a character to its class in the match masks.
+   */
+  static int charClass(QChar c);
+  /**
+   * @brief Match masks of each 64 character block of the pattern, bit i of
+   * the mask of a class is set if pattern character i is of that class.
+   */
+  QList<std::array<quint64, alphabetSize>> m_peq;
+  int m_length;
+};
+
+#endif // FUZZYMATCHER_H
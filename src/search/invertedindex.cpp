@@ -0,0 +1,146 @@
+#include "invertedindex.h"
+#include <QMap>
+#include <algorithm>
+
+void
+InvertedIndex::build(const QList<QStringList>& documents)
+{
+  // QMap keeps the terms sorted, documents are visited in ascending id order
+  // so each list is sorted and only needs consecutive duplicates dropped
+  QMap<QString, QList<int>> lists;
+  for (int i = 0; i < documents.size(); i++) {
+    const int id = i + 1;
+    for (const QString& token : documents.at(i)) {
+      QList<int>& ids = lists[token];
+      if (ids.isEmpty() || ids.constLast() != id)
+        ids.append(id);
+    }
+  }
+
+  m_terms.clear();
+  m_postings.clear();
+  m_data.clear();
+  m_terms.reserve(lists.size());
+  m_postings.reserve(lists.size());
+  for (auto it = lists.cbegin(); it != lists.cend(); ++it) {
+    m_terms.append(it.key());
+    m_postings.append({ static_cast<quint32>(m_data.size()),
+                        static_cast<quint32>(it.value().size()) });
+    int previous = 0;
+    for (int id : it.value()) {
+      appendVarint(m_data, id - previous);
+      previous = id;
+    }
+  }
+  m_data.squeeze();
+  m_documentCount = documents.size();
+}
+
+int
+InvertedIndex::documentCount() const
+{
+  return m_documentCount;
+}
+
+int
+InvertedIndex::termCount() const
+{
+  return m_terms.size();
+}
+
+qsizetype
+InvertedIndex::postingsSize() const
+{
+  return m_data.size();
+}
+
+QList<int>
+InvertedIndex::postings(const QString& token, MatchMode mode) const
+{
+  QList<int> ids;
+  auto first = std::lower_bound(m_terms.cbegin(), m_terms.cend(), token);
+  switch (mode) {
+    case Exact:
+      if (first != m_terms.cend() && *first == token)
+        decode(first - m_terms.cbegin(), ids);
+      return ids;
+    case Prefix:
+      // terms sharing a prefix are adjacent in the sorted list
+      for (auto it = first; it != m_terms.cend() && it->startsWith(token); ++it)
+        decode(it - m_terms.cbegin(), ids);
+      break;
+    case Suffix:
+    case Contains:
+      for (qsizetype i = 0; i < m_terms.size(); i++) {
+        const QString& term = m_terms.at(i);
+        if (mode == Suffix ? term.endsWith(token) : term.contains(token))
+          decode(i, ids);
+      }
+      break;
+  }
+
+  // lists of several terms were concatenated
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+QList<int>
+InvertedIndex::intersect(const QList<int>& a, const QList<int>& b)
+{
+  const QList<int>& shorter = a.size() <= b.size() ? a : b;
+  const QList<int>& longer = a.size() <= b.size() ? b : a;
+  QList<int> result;
+  result.reserve(shorter.size());
+
+  auto lo = longer.cbegin();
+  const auto end = longer.cend();
+  for (int id : shorter) {
+    // double the step until passing the id, then binary search the last step
+    qsizetype step = 1;
+    auto hi = lo;
+    while (hi != end && *hi < id) {
+      lo = hi + 1;
+      hi = end - hi > step ? hi + step : end;
+      step *= 2;
+    }
+    lo = std::lower_bound(lo, hi, id);
+    if (lo == end)
+      break;
+    if (*lo == id)
+      result.append(id);
+  }
+
+  return result;
+}
+
+void
+InvertedIndex::appendVarint(QByteArray& buffer, quint32 value)
+{
+  while (value >= 0x80) {
+    buffer.append(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  buffer.append(static_cast<char>(value));
+}
+
+void
+InvertedIndex::decode(qsizetype termIdx, QList<int>& ids) const
+{
+  const Posting& posting = m_postings.at(termIdx);
+  const uchar* data =
+    reinterpret_cast<const uchar*>(m_data.constData()) + posting.offset;
+  int id = 0;
+  for (quint32 i = 0; i < posting.count; i++) {
+    quint32 gap = 0;
+    int shift = 0;
+    uchar byte;
+    do {
+      byte = *data++;
+      gap |= quint32(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    id += gap;
+    ids.append(id);
+  }
+}
@@ -0,0 +1,103 @@
+#ifndef INVERTEDINDEX_H
+#define INVERTEDINDEX_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @class InvertedIndex
+ * @brief Compact inverted index of tokens to document id posting lists.
+ *
+ * Terms are kept in a sorted list for binary-searched exact and prefix
+ * lookups. The posting list of each term is stored as variable-length
+ * encoded gaps between ascending document ids in a single shared buffer, and
+ * decoded on lookup.
+ */
+class InvertedIndex
+{
+public:
+  /**
+   * @enum MatchMode
+   * @brief How a query token is matched against the index terms.
+   */
+  enum MatchMode
+  {
+    Exact,   ///< the term equals the token
+    Prefix,  ///< the term starts with the token
+    Suffix,  ///< the term ends with the token
+    Contains ///< the term contains the token
+  };
+  /**
+   * @brief Builds the index, replacing any previous content.
+   * @param documents QList of the tokens of each document, the document at
+   * index i gets the id i + 1.
+   */
+  void build(const QList<QStringList>& documents);
+  /**
+   * @brief Gets the number of indexed documents.
+   * @return Number of documents.
+   */
+  int documentCount() const;
+  /**
+   * @brief Gets the number of distinct indexed terms.
+   * @return Number of terms.
+   */
+  int termCount() const;
+  /**
+   * @brief Gets the size of the encoded posting lists.
+   * @return Size in bytes.
+   */
+  qsizetype postingsSize() const;
+  /**
+   * @brief Gets the ids of the documents containing terms matching a token.
+   * @param token The normalized token to look up.
+   * @param mode The MatchMode used to match terms.
+   * @return Ascending QList of document ids.
+   */
+  QList<int> postings(const QString& token, MatchMode mode = Exact) const;
+  /**
+   * @brief Intersects two ascending lists, galloping through the longer list
+   * for each element of the shorter one.
+   * @param a Ascending QList of ids.
+   * @param b Ascending QList of ids.
+   * @return Ascending QList of the ids found in both lists.
+   */
+  static QList<int> intersect(const QList<int>& a, const QList<int>& b);
+
+private:
+  /**
+   * @brief Location of a term posting list in the encoded buffer.
+   */
+  struct Posting
+  {
+    quint32 offset; ///< offset of the first encoded gap in m_data
+    quint32 count;  ///< number of document ids in the list
+  };
+  /**
+   * @brief Appends the given value to the buffer as a variable-length
+   * integer of 7 bits per byte.
+   */
+  static void appendVarint(QByteArray& buffer, quint32 value);
+  /**
+   * @brief Decodes the posting list of the term at the given index and
+   * appends its ids to the list.
+   */
+  void decode(qsizetype termIdx, QList<int>& ids) const;
+  /**
+   * @brief Sorted list of the distinct terms.
+   */
+  QStringList m_terms;
+  /**
+   * @brief Posting list location of each term, parallel to m_terms.
+   */
+  QList<Posting> m_postings;
+  /**
+   * @brief Encoded posting lists of all terms.
+   */
+  QByteArray m_data;
+  int m_documentCount = 0;
+};
+
+#endif // INVERTEDINDEX_H
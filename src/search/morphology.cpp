@@ -0,0 +1,261 @@
+#include "morphology.h"
+#include <QMap>
+#include <QTextStream>
+#include <algorithm>
+#include <cstring>
+#include <utils/arabicnormalizer.h>
+#include <utils/indexfile.h>
+
+/**
+ * @brief bumped whenever the normalization or the file layout changes
+ */
+static const quint32 formatVersion = 1;
+static const quint32 fileMagic = 0x51434d50; // "QCMP"
+
+bool
+Morphology::write(const QString& datasetPath,
+                  const QStringList& texts,
+                  const QString& path,
+                  const QByteArray& stamp)
+{
+  QFile dataset(datasetPath);
+  if (!dataset.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qWarning() << "Couldn't read morphology dataset" << datasetPath;
+    return false;
+  }
+
+  // the root and lemma of each word, the first line of a word wins
+  QMap<QString, QPair<QString, QString>> words;
+  QTextStream in(&dataset);
+  QString line;
+  while (in.readLineInto(&line)) {
+    if (line.isEmpty() || line.startsWith('#'))
+      continue;
+    const QStringList fields = line.split('\t');
+    const QString word = ArabicNormalizer::normalize(fields.at(0));
+    if (word.isEmpty() || word.contains(' ') || words.contains(word))
+      continue;
+    words.insert(word,
+                 { ArabicNormalizer::normalize(fields.value(1)),
+                   ArabicNormalizer::normalize(fields.value(2)) });
+  }
+
+  // verse postings of every root and lemma, ascending as verses are visited
+  // in order
+  QMap<QString, QList<quint32>> keys[2];
+  for (auto it = words.cbegin(); it != words.cend(); ++it) {
+    if (!it.value().first.isEmpty())
+      keys[Root].insert(it.value().first, {});
+    if (!it.value().second.isEmpty())
+      keys[Lemma].insert(it.value().second, {});
+  }
+  for (int i = 0; i < texts.size(); i++) {
+    const quint32 verse = i + 1;
+    for (const QString& token : ArabicNormalizer::tokens(texts.at(i))) {
+      auto word = words.constFind(token);
+      if (word == words.cend())
+        continue;
+      for (int kind : { Root, Lemma }) {
+        const QString& key =
+          kind == Root ? word.value().first : word.value().second;
+        if (key.isEmpty())
+          continue;
+        QList<quint32>& postings = keys[kind][key];
+        if (postings.isEmpty() || postings.constLast() != verse)
+          postings.append(verse);
+      }
+    }
+  }
+
+  QString chars;
+  QList<Word> wordTable;
+  QList<Key> keyTables[2];
+  QList<quint32> postings;
+  for (int kind : { Root, Lemma }) {
+    for (auto it = keys[kind].cbegin(); it != keys[kind].cend(); ++it) {
+      keyTables[kind].append({ quint32(chars.size()),
+                               quint32(it.key().size()),
+                               quint32(postings.size()),
+                               quint32(it.value().size()) });
+      chars.append(it.key());
+      postings.append(it.value());
+    }
+  }
+  const QStringList keyLists[2] = { keys[Root].keys(), keys[Lemma].keys() };
+  const auto indexOf = [&keyLists](int kind, const QString& key) {
+    if (key.isEmpty())
+      return noKey;
+    const QStringList& list = keyLists[kind];
+    return quint32(std::lower_bound(list.cbegin(), list.cend(), key) -
+                   list.cbegin());
+  };
+  for (auto it = words.cbegin(); it != words.cend(); ++it) {
+    wordTable.append({ quint32(chars.size()),
+                       quint32(it.key().size()),
+                       { indexOf(Root, it.value().first),
+                         indexOf(Lemma, it.value().second) } });
+    chars.append(it.key());
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = fileMagic;
+  header.version = formatVersion;
+  header.wordCount = wordTable.size();
+  header.keyCount[Root] = keyTables[Root].size();
+  header.keyCount[Lemma] = keyTables[Lemma].size();
+  header.postingCount = postings.size();
+  header.charCount = chars.size();
+  std::memcpy(header.stamp,
+              stamp.constData(),
+              std::min<size_t>(stamp.size(), sizeof(header.stamp)));
+
+  return IndexFile::write(path, [&](QIODevice& file) {
+    const auto writeData = [&file](const void* data, qint64 size) {
+      return file.write(static_cast<const char*>(data), size) == size;
+    };
+    return writeData(&header, sizeof(header)) &&
+           writeData(wordTable.constData(), wordTable.size() * sizeof(Word)) &&
+           writeData(keyTables[Root].constData(),
+                     keyTables[Root].size() * sizeof(Key)) &&
+           writeData(keyTables[Lemma].constData(),
+                     keyTables[Lemma].size() * sizeof(Key)) &&
+           writeData(postings.constData(), postings.size() * sizeof(quint32)) &&
+           writeData(chars.constData(), chars.size() * sizeof(QChar));
+  });
+}
+
+bool
+Morphology::open(const QString& path, const QByteArray& stamp)
+{
+  if (m_file.isOpen())
+    m_file.close();
+  m_header = nullptr;
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly))
+    return false;
+
+  const qint64 size = m_file.size();
+  const uchar* data = size >= qint64(sizeof(Header)) ? m_file.map(0, size)
+                                                     : nullptr;
+  if (!data) {
+    m_file.close();
+    return false;
+  }
+
+  const Header* header = reinterpret_cast<const Header*>(data);
+  char expected[sizeof(header->stamp)] = {};
+  std::memcpy(expected,
+              stamp.constData(),
+              std::min<size_t>(stamp.size(), sizeof(expected)));
+  const qint64 expectedSize =
+    sizeof(Header) + qint64(header->wordCount) * sizeof(Word) +
+    (qint64(header->keyCount[Root]) + header->keyCount[Lemma]) * sizeof(Key) +
+    qint64(header->postingCount) * sizeof(quint32) +
+    qint64(header->charCount) * sizeof(char16_t);
+  if (header->magic != fileMagic || header->version != formatVersion ||
+      std::memcmp(header->stamp, expected, sizeof(expected)) != 0 ||
+      size != expectedSize) {
+    m_file.close();
+    return false;
+  }
+
+  m_header = header;
+  m_words = reinterpret_cast<const Word*>(data + sizeof(Header));
+  m_keys[Root] = reinterpret_cast<const Key*>(m_words + header->wordCount);
+  m_keys[Lemma] = m_keys[Root] + header->keyCount[Root];
+  m_postings =
+    reinterpret_cast<const quint32*>(m_keys[Lemma] + header->keyCount[Lemma]);
+  m_chars = reinterpret_cast<const char16_t*>(m_postings +
+                                              header->postingCount);
+  return true;
+}
+
+bool
+Morphology::isOpen() const
+{
+  return m_header != nullptr;
+}
+
+int
+Morphology::keyCount(Kind kind) const
+{
+  return m_header ? m_header->keyCount[kind] : 0;
+}
+
+QString
+Morphology::keyOf(QStringView token, Kind kind) const
+{
+  const int key = keyIndex(token, kind);
+  if (key < 0)
+    return QString();
+  return text(m_keys[kind][key].textOffset, m_keys[kind][key].textLength)
+    .toString();
+}
+
+QList<int>
+Morphology::verses(QStringView token, Kind kind) const
+{
+  const int key = keyIndex(token, kind);
+  if (key < 0)
+    return {};
+
+  const Key& entry = m_keys[kind][key];
+  QList<int> ids;
+  ids.reserve(entry.postingCount);
+  for (quint32 i = 0; i < entry.postingCount; i++)
+    ids.append(m_postings[entry.firstPosting + i]);
+  return ids;
+}
+
+QStringList
+Morphology::forms(QStringView token, Kind kind) const
+{
+  const int key = keyIndex(token, kind);
+  if (key < 0)
+    return {};
+
+  QStringList words;
+  for (quint32 i = 0; i < m_header->wordCount; i++) {
+    if (m_words[i].key[kind] == quint32(key))
+      words.append(
+        text(m_words[i].textOffset, m_words[i].textLength).toString());
+  }
+  return words;
+}
+
+template<typename Entry>
+int
+Morphology::find(const Entry* table, quint32 count, QStringView token) const
+{
+  const Entry* end = table + count;
+  const Entry* found = std::lower_bound(
+    table, end, token, [this](const Entry& entry, QStringView t) {
+      return text(entry.textOffset, entry.textLength) < t;
+    });
+  if (found == end || text(found->textOffset, found->textLength) != token)
+    return -1;
+  return found - table;
+}
+
+int
+Morphology::keyIndex(QStringView token, Kind kind) const
+{
+  if (!m_header || token.isEmpty())
+    return -1;
+
+  const int key = find(m_keys[kind], m_header->keyCount[kind], token);
+  if (key >= 0)
+    return key;
+  const int word = find(m_words, m_header->wordCount, token);
+  if (word < 0 || m_words[word].key[kind] == noKey)
+    return -1;
+  return m_words[word].key[kind];
+}
+
+QStringView
+Morphology::text(quint32 offset, quint32 length) const
+{
+  return QStringView(m_chars + offset, length);
+}
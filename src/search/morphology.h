@@ -0,0 +1,140 @@
+#ifndef MORPHOLOGY_H
+#define MORPHOLOGY_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+/**
+ * @class Morphology
+ * @brief Roots and lemmas of the mushaf words with their verse postings,
+ * read from a memory-mapped file.
+ *
+ * The file is compiled from a tab separated dataset of `word root lemma`
+ * lines (empty fields and `#` comments allowed, Arabic script, normalized
+ * like the verse texts). It holds the sorted table of the dataset words with
+ * the root and lemma of each, and the sorted tables of the roots and lemmas
+ * with the ascending ids of the verses containing any of their words.
+ */
+class Morphology
+{
+public:
+  /**
+   * @brief Kind of the key words are grouped by.
+   */
+  enum Kind
+  {
+    Root, ///< the consonantal root, e.g. امن for يؤمنون
+    Lemma ///< the dictionary form of the word
+  };
+  Morphology() = default;
+  Morphology(const Morphology&) = delete;
+  Morphology& operator=(const Morphology&) = delete;
+  /**
+   * @brief Compiles a dataset into a morphology file.
+   * @param datasetPath Path to the tab separated dataset.
+   * @param texts QList of the verse texts ordered by verse id.
+   * @param path Path of the file to write.
+   * @param stamp Version stamp open() must be given to accept the file.
+   * @return True if the file was written completely.
+   */
+  static bool write(const QString& datasetPath,
+                    const QStringList& texts,
+                    const QString& path,
+                    const QByteArray& stamp);
+  /**
+   * @brief Maps a morphology file, closing any previously open file.
+   * @param path Path of the file.
+   * @param stamp Expected version stamp.
+   * @return True if the file is valid and its stamp matches.
+   */
+  bool open(const QString& path, const QByteArray& stamp);
+  /**
+   * @brief Check whether a file is mapped.
+   */
+  bool isOpen() const;
+  /**
+   * @brief Gets the number of distinct keys of a kind.
+   */
+  int keyCount(Kind kind) const;
+  /**
+   * @brief Resolves a token to a key, a token that is a key itself is kept,
+   * otherwise the key of the word is used.
+   * @param token The normalized token, a word, root or lemma.
+   * @param kind The kind of key.
+   * @return QString of the key, empty if the token is unknown.
+   */
+  QString keyOf(QStringView token, Kind kind) const;
+  /**
+   * @brief Gets the verses containing any word of the key of a token.
+   * @param token The normalized token, resolved through keyOf().
+   * @param kind The kind of key.
+   * @return Ascending QList of verse ids.
+   */
+  QList<int> verses(QStringView token, Kind kind) const;
+  /**
+   * @brief Gets the words sharing the key of a token.
+   * @param token The normalized token, resolved through keyOf().
+   * @param kind The kind of key.
+   * @return QStringList of the words in word order.
+   */
+  QStringList forms(QStringView token, Kind kind) const;
+
+private:
+  /**
+   * @brief File header, followed by the word table, the root table, the
+   * lemma table, the postings and the characters of all texts.
+   */
+  struct Header
+  {
+    quint32 magic;
+    quint32 version;
+    quint32 wordCount;
+    quint32 keyCount[2]; ///< number of roots and lemmas
+    quint32 postingCount;
+    quint32 charCount;
+    char stamp[40]; ///< hex SHA-1 of the sources, zero padded
+  };
+  /**
+   * @brief Entry of the sorted word table.
+   */
+  struct Word
+  {
+    quint32 textOffset; ///< offset of the text in the character section
+    quint32 textLength; ///< length of the text in UTF-16 code units
+    quint32 key[2];     ///< index of the root and lemma, noKey if unknown
+  };
+  /**
+   * @brief Entry of the sorted root and lemma tables.
+   */
+  struct Key
+  {
+    quint32 textOffset;   ///< offset of the text in the character section
+    quint32 textLength;   ///< length of the text in UTF-16 code units
+    quint32 firstPosting; ///< index of the first verse id of the key
+    quint32 postingCount; ///< number of verses of the key
+  };
+  static const quint32 noKey = 0xFFFFFFFF;
+  /**
+   * @brief Binary searches a sorted table of entries with a text.
+   * @return Index of the entry, -1 if not found.
+   */
+  template<typename Entry>
+  int find(const Entry* table, quint32 count, QStringView text) const;
+  /**
+   * @brief Gets the index of the key of a token, -1 if unknown.
+   */
+  int keyIndex(QStringView token, Kind kind) const;
+  QStringView text(quint32 offset, quint32 length) const;
+  QFile m_file;
+  const Header* m_header = nullptr;
+  const Word* m_words = nullptr;
+  const Key* m_keys[2] = { nullptr, nullptr };
+  const quint32* m_postings = nullptr;
+  const char16_t* m_chars = nullptr;
+};
+
+#endif // MORPHOLOGY_H
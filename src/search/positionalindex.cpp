@@ -0,0 +1,170 @@
+#include "positionalindex.h"
+#include <algorithm>
+
+void
+PositionalIndex::build(const QList<QStringList>& verses)
+{
+  QList<QStringList> words;
+  m_verseStart.clear();
+  m_verseStart.reserve(verses.size() + 1);
+  for (const QStringList& tokens : verses) {
+    m_verseStart.append(words.size());
+    for (const QString& token : tokens)
+      words.append(QStringList(token));
+  }
+  m_verseStart.append(words.size());
+  m_averageVerseLength =
+    verses.isEmpty() ? 0 : double(words.size()) / verses.size();
+
+  m_index.build(words);
+}
+
+int
+PositionalIndex::wordCount() const
+{
+  return m_verseStart.isEmpty() ? 0 : m_verseStart.constLast();
+}
+
+int
+PositionalIndex::verseCount() const
+{
+  return std::max<int>(m_verseStart.size() - 1, 0);
+}
+
+int
+PositionalIndex::verseLength(int verse) const
+{
+  return m_verseStart.at(verse) - m_verseStart.at(verse - 1);
+}
+
+double
+PositionalIndex::averageVerseLength() const
+{
+  return m_averageVerseLength;
+}
+
+QHash<int, int>
+PositionalIndex::termFrequencies(const QString& token,
+                                 InvertedIndex::MatchMode mode) const
+{
+  QHash<int, int> frequencies;
+  for (int id : m_index.postings(token, mode))
+    frequencies[verseOf(id - 1)]++;
+  return frequencies;
+}
+
+QList<WordSpan>
+PositionalIndex::phrase(const QStringList& tokens, bool crossVerse) const
+{
+  QList<WordSpan> spans;
+  for (int start : phraseStarts(tokens, crossVerse))
+    spans.append(span(start, tokens.size()));
+  return spans;
+}
+
+QList<WordSpan>
+PositionalIndex::phrase(const QStringList& tokens,
+                        const QList<InvertedIndex::MatchMode>& modes,
+                        bool crossVerse) const
+{
+  QList<WordSpan> spans;
+  for (int start : phraseStarts(tokens, crossVerse, modes))
+    spans.append(span(start, tokens.size()));
+  return spans;
+}
+
+QList<WordSpan>
+PositionalIndex::near(const QStringList& first,
+                      const QStringList& second,
+                      int distance) const
+{
+  const QList<int> firstStarts = phraseStarts(first, false);
+  const QList<int> secondStarts = phraseStarts(second, false);
+  const int firstLength = first.size(), secondLength = second.size();
+
+  QList<WordSpan> spans;
+  auto lo = secondStarts.cbegin();
+  for (int a : firstStarts) {
+    const int aEnd = a + firstLength;
+    // the window slides forward with a, so does its lower end in the list
+    while (lo != secondStarts.cend() && *lo + secondLength + distance < a)
+      ++lo;
+
+    int best = -1, bestGap = distance + 1;
+    for (auto it = lo; it != secondStarts.cend() && *it <= aEnd + distance;
+         ++it) {
+      const int b = *it, bEnd = b + secondLength;
+      // the phrases must not overlap, gaps are counted in words between them
+      const int gap = b >= aEnd ? b - aEnd : a >= bEnd ? a - bEnd : -1;
+      if (gap < 0 || gap >= bestGap || verseOf(a) != verseOf(b))
+        continue;
+      best = b;
+      bestGap = gap;
+    }
+
+    if (best != -1) {
+      const int from = std::min(a, best);
+      const int to = std::max(aEnd, best + secondLength);
+      spans.append(span(from, to - from));
+    }
+  }
+
+  return spans;
+}
+
+QList<int>
+PositionalIndex::phraseStarts(
+  const QStringList& tokens,
+  bool crossVerse,
+  const QList<InvertedIndex::MatchMode>& modes) const
+{
+  if (tokens.isEmpty())
+    return {};
+
+  // a phrase starting at p has its i-th token at p + i, shift each position
+  // list back to the phrase start and intersect them
+  QList<QList<int>> lists;
+  for (int i = 0; i < tokens.size(); i++) {
+    QList<int> starts;
+    const InvertedIndex::MatchMode mode =
+      i < modes.size() ? modes.at(i) : InvertedIndex::Exact;
+    for (int id : m_index.postings(tokens.at(i), mode))
+      if (id - 1 - i >= 0)
+        starts.append(id - 1 - i);
+    if (starts.isEmpty())
+      return {};
+    lists.append(starts);
+  }
+
+  std::sort(lists.begin(),
+            lists.end(),
+            [](const QList<int>& a, const QList<int>& b) {
+              return a.size() < b.size();
+            });
+
+  QList<int> starts = lists.at(0);
+  for (int i = 1; i < lists.size() && !starts.isEmpty(); i++)
+    starts = InvertedIndex::intersect(starts, lists.at(i));
+
+  if (!crossVerse) {
+    const int last = tokens.size() - 1;
+    starts.removeIf(
+      [&](int start) { return verseOf(start) != verseOf(start + last); });
+  }
+  return starts;
+}
+
+int
+PositionalIndex::verseOf(int position) const
+{
+  auto next =
+    std::upper_bound(m_verseStart.cbegin(), m_verseStart.cend(), position);
+  return next - m_verseStart.cbegin();
+}
+
+WordSpan
+PositionalIndex::span(int position, int length) const
+{
+  const int verse = verseOf(position);
+  return { verse, position - m_verseStart.at(verse - 1), length };
+}
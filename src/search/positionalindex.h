@@ -0,0 +1,129 @@
+#ifndef POSITIONALINDEX_H
+#define POSITIONALINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <search/invertedindex.h>
+
+/**
+ * @brief A run of consecutive words in the verse texts.
+ */
+struct WordSpan
+{
+  int verse;  ///< id of the verse the span starts in
+  int offset; ///< offset of the first word in that verse
+  int length; ///< number of words, may run into the following verses
+};
+
+/**
+ * @class PositionalIndex
+ * @brief Inverted index of tokens to their word positions in the verses.
+ *
+ * All verses are indexed as one continuous stream of words in mushaf order,
+ * so a position identifies a verse and a word offset in it, and phrases can
+ * be matched across the end of a verse. Position lists are stored in an
+ * InvertedIndex where each position is a single word document.
+ */
+class PositionalIndex
+{
+public:
+  /**
+   * @brief Builds the index, replacing any previous content.
+   * @param verses QList of the tokens of each verse ordered by verse id.
+   */
+  void build(const QList<QStringList>& verses);
+  /**
+   * @brief Gets the number of indexed words.
+   * @return Number of words in all verses.
+   */
+  int wordCount() const;
+  /**
+   * @brief Gets the number of indexed verses.
+   * @return Number of verses.
+   */
+  int verseCount() const;
+  /**
+   * @brief Gets the number of words in a verse.
+   * @param verse The verse id.
+   * @return Number of words.
+   */
+  int verseLength(int verse) const;
+  /**
+   * @brief Gets the average number of words in a verse, computed when the
+   * index is built.
+   * @return Average verse length in words.
+   */
+  double averageVerseLength() const;
+  /**
+   * @brief Counts the occurrences of terms matching a token in each verse.
+   * @param token The normalized token to look up.
+   * @param mode The MatchMode used to match terms.
+   * @return QHash of the number of occurrences by verse id, holding only
+   * verses where a term matches.
+   */
+  QHash<int, int> termFrequencies(const QString& token,
+                                  InvertedIndex::MatchMode mode) const;
+  /**
+   * @brief Finds the occurrences of an exact phrase of whole words.
+   * @param tokens The normalized tokens of the phrase.
+   * @param crossVerse If true, the phrase may continue into the next verse.
+   * @return QList of the matched spans ordered by position.
+   */
+  QList<WordSpan> phrase(const QStringList& tokens,
+                         bool crossVerse = false) const;
+  /**
+   * @brief Finds the occurrences of a phrase whose words are matched in the
+   * given modes, e.g. a last word matched as a prefix.
+   * @param tokens The normalized tokens of the phrase.
+   * @param modes The MatchMode of each token.
+   * @param crossVerse If true, the phrase may continue into the next verse.
+   * @return QList of the matched spans ordered by position.
+   */
+  QList<WordSpan> phrase(const QStringList& tokens,
+                         const QList<InvertedIndex::MatchMode>& modes,
+                         bool crossVerse = false) const;
+  /**
+   * @brief Finds two phrases occurring within a number of words of each other
+   * in the same verse, in either order.
+   * @param first The normalized tokens of the first phrase.
+   * @param second The normalized tokens of the second phrase.
+   * @param distance Maximum number of words between the phrases.
+   * @return QList of the spans covering both phrases, one for each
+   * occurrence of the first phrase with the closest occurrence of the second.
+   */
+  QList<WordSpan> near(const QStringList& first,
+                       const QStringList& second,
+                       int distance) const;
+
+private:
+  /**
+   * @brief Gets the positions where the phrase starts, tokens are matched
+   * exactly unless their modes are given.
+   */
+  QList<int> phraseStarts(
+    const QStringList& tokens,
+    bool crossVerse,
+    const QList<InvertedIndex::MatchMode>& modes = {}) const;
+  /**
+   * @brief Gets the id of the verse containing the position.
+   */
+  int verseOf(int position) const;
+  /**
+   * @brief Converts a position and a length to a WordSpan.
+   */
+  WordSpan span(int position, int length) const;
+  /**
+   * @brief Word positions of each token, a position p is stored as the
+   * document id p + 1.
+   */
+  InvertedIndex m_index;
+  /**
+   * @brief Position of the first word of each verse, indexed by verse id - 1,
+   * followed by the total word count.
+   */
+  QList<int> m_verseStart;
+  double m_averageVerseLength = 0;
+};
+
+#endif // POSITIONALINDEX_H
@@ -0,0 +1,137 @@
+#include "querycache.h"
+#include <QDataStream>
+#include <algorithm>
+
+/**
+ * @brief bumped whenever the key normalization or the file layout changes
+ */
+static const quint32 formatVersion = 1;
+static const quint32 fileMagic = 0x51435143; // "QCQC"
+
+double
+QueryCache::Statistics::hitRate() const
+{
+  const qint64 lookups = hits + misses;
+  return lookups ? double(hits) / lookups : 0;
+}
+
+QueryCache::QueryCache(int capacity)
+  : m_capacity(std::max(capacity, 1))
+{
+}
+
+std::optional<VerseBitset>
+QueryCache::find(const QString& key)
+{
+  QMutexLocker locker(&m_lock);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end()) {
+    m_misses++;
+    return std::nullopt;
+  }
+
+  m_hits++;
+  it->lastUse = ++m_clock;
+  return VerseBitset::fromCompressed(it->verses);
+}
+
+void
+QueryCache::insert(const QString& key, const VerseBitset& verses)
+{
+  const QByteArray data = verses.compressed();
+  QMutexLocker locker(&m_lock);
+  m_entries.insert(key, { data, ++m_clock });
+  m_modified = true;
+  evict();
+}
+
+void
+QueryCache::evict()
+{
+  if (m_entries.size() <= m_capacity)
+    return;
+
+  // drop down to 7/8 of the capacity at once so insertions into a full cache
+  // don't search for the oldest entry every time
+  QList<quint64> uses;
+  uses.reserve(m_entries.size());
+  for (const Entry& entry : std::as_const(m_entries))
+    uses.append(entry.lastUse);
+  const qsizetype dropped = m_entries.size() - m_capacity * 7 / 8;
+  std::nth_element(uses.begin(), uses.begin() + dropped - 1, uses.end());
+  const quint64 oldest = uses.at(dropped - 1);
+
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    if (it->lastUse <= oldest)
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+bool
+QueryCache::save(QIODevice& device, const QByteArray& stamp)
+{
+  QMutexLocker locker(&m_lock);
+  QList<QPair<quint64, QString>> order;
+  order.reserve(m_entries.size());
+  for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+    order.append({ it->lastUse, it.key() });
+  std::sort(order.begin(), order.end(), std::greater<>());
+
+  QDataStream out(&device);
+  out.setVersion(QDataStream::Qt_6_0);
+  out << fileMagic << formatVersion << stamp << qint32(order.size());
+  for (const auto& entry : order)
+    out << entry.second << m_entries.value(entry.second).verses;
+  if (out.status() != QDataStream::Ok)
+    return false;
+
+  m_modified = false;
+  return true;
+}
+
+bool
+QueryCache::load(QIODevice& device, const QByteArray& stamp)
+{
+  QDataStream in(&device);
+  in.setVersion(QDataStream::Qt_6_0);
+  quint32 magic = 0, version = 0;
+  QByteArray fileStamp;
+  qint32 count = 0;
+  in >> magic >> version >> fileStamp >> count;
+  if (in.status() != QDataStream::Ok || magic != fileMagic ||
+      version != formatVersion || fileStamp != stamp || count < 0)
+    return false;
+
+  // saved most recently used first, the recency order is kept
+  QHash<QString, Entry> entries;
+  for (qint32 i = 0; i < count && entries.size() < m_capacity; i++) {
+    QString key;
+    QByteArray verses;
+    in >> key >> verses;
+    entries.insert(key, { verses, quint64(count - i) });
+  }
+  if (in.status() != QDataStream::Ok)
+    return false;
+
+  QMutexLocker locker(&m_lock);
+  m_entries = entries;
+  m_clock = count;
+  m_modified = false;
+  return true;
+}
+
+bool
+QueryCache::isModified() const
+{
+  QMutexLocker locker(&m_lock);
+  return m_modified;
+}
+
+QueryCache::Statistics
+QueryCache::statistics() const
+{
+  QMutexLocker locker(&m_lock);
+  return { m_hits, m_misses, int(m_entries.size()) };
+}
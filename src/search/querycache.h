@@ -0,0 +1,104 @@
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QString>
+#include <optional>
+#include <search/versebitset.h>
+
+/**
+ * @class QueryCache
+ * @brief Least recently used cache of search results.
+ *
+ * Maps a normalized search key (the searched phrase and the options that
+ * change its matches) to the matching verses, stored as compressed
+ * VerseBitset data. The cache can be saved to and loaded from a device with
+ * a version stamp of the searched content, and counts its hits and misses.
+ * All methods are thread safe.
+ */
+class QueryCache
+{
+public:
+  /**
+   * @brief Lookup counters of the cache.
+   */
+  struct Statistics
+  {
+    qint64 hits;   ///< number of lookups answered from the cache
+    qint64 misses; ///< number of lookups not found in the cache
+    int entries;   ///< number of cached results
+    /**
+     * @brief Fraction of the lookups answered from the cache.
+     */
+    double hitRate() const;
+  };
+  /**
+   * @brief Default maximum number of cached results.
+   */
+  static const int defaultCapacity = 512;
+  /**
+   * @brief Creates an empty cache.
+   * @param capacity Maximum number of cached results, the least recently used
+   * result is dropped when exceeded.
+   */
+  explicit QueryCache(int capacity = defaultCapacity);
+  /**
+   * @brief Looks up the result of a search key.
+   * @param key The normalized search key.
+   * @return The cached verses, std::nullopt if the key isn't cached.
+   */
+  std::optional<VerseBitset> find(const QString& key);
+  /**
+   * @brief Caches the result of a search key.
+   * @param key The normalized search key.
+   * @param verses The verses matching the key.
+   */
+  void insert(const QString& key, const VerseBitset& verses);
+  /**
+   * @brief Writes the cached results, most recently used first.
+   * @param device Device open for writing.
+   * @param stamp Version stamp load() must be given to accept the data.
+   * @return True if the cache was written completely.
+   */
+  bool save(QIODevice& device, const QByteArray& stamp);
+  /**
+   * @brief Reads results written by save(), replacing the cached ones.
+   * @param device Device open for reading.
+   * @param stamp Expected version stamp.
+   * @return True if the data is valid and its stamp matches.
+   */
+  bool load(QIODevice& device, const QByteArray& stamp);
+  /**
+   * @brief Check whether results were cached since the last save() or
+   * load().
+   */
+  bool isModified() const;
+  Statistics statistics() const;
+
+private:
+  struct Entry
+  {
+    QByteArray verses; ///< VerseBitset::compressed() data
+    quint64 lastUse;   ///< value of m_clock when last looked up or inserted
+  };
+  /**
+   * @brief Drops the least recently used entries beyond the capacity.
+   */
+  void evict();
+  const int m_capacity;
+  QHash<QString, Entry> m_entries;
+  /**
+   * @brief Incremented on every lookup and insertion, orders the entries by
+   * recency.
+   */
+  quint64 m_clock = 0;
+  qint64 m_hits = 0;
+  qint64 m_misses = 0;
+  bool m_modified = false;
+  mutable QMutex m_lock;
+};
+
+#endif // QUERYCACHE_H
@@ -0,0 +1,334 @@
+#include "searchquery.h"
+
+SearchQuery::SearchQuery(const QString& query)
+{
+  tokenize(query);
+  if (m_error.isEmpty() && m_tokens.isEmpty())
+    m_error = tr("Empty query");
+  if (!m_error.isEmpty())
+    return;
+
+  m_root = parseOr();
+  if (m_error.isEmpty() && m_pos < m_tokens.size())
+    m_error = tr("Unexpected '%0'").arg(m_tokens.at(m_pos).text);
+  if (!m_error.isEmpty())
+    m_root = -1;
+}
+
+bool
+SearchQuery::isValid() const
+{
+  return m_root != -1;
+}
+
+const QString&
+SearchQuery::error() const
+{
+  return m_error;
+}
+
+QStringList
+SearchQuery::phrases() const
+{
+  QStringList result;
+  for (const Node& node : m_nodes)
+    if (node.kind == Node::Term)
+      result.append(node.text);
+  return result;
+}
+
+QStringList
+SearchQuery::positivePhrases() const
+{
+  QStringList result;
+  if (isValid())
+    collectPhrases(m_root, false, result);
+  return result;
+}
+
+bool
+SearchQuery::isPhrase() const
+{
+  return isValid() && m_nodes.at(m_root).kind == Node::Term;
+}
+
+VerseBitset
+SearchQuery::evaluate(const TermMatcher& matcher,
+                      int qcfVersion,
+                      const NearMatcher& nearMatcher) const
+{
+  if (!isValid())
+    return VerseBitset();
+  return evaluate(m_root, matcher, qcfVersion, nearMatcher);
+}
+
+void
+SearchQuery::tokenize(const QString& query)
+{
+  const auto isDelimiter = [](QChar c) {
+    return c.isSpace() || c == '(' || c == ')' || c == '"';
+  };
+
+  qsizetype i = 0;
+  while (i < query.size()) {
+    const QChar c = query.at(i);
+    if (c.isSpace()) {
+      i++;
+    } else if (c == '(' || c == ')') {
+      m_tokens.append({ c == '(' ? Token::Open : Token::Close, c });
+      i++;
+    } else if (c == '"') {
+      qsizetype end = query.indexOf('"', i + 1);
+      if (end == -1) {
+        m_error = tr("Unterminated quote");
+        return;
+      }
+      const QString phrase = query.mid(i + 1, end - i - 1).simplified();
+      if (!phrase.isEmpty())
+        m_tokens.append({ Token::Phrase, phrase });
+      i = end + 1;
+    } else {
+      qsizetype end = i;
+      while (end < query.size() && !isDelimiter(query.at(end)))
+        end++;
+      const QString word = query.mid(i, end - i);
+      const QString upper = word.toUpper();
+      if (upper == "AND")
+        m_tokens.append({ Token::And, word });
+      else if (upper == "OR")
+        m_tokens.append({ Token::Or, word });
+      else if (upper == "NOT")
+        m_tokens.append({ Token::Not, word });
+      else if (upper == "NEAR" || upper.startsWith("NEAR/"))
+        m_tokens.append({ Token::Near, word });
+      else if (word.contains(':'))
+        m_tokens.append({ Token::Filter, word });
+      else
+        m_tokens.append({ Token::Word, word });
+      i = end;
+    }
+  }
+}
+
+int
+SearchQuery::parseOr()
+{
+  int left = parseAnd();
+  while (m_error.isEmpty() && m_pos < m_tokens.size() &&
+         m_tokens.at(m_pos).kind == Token::Or) {
+    m_pos++;
+    int right = parseAnd();
+    left = addNode({ Node::Or, QString(), 0, 0, left, right });
+  }
+  return left;
+}
+
+int
+SearchQuery::parseAnd()
+{
+  int left = parseUnary();
+  while (m_error.isEmpty() && m_pos < m_tokens.size()) {
+    const Token::Kind kind = m_tokens.at(m_pos).kind;
+    if (kind == Token::Or || kind == Token::Close)
+      break;
+    // adjacent terms are implicitly ANDed
+    if (kind == Token::And)
+      m_pos++;
+    int right = parseUnary();
+    left = addNode({ Node::And, QString(), 0, 0, left, right });
+  }
+  return left;
+}
+
+int
+SearchQuery::parseUnary()
+{
+  if (m_pos < m_tokens.size() && m_tokens.at(m_pos).kind == Token::Not) {
+    m_pos++;
+    int operand = parseUnary();
+    return addNode({ Node::Not, QString(), 0, 0, operand });
+  }
+  return parseNear();
+}
+
+int
+SearchQuery::parseNear()
+{
+  int left = parsePrimary();
+  if (!m_error.isEmpty() || m_pos >= m_tokens.size() ||
+      m_tokens.at(m_pos).kind != Token::Near)
+    return left;
+
+  const QString op = m_tokens.at(m_pos++).text;
+  bool ok = true;
+  const int distance = op.contains('/') ? op.section('/', 1).toInt(&ok) : 5;
+  if (!ok || distance < 0) {
+    m_error = tr("Invalid distance in '%0'").arg(op);
+    return -1;
+  }
+
+  int right = parsePrimary();
+  if (!m_error.isEmpty())
+    return -1;
+  if (m_nodes.at(left).kind != Node::Term ||
+      m_nodes.at(right).kind != Node::Term) {
+    m_error = tr("'%0' must be between two phrases").arg(op);
+    return -1;
+  }
+  return addNode({ Node::Near, QString(), distance, 0, left, right });
+}
+
+int
+SearchQuery::parsePrimary()
+{
+  if (!m_error.isEmpty())
+    return -1;
+  if (m_pos >= m_tokens.size()) {
+    m_error = tr("Incomplete query");
+    return -1;
+  }
+
+  const Token& token = m_tokens.at(m_pos++);
+  switch (token.kind) {
+    case Token::Open: {
+      int inner = parseOr();
+      if (m_error.isEmpty() && (m_pos >= m_tokens.size() ||
+                                m_tokens.at(m_pos).kind != Token::Close))
+        m_error = tr("Missing ')'");
+      m_pos++;
+      return inner;
+    }
+    case Token::Phrase:
+      return addNode({ Node::Term, token.text });
+    case Token::Filter:
+      return parseFilter(token.text);
+    case Token::Word: {
+      // consecutive words form a single phrase
+      QStringList words(token.text);
+      while (m_pos < m_tokens.size() && m_tokens.at(m_pos).kind == Token::Word)
+        words.append(m_tokens.at(m_pos++).text);
+      return addNode({ Node::Term, words.join(' ') });
+    }
+    default:
+      m_error = tr("Unexpected '%0'").arg(token.text);
+      return -1;
+  }
+}
+
+int
+SearchQuery::parseFilter(const QString& filter)
+{
+  const QString name = filter.section(':', 0, 0).toLower();
+  const QString value = filter.section(':', 1);
+
+  Node node{ Node::Term };
+  int max = 0;
+  if (name == "surah") {
+    node.kind = Node::Surah;
+    max = QuranMetadata::surahTotal;
+  } else if (name == "juz") {
+    node.kind = Node::Juz;
+    max = QuranMetadata::juzTotal;
+  } else if (name == "page") {
+    node.kind = Node::Page;
+    max = QuranMetadata::pageTotal;
+  } else {
+    m_error = tr("Unknown filter '%0'").arg(name);
+    return -1;
+  }
+
+  bool fromOk = false, toOk = false;
+  const QStringList bounds = value.split('-');
+  node.from = bounds.first().toInt(&fromOk);
+  node.to = bounds.size() == 2 ? bounds.last().toInt(&toOk) : node.from;
+  if (bounds.size() == 1)
+    toOk = fromOk;
+
+  if (bounds.size() > 2 || !fromOk || !toOk || node.from < 1 ||
+      node.to > max || node.from > node.to) {
+    m_error = tr("Invalid filter '%0'").arg(filter);
+    return -1;
+  }
+
+  return addNode(node);
+}
+
+int
+SearchQuery::addNode(const Node& node)
+{
+  if (!m_error.isEmpty())
+    return -1;
+  m_nodes.append(node);
+  return m_nodes.size() - 1;
+}
+
+void
+SearchQuery::collectPhrases(int node, bool negated, QStringList& phrases) const
+{
+  const Node& n = m_nodes.at(node);
+  switch (n.kind) {
+    case Node::Term:
+      if (!negated)
+        phrases.append(n.text);
+      break;
+    case Node::Not:
+      collectPhrases(n.left, !negated, phrases);
+      break;
+    case Node::Near:
+    case Node::Or:
+    case Node::And:
+      collectPhrases(n.left, negated, phrases);
+      collectPhrases(n.right, negated, phrases);
+      break;
+    default:
+      break;
+  }
+}
+
+VerseBitset
+SearchQuery::evaluate(int node,
+                      const TermMatcher& matcher,
+                      int qcfVersion,
+                      const NearMatcher& nearMatcher) const
+{
+  const Node& n = m_nodes.at(node);
+  switch (n.kind) {
+    case Node::Term:
+      return matcher(n.text);
+    case Node::Surah:
+      return VerseBitset::surahs(n.from, n.to);
+    case Node::Juz:
+      return VerseBitset::juzs(n.from, n.to);
+    case Node::Page:
+      return VerseBitset::pages(n.from, n.to, qcfVersion);
+    case Node::Near: {
+      const QString& first = m_nodes.at(n.left).text;
+      const QString& second = m_nodes.at(n.right).text;
+      if (nearMatcher)
+        return nearMatcher(first, second, n.from);
+      VerseBitset result = matcher(first);
+      result &= matcher(second);
+      return result;
+    }
+    case Node::Not:
+      return ~evaluate(n.left, matcher, qcfVersion, nearMatcher);
+    case Node::Or: {
+      VerseBitset result = evaluate(n.left, matcher, qcfVersion, nearMatcher);
+      result |= evaluate(n.right, matcher, qcfVersion, nearMatcher);
+      return result;
+    }
+    case Node::And: {
+      VerseBitset result = evaluate(n.left, matcher, qcfVersion, nearMatcher);
+      if (result.isEmpty())
+        return result;
+      // "a NOT b" removes b directly instead of complementing it first
+      const Node& right = m_nodes.at(n.right);
+      if (right.kind == Node::Not)
+        result.andNot(evaluate(right.left, matcher, qcfVersion, nearMatcher));
+      else
+        result &= evaluate(n.right, matcher, qcfVersion, nearMatcher);
+      return result;
+    }
+  }
+  return VerseBitset();
+}
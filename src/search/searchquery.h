@@ -0,0 +1,144 @@
+#ifndef SEARCHQUERY_H
+#define SEARCHQUERY_H
+
+#include <QCoreApplication>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <search/versebitset.h>
+
+/**
+ * @class SearchQuery
+ * @brief Parsed verse search query.
+ *
+ * The query language supports:
+ * - words, consecutive words are searched as a single phrase
+ * - quoted phrases ("...")
+ * - AND, OR and NOT operators and parentheses, adjacent terms are ANDed and
+ * NOT binds tighter than AND which binds tighter than OR
+ * - a NEAR/N b, matching phrases a and b within N words of each other in the
+ * same verse (5 words if N is omitted), binding tighter than NOT
+ * - surah:N, juz:N and page:N filters, each accepting a range as N-M
+ *
+ * Terms and filters evaluate to a VerseBitset, operators are applied as
+ * word-wide set operations.
+ */
+class SearchQuery
+{
+  Q_DECLARE_TR_FUNCTIONS(SearchQuery)
+
+public:
+  /**
+   * @brief Callback returning the verses matching a search phrase.
+   */
+  using TermMatcher = std::function<VerseBitset(const QString& phrase)>;
+  /**
+   * @brief Callback returning the verses where two phrases occur within a
+   * number of words of each other.
+   */
+  using NearMatcher = std::function<
+    VerseBitset(const QString& first, const QString& second, int distance)>;
+  /**
+   * @brief Parses the given query.
+   * @param query The query text entered by the user.
+   */
+  explicit SearchQuery(const QString& query);
+  /**
+   * @brief Check whether the query was parsed successfully.
+   * @return True if the query is valid.
+   */
+  bool isValid() const;
+  /**
+   * @brief Get the parsing error of an invalid query.
+   * @return QString describing the error.
+   */
+  const QString& error() const;
+  /**
+   * @brief Get the phrases searched by the query.
+   * @return QStringList of the phrases in the order they appear.
+   */
+  QStringList phrases() const;
+  /**
+   * @brief Get the phrases a matching verse contains, phrases excluded by
+   * NOT are left out.
+   * @return QStringList of the phrases in the order they appear.
+   */
+  QStringList positivePhrases() const;
+  /**
+   * @brief Check whether the query is a single phrase without operators or
+   * filters.
+   * @return True if the query is a plain phrase.
+   */
+  bool isPhrase() const;
+  /**
+   * @brief Evaluates the query.
+   * @param matcher Callback returning the verses matching each phrase.
+   * @param qcfVersion The QCF version page filters refer to.
+   * @param nearMatcher Callback answering NEAR operators, if empty they are
+   * evaluated as AND.
+   * @return VerseBitset of the matching verses, empty if the query is invalid.
+   */
+  VerseBitset evaluate(const TermMatcher& matcher,
+                       int qcfVersion,
+                       const NearMatcher& nearMatcher = nullptr) const;
+
+private:
+  struct Token
+  {
+    enum Kind
+    {
+      Word,
+      Phrase,
+      Filter,
+      And,
+      Or,
+      Not,
+      Near,
+      Open,
+      Close
+    };
+    Kind kind;
+    QString text;
+  };
+  struct Node
+  {
+    enum Kind
+    {
+      Term,
+      Surah,
+      Juz,
+      Page,
+      And,
+      Or,
+      Not,
+      Near
+    };
+    Kind kind;
+    QString text; ///< searched phrase of Term nodes
+    int from = 0; ///< first value of filter nodes, distance of Near nodes
+    int to = 0;   ///< last value of filter nodes
+    int left = -1;
+    int right = -1;
+  };
+  void tokenize(const QString& query);
+  int parseOr();
+  int parseAnd();
+  int parseUnary();
+  int parseNear();
+  int parsePrimary();
+  int parseFilter(const QString& filter);
+  int addNode(const Node& node);
+  void collectPhrases(int node, bool negated, QStringList& phrases) const;
+  VerseBitset evaluate(int node,
+                       const TermMatcher& matcher,
+                       int qcfVersion,
+                       const NearMatcher& nearMatcher) const;
+  QList<Token> m_tokens;
+  qsizetype m_pos = 0;
+  QList<Node> m_nodes;
+  int m_root = -1;
+  QString m_error;
+};
+
+#endif // SEARCHQUERY_H
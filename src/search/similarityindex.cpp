@@ -0,0 +1,264 @@
+#include "similarityindex.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+#include <utils/arabicnormalizer.h>
+#include <utils/indexfile.h>
+
+/**
+ * @brief bumped whenever the shingling, hashing or file layout changes
+ */
+static const quint32 formatVersion = 1;
+static const quint32 fileMagic = 0x51435349; // "QCSI"
+
+static const quint64 fnvOffset = 14695981039346656037ULL;
+static const quint64 fnvPrime = 1099511628211ULL;
+
+/**
+ * @brief 64-bit FNV-1a over the given bytes, stable across runs and Qt
+ * versions unlike qHash
+ */
+static quint64
+fnv1a(quint64 hash, const void* data, qsizetype size)
+{
+  const uchar* bytes = static_cast<const uchar*>(data);
+  for (qsizetype i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= fnvPrime;
+  }
+  return hash;
+}
+
+/**
+ * @brief splitmix64 finalizer, derives the independent MinHash functions
+ * from a single shingle hash
+ */
+static quint64
+mix(quint64 x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+bool
+SimilarityIndex::build(const QStringList& texts,
+                       const std::atomic_bool* cancelled)
+{
+  const int count = texts.size();
+  m_shingles = QList<QList<quint64>>(count);
+  m_signatures = QList<quint32>(qsizetype(count) * signatureSize);
+
+  // every verse writes its own slots, the lists are not resized while mapped
+  QList<quint64>* shingleData = m_shingles.data();
+  quint32* signatureData = m_signatures.data();
+  QList<int> verses(count);
+  std::iota(verses.begin(), verses.end(), 0);
+  QtConcurrent::blockingMap(verses, [&](int i) {
+    if (cancelled && *cancelled)
+      return;
+    shingleData[i] = shingles(texts.at(i));
+    quint32* signature = signatureData + qsizetype(i) * signatureSize;
+    std::fill(signature, signature + signatureSize, UINT32_MAX);
+    for (quint64 shingle : shingleData[i]) {
+      for (int h = 0; h < signatureSize; h++) {
+        const quint32 value = quint32(mix(shingle ^ mix(h)));
+        signature[h] = std::min(signature[h], value);
+      }
+    }
+  });
+  if (cancelled && *cancelled)
+    return false;
+
+  buildBuckets();
+  return true;
+}
+
+bool
+SimilarityIndex::save(QIODevice& device, const QByteArray& stamp) const
+{
+  QDataStream out(&device);
+  out.setVersion(QDataStream::Qt_6_0);
+  out << fileMagic << formatVersion << stamp << qint32(m_shingles.size());
+  for (const QList<quint64>& shingles : m_shingles)
+    out << shingles;
+  out << m_signatures;
+  return out.status() == QDataStream::Ok;
+}
+
+bool
+SimilarityIndex::load(QIODevice& device, const QByteArray& stamp)
+{
+  QDataStream in(&device);
+  in.setVersion(QDataStream::Qt_6_0);
+  quint32 magic = 0, version = 0;
+  QByteArray fileStamp;
+  qint32 count = 0;
+  in >> magic >> version >> fileStamp >> count;
+  if (in.status() != QDataStream::Ok || magic != fileMagic ||
+      version != formatVersion || fileStamp != stamp || count < 0)
+    return false;
+
+  QList<QList<quint64>> shingles(count);
+  for (QList<quint64>& verseShingles : shingles)
+    in >> verseShingles;
+  QList<quint32> signatures;
+  in >> signatures;
+  if (in.status() != QDataStream::Ok ||
+      signatures.size() != qsizetype(count) * signatureSize)
+    return false;
+
+  m_shingles = shingles;
+  m_signatures = signatures;
+  buildBuckets();
+  return true;
+}
+
+std::optional<SimilarityIndex>
+SimilarityIndex::cached(const QStringList& texts,
+                        const QString& path,
+                        const std::atomic_bool* cancelled)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  for (const QString& text : texts)
+    hash.addData(text.toUtf8().append('\n'));
+  const QByteArray stamp = hash.result().toHex();
+
+  SimilarityIndex index;
+  QFile file(path);
+  if (file.open(QIODevice::ReadOnly) && index.load(file, stamp))
+    return index;
+  file.close();
+
+  if (!index.build(texts, cancelled))
+    return std::nullopt;
+  if (!IndexFile::write(path, [&index, &stamp](QIODevice& part) {
+        return index.save(part, stamp);
+      }))
+    qWarning() << "Couldn't write similarity cache" << path;
+  return index;
+}
+
+int
+SimilarityIndex::verseCount() const
+{
+  return m_shingles.size();
+}
+
+QList<SimilarityIndex::Match>
+SimilarityIndex::similar(int verse, int limit, double threshold) const
+{
+  if (verse < 1 || verse > m_shingles.size() || limit <= 0)
+    return {};
+
+  QList<int> candidates;
+  for (int band = 0; band < signatureSize / bandRows; band++) {
+    auto bucket = m_buckets.constFind(bandKey(verse, band));
+    if (bucket != m_buckets.cend())
+      candidates.append(bucket.value());
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+
+  // band collisions only estimate the similarity, the shingle sets decide
+  QList<Match> matches;
+  for (int candidate : candidates) {
+    if (candidate == verse)
+      continue;
+    const double score = jaccard(verse, candidate);
+    if (score >= threshold)
+      matches.append({ candidate, score });
+  }
+
+  const auto better = [](const Match& a, const Match& b) {
+    return a.score > b.score || (a.score == b.score && a.verse < b.verse);
+  };
+  if (matches.size() > limit) {
+    std::partial_sort(
+      matches.begin(), matches.begin() + limit, matches.end(), better);
+    matches.resize(limit);
+  } else {
+    std::sort(matches.begin(), matches.end(), better);
+  }
+  return matches;
+}
+
+double
+SimilarityIndex::jaccard(int first, int second) const
+{
+  const QList<quint64>& a = m_shingles.at(first - 1);
+  const QList<quint64>& b = m_shingles.at(second - 1);
+  if (a.isEmpty() && b.isEmpty())
+    return 0;
+
+  qsizetype common = 0;
+  for (auto i = a.cbegin(), j = b.cbegin(); i != a.cend() && j != b.cend();) {
+    if (*i < *j) {
+      ++i;
+    } else if (*j < *i) {
+      ++j;
+    } else {
+      common++;
+      ++i;
+      ++j;
+    }
+  }
+  return double(common) / double(a.size() + b.size() - common);
+}
+
+QList<quint64>
+SimilarityIndex::shingles(const QString& text)
+{
+  const QStringList tokens = ArabicNormalizer::tokens(text);
+  QList<quint64> hashes;
+  // single word verses are represented by the word itself
+  const int width = std::min<int>(2, tokens.size());
+  for (int i = 0; width && i + width <= tokens.size(); i++) {
+    quint64 hash = fnvOffset;
+    for (int w = 0; w < width; w++) {
+      const QString& token = tokens.at(i + w);
+      hash = fnv1a(hash, token.constData(), token.size() * sizeof(QChar));
+      hash = fnv1a(hash, " ", 1);
+    }
+    hashes.append(hash);
+  }
+
+  std::sort(hashes.begin(), hashes.end());
+  hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  return hashes;
+}
+
+void
+SimilarityIndex::buildBuckets()
+{
+  m_buckets.clear();
+  for (int verse = 1; verse <= m_shingles.size(); verse++) {
+    if (m_shingles.at(verse - 1).isEmpty())
+      continue;
+    for (int band = 0; band < signatureSize / bandRows; band++)
+      m_buckets[bandKey(verse, band)].append(verse);
+  }
+
+  // a bucket holding a single verse never yields a candidate
+  for (auto it = m_buckets.begin(); it != m_buckets.end();) {
+    if (it.value().size() < 2)
+      it = m_buckets.erase(it);
+    else
+      ++it;
+  }
+}
+
+quint64
+SimilarityIndex::bandKey(int verse, int band) const
+{
+  const quint32* values =
+    m_signatures.constData() + qsizetype(verse - 1) * signatureSize +
+    band * bandRows;
+  quint64 key = fnv1a(fnvOffset, &band, sizeof(band));
+  return fnv1a(key, values, bandRows * sizeof(quint32));
+}
@@ -0,0 +1,132 @@
+#ifndef SIMILARITYINDEX_H
+#define SIMILARITYINDEX_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <optional>
+
+/**
+ * @class SimilarityIndex
+ * @brief MinHash/LSH index of verses whose wording is nearly the same.
+ *
+ * The normalized text of each verse is split into word bigram shingles and
+ * summarized by a MinHash signature. Signatures are cut into bands hashed
+ * into buckets, verses sharing a bucket in any band are candidates, and the
+ * candidates are re-scored by the exact Jaccard similarity of their shingle
+ * sets. Signatures are computed in parallel and the index can be saved to and
+ * loaded from a cache file.
+ */
+class SimilarityIndex
+{
+public:
+  /**
+   * @brief A verse similar to the queried one.
+   */
+  struct Match
+  {
+    int verse;    ///< verse id
+    double score; ///< Jaccard similarity of the verse shingles
+  };
+  /**
+   * @brief Number of MinHash values per verse.
+   */
+  static const int signatureSize = 64;
+  /**
+   * @brief Number of values per LSH band, verses sharing all the values of a
+   * band are candidates. Two rows per band keep verses of a Jaccard
+   * similarity of 0.3 as candidates with a probability of about 95%.
+   */
+  static const int bandRows = 2;
+  /**
+   * @brief Default minimum Jaccard similarity of returned matches.
+   */
+  static constexpr double defaultThreshold = 0.3;
+  /**
+   * @brief Builds the index, replacing any previous content.
+   * @param texts QList of the verse texts ordered by verse id.
+   * @param cancelled Optional flag stopping the build once set, the index is
+   * left incomplete.
+   * @return True if the index was built completely.
+   */
+  bool build(const QStringList& texts,
+             const std::atomic_bool* cancelled = nullptr);
+  /**
+   * @brief Writes the index to a device.
+   * @param device Device open for writing.
+   * @param stamp Version stamp load() must be given to accept the data.
+   * @return True if the index was written completely.
+   */
+  bool save(QIODevice& device, const QByteArray& stamp) const;
+  /**
+   * @brief Reads an index written by save(), replacing any previous content.
+   * @param device Device open for reading.
+   * @param stamp Expected version stamp.
+   * @return True if the data was read and its stamp matches.
+   */
+  bool load(QIODevice& device, const QByteArray& stamp);
+  /**
+   * @brief Loads the index from a cache file, or builds it and writes the
+   * cache file if the file is missing or was built from other texts.
+   * @param texts QList of the verse texts ordered by verse id.
+   * @param path Path to the cache file.
+   * @param cancelled Optional flag stopping a build once set, the cache file
+   * isn't written then.
+   * @return The loaded or built index, std::nullopt if the build was
+   * cancelled.
+   */
+  static std::optional<SimilarityIndex> cached(
+    const QStringList& texts,
+    const QString& path,
+    const std::atomic_bool* cancelled = nullptr);
+  /**
+   * @brief Gets the number of indexed verses.
+   */
+  int verseCount() const;
+  /**
+   * @brief Finds the verses most similar to a verse.
+   * @param verse Id of the verse to find similar verses for.
+   * @param limit Maximum number of returned matches.
+   * @param threshold Minimum Jaccard similarity of returned matches.
+   * @return QList of Match ordered by descending score, then verse id.
+   */
+  QList<Match> similar(int verse,
+                       int limit,
+                       double threshold = defaultThreshold) const;
+  /**
+   * @brief Computes the exact Jaccard similarity of two verses.
+   */
+  double jaccard(int first, int second) const;
+
+private:
+  /**
+   * @brief Gets the sorted distinct shingle hashes of a verse text.
+   */
+  static QList<quint64> shingles(const QString& text);
+  /**
+   * @brief Hashes the signature values of every band into m_buckets.
+   */
+  void buildBuckets();
+  /**
+   * @brief Gets the bucket key of a band of a verse signature.
+   */
+  quint64 bandKey(int verse, int band) const;
+  /**
+   * @brief Shingle hashes of each verse, indexed by verse id - 1.
+   */
+  QList<QList<quint64>> m_shingles;
+  /**
+   * @brief Signatures of all verses, signatureSize values per verse.
+   */
+  QList<quint32> m_signatures;
+  /**
+   * @brief Verse ids by band key, ascending in each bucket.
+   */
+  QHash<quint64, QList<int>> m_buckets;
+};
+
+#endif // SIMILARITYINDEX_H
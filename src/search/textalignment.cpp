@@ -0,0 +1,161 @@
+#include "textalignment.h"
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+#include <utils/arabicnormalizer.h>
+
+/**
+ * @brief start and length of the whitespace separated words of a text
+ */
+static QList<QPair<int, int>>
+wordRanges(const QString& text)
+{
+  QList<QPair<int, int>> ranges;
+  int start = -1;
+  for (int i = 0; i <= text.size(); i++) {
+    const bool space = i == text.size() || text.at(i).isSpace();
+    if (space && start >= 0) {
+      ranges.append({ start, i - start });
+      start = -1;
+    } else if (!space && start < 0) {
+      start = i;
+    }
+  }
+  return ranges;
+}
+
+TextAlignment::TextAlignment(const QStringList& texts,
+                             const QStringList& display)
+{
+  QList<int> ids(std::min(texts.size(), display.size()));
+  std::iota(ids.begin(), ids.end(), 0);
+  const QList<QList<qint16>> aligned =
+    QtConcurrent::blockingMapped<QList<QList<qint16>>>(
+      ids, [&texts, &display](int i) {
+        return align(texts.at(i), display.at(i));
+      });
+
+  m_first.reserve(aligned.size() + 1);
+  m_displayWords.reserve(aligned.size());
+  for (int i = 0; i < aligned.size(); i++) {
+    m_first.append(m_words.size());
+    m_words.append(aligned.at(i));
+    m_displayWords.append(wordRanges(display.at(i)).size());
+  }
+  m_first.append(m_words.size());
+}
+
+QString
+TextAlignment::skeleton(const QString& word)
+{
+  QString letters = ArabicNormalizer::normalize(word);
+  letters.removeIf([](QChar c) {
+    const char16_t u = c.unicode();
+    return u == 0x0621 || u == 0x0624 || u == 0x0626 || u == 0x0627 ||
+           u == 0x0648 || u == 0x064A;
+  });
+  return letters;
+}
+
+QList<qint16>
+TextAlignment::align(const QString& text, const QString& display)
+{
+  const QStringList tokens = ArabicNormalizer::tokens(text);
+  QStringList source, target;
+  for (const QString& token : tokens)
+    source.append(skeleton(token));
+  for (const QPair<int, int>& range : wordRanges(display))
+    target.append(skeleton(display.mid(range.first, range.second)));
+
+  // edit distance over words, skipping displayed words without letters (e.g.
+  // pause marks) is free
+  const int n = source.size(), m = target.size();
+  QList<int> cost((n + 1) * (m + 1));
+  const auto at = [m](int i, int j) { return i * (m + 1) + j; };
+  const auto gapCost = [&target](int j) {
+    return target.at(j).isEmpty() ? 0 : 1;
+  };
+  for (int i = 0; i <= n; i++) {
+    for (int j = 0; j <= m; j++) {
+      if (!i && !j)
+        cost[0] = 0;
+      else if (!i)
+        cost[at(0, j)] = cost.at(at(0, j - 1)) + gapCost(j - 1);
+      else if (!j)
+        cost[at(i, 0)] = i;
+      else
+        cost[at(i, j)] = std::min(
+          { cost.at(at(i - 1, j - 1)) + (source.at(i - 1) != target.at(j - 1)),
+            cost.at(at(i - 1, j)) + 1,
+            cost.at(at(i, j - 1)) + gapCost(j - 1) });
+    }
+  }
+
+  // tokens left without a displayed word (e.g. a word the other variant
+  // joins to its neighbour) take the word of the preceding token
+  QList<qint16> words(n, -1);
+  for (int i = n, j = m; i > 0;) {
+    if (j > 0 &&
+        cost.at(at(i, j)) == cost.at(at(i - 1, j - 1)) +
+                               (source.at(i - 1) != target.at(j - 1))) {
+      words[--i] = --j;
+    } else if (j > 0 &&
+               cost.at(at(i, j)) == cost.at(at(i, j - 1)) + gapCost(j - 1)) {
+      j--;
+    } else {
+      i--;
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    if (words.at(i) < 0)
+      words[i] = i ? words.at(i - 1) : 0;
+  }
+  return words;
+}
+
+QList<QPair<int, int>>
+TextAlignment::spans(int verse,
+                     const QList<QPair<int, int>>& words,
+                     const QString& displayed) const
+{
+  if (verse < 1 || verse >= m_first.size())
+    return {};
+
+  const QList<QPair<int, int>> ranges = wordRanges(displayed);
+  const int first = m_first.at(verse - 1);
+  const int count = m_first.at(verse) - first;
+  const int aligned = m_displayWords.at(verse - 1);
+  if (ranges.isEmpty() || !count || !aligned)
+    return {};
+
+  // displayed words of another variant (e.g. QCF glyphs with the verse end
+  // mark) are matched by relative position
+  const auto displayedWord = [&](int token) {
+    const int word = m_words.at(first + std::clamp(token, 0, count - 1));
+    if (ranges.size() >= aligned)
+      return word;
+    return int(qint64(word) * ranges.size() / aligned);
+  };
+
+  QList<QPair<int, int>> spans;
+  for (const QPair<int, int>& match : words) {
+    const auto& start = ranges.at(displayedWord(match.first));
+    const auto& end = ranges.at(displayedWord(match.first + match.second - 1));
+    spans.append({ start.first, end.first + end.second - start.first });
+  }
+
+  std::sort(spans.begin(), spans.end());
+  QList<QPair<int, int>> merged;
+  for (const QPair<int, int>& span : spans) {
+    if (!merged.isEmpty() &&
+        span.first <= merged.last().first + merged.last().second) {
+      QPair<int, int>& last = merged.last();
+      last.second =
+        std::max(last.first + last.second, span.first + span.second) -
+        last.first;
+    } else {
+      merged.append(span);
+    }
+  }
+  return merged;
+}
@@ -0,0 +1,74 @@
+#ifndef TEXTALIGNMENT_H
+#define TEXTALIGNMENT_H
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @class TextAlignment
+ * @brief Word alignment of the searched verse texts to a displayed variant.
+ *
+ * Searches match the normalized emlaey text, while results show the Uthmani,
+ * annotated or Warsh text, or the QCF glyphs, which spell and split words
+ * differently. The tokens of each verse are aligned once to the whitespace
+ * separated words of the displayed variant by an edit distance over word
+ * skeletons, so matched words can be mapped to character spans of the
+ * displayed text.
+ */
+class TextAlignment
+{
+public:
+  TextAlignment() = default;
+  /**
+   * @brief Aligns every verse, verses are aligned in parallel.
+   * @param texts QList of the searched verse texts ordered by verse id.
+   * @param display QList of the displayed verse texts ordered by verse id,
+   * QCF glyphs are displayed word by word like the Uthmani text so it is
+   * aligned for them.
+   */
+  TextAlignment(const QStringList& texts, const QStringList& display);
+  /**
+   * @brief Maps matched words to character spans of a displayed text.
+   * @details The displayed text may differ from the aligned variant (e.g.
+   * QCF glyphs of the aligned Uthmani text), its words are then matched by
+   * relative position.
+   * @param verse Verse id.
+   * @param words QList of the first token and the number of tokens of each
+   * match.
+   * @param displayed The displayed verse text.
+   * @return QList of the start and length of the matched spans, ascending
+   * and not overlapping.
+   */
+  QList<QPair<int, int>> spans(int verse,
+                               const QList<QPair<int, int>>& words,
+                               const QString& displayed) const;
+
+private:
+  /**
+   * @brief Aligns the tokens of a single verse.
+   * @return QList of the aligned displayed word of each token.
+   */
+  static QList<qint16> align(const QString& text, const QString& display);
+  /**
+   * @brief Word skeleton compared by the alignment, the letters spelled
+   * differently across variants (long vowels, hamza seats) are dropped.
+   */
+  static QString skeleton(const QString& word);
+  /**
+   * @brief Offset of the first token of each verse in m_words, the last entry
+   * is the number of tokens.
+   */
+  QList<int> m_first;
+  /**
+   * @brief Aligned displayed word of each token, verse after verse.
+   */
+  QList<qint16> m_words;
+  /**
+   * @brief Number of displayed words of each verse.
+   */
+  QList<qint16> m_displayWords;
+};
+
+#endif // TEXTALIGNMENT_H
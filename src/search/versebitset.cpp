@@ -0,0 +1,234 @@
+#include "versebitset.h"
+#include <QtAlgorithms>
+#include <QtEndian>
+#include <algorithm>
+
+VerseBitset
+VerseBitset::all()
+{
+  VerseBitset set;
+  set.m_words.fill(~quint64(0));
+  set.clearPadding();
+  return set;
+}
+
+VerseBitset
+VerseBitset::range(int fromId, int toId)
+{
+  VerseBitset set;
+  fromId = std::max(fromId, 1);
+  toId = std::min(toId, QuranMetadata::verseTotal);
+  if (fromId > toId)
+    return set;
+
+  // whole words in between, partial words at both ends
+  const int first = fromId - 1, last = toId - 1;
+  const int firstWord = first / 64, lastWord = last / 64;
+  for (int w = firstWord; w <= lastWord; w++)
+    set.m_words[w] = ~quint64(0);
+  set.m_words[firstWord] &= ~quint64(0) << (first % 64);
+  set.m_words[lastWord] &= ~quint64(0) >> (63 - last % 64);
+  return set;
+}
+
+VerseBitset
+VerseBitset::surahs(int from, int to)
+{
+  from = std::max(from, 1);
+  to = std::min(to, QuranMetadata::surahTotal);
+  if (from > to)
+    return VerseBitset();
+  return range(QuranMetadata::surahOffset[from - 1] + 1,
+               QuranMetadata::surahOffset[to]);
+}
+
+VerseBitset
+VerseBitset::juzs(int from, int to)
+{
+  from = std::max(from, 1);
+  to = std::min(to, QuranMetadata::juzTotal);
+  if (from > to)
+    return VerseBitset();
+  return range(QuranMetadata::juzFirstVerse[from],
+               QuranMetadata::juzFirstVerse[to + 1] - 1);
+}
+
+VerseBitset
+VerseBitset::pages(int from, int to, int qcfVersion)
+{
+  from = std::max(from, 1);
+  to = std::min(to, QuranMetadata::pageTotal);
+  if (from > to)
+    return VerseBitset();
+  const int v = qcfVersion - 1;
+  return range(QuranMetadata::pageFirstVerse[v][from],
+               QuranMetadata::pageFirstVerse[v][to + 1] - 1);
+}
+
+VerseBitset
+VerseBitset::fromIds(const QList<int>& ids)
+{
+  VerseBitset set;
+  for (int id : ids)
+    set.set(id);
+  return set;
+}
+
+VerseBitset
+VerseBitset::fromCompressed(const QByteArray& data)
+{
+  VerseBitset set;
+  if (data.isEmpty())
+    return set;
+
+  if (data.at(0) == rawEncoding) {
+    if (data.size() != 1 + qsizetype(sizeof(set.m_words)))
+      return VerseBitset();
+    for (int w = 0; w < wordCount; w++)
+      set.m_words[w] =
+        qFromLittleEndian<quint64>(data.constData() + 1 + w * sizeof(quint64));
+    set.clearPadding();
+    return set;
+  }
+
+  int id = 0;
+  quint32 gap = 0;
+  int shift = 0;
+  for (qsizetype i = 1; i < data.size(); i++) {
+    const uchar byte = data.at(i);
+    gap |= quint32(byte & 0x7F) << shift;
+    if (byte & 0x80) {
+      shift += 7;
+      if (shift > 28)
+        return VerseBitset();
+      continue;
+    }
+    id += gap;
+    set.set(id);
+    gap = 0;
+    shift = 0;
+  }
+  return set;
+}
+
+void
+VerseBitset::set(int id)
+{
+  if (id < 1 || id > QuranMetadata::verseTotal)
+    return;
+  m_words[(id - 1) / 64] |= quint64(1) << ((id - 1) % 64);
+}
+
+bool
+VerseBitset::test(int id) const
+{
+  if (id < 1 || id > QuranMetadata::verseTotal)
+    return false;
+  return m_words[(id - 1) / 64] & (quint64(1) << ((id - 1) % 64));
+}
+
+bool
+VerseBitset::isEmpty() const
+{
+  quint64 any = 0;
+  for (quint64 word : m_words)
+    any |= word;
+  return !any;
+}
+
+int
+VerseBitset::count() const
+{
+  int total = 0;
+  for (quint64 word : m_words)
+    total += qPopulationCount(word);
+  return total;
+}
+
+QList<int>
+VerseBitset::ids() const
+{
+  QList<int> result;
+  result.reserve(count());
+  for (int w = 0; w < wordCount; w++) {
+    quint64 word = m_words[w];
+    while (word) {
+      result.append(w * 64 + qCountTrailingZeroBits(word) + 1);
+      word &= word - 1;
+    }
+  }
+  return result;
+}
+
+QByteArray
+VerseBitset::compressed() const
+{
+  QByteArray data(1, gapEncoding);
+  int previous = 0;
+  for (int id : ids()) {
+    quint32 gap = id - previous;
+    previous = id;
+    while (gap >= 0x80) {
+      data.append(char((gap & 0x7F) | 0x80));
+      gap >>= 7;
+    }
+    data.append(char(gap));
+    if (data.size() > 1 + qsizetype(sizeof(m_words)))
+      break;
+  }
+  if (data.size() <= 1 + qsizetype(sizeof(m_words)))
+    return data;
+
+  data = QByteArray(1 + sizeof(m_words), rawEncoding);
+  for (int w = 0; w < wordCount; w++)
+    qToLittleEndian(m_words[w], data.data() + 1 + w * sizeof(quint64));
+  return data;
+}
+
+VerseBitset&
+VerseBitset::operator&=(const VerseBitset& other)
+{
+  for (int w = 0; w < wordCount; w++)
+    m_words[w] &= other.m_words[w];
+  return *this;
+}
+
+VerseBitset&
+VerseBitset::operator|=(const VerseBitset& other)
+{
+  for (int w = 0; w < wordCount; w++)
+    m_words[w] |= other.m_words[w];
+  return *this;
+}
+
+VerseBitset&
+VerseBitset::andNot(const VerseBitset& other)
+{
+  for (int w = 0; w < wordCount; w++)
+    m_words[w] &= ~other.m_words[w];
+  return *this;
+}
+
+VerseBitset
+VerseBitset::operator~() const
+{
+  VerseBitset set;
+  for (int w = 0; w < wordCount; w++)
+    set.m_words[w] = ~m_words[w];
+  set.clearPadding();
+  return set;
+}
+
+bool
+VerseBitset::operator==(const VerseBitset& other) const
+{
+  return m_words == other.m_words;
+}
+
+void
+VerseBitset::clearPadding()
+{
+  const int used = QuranMetadata::verseTotal % 64;
+  if (used)
+    m_words[wordCount - 1] &= ~quint64(0) >> (64 - used);
+}
@@ -0,0 +1,111 @@
+#ifndef VERSEBITSET_H
+#define VERSEBITSET_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtGlobal>
+#include <array>
+#include <generated/quranmetadata.h>
+
+/**
+ * @class VerseBitset
+ * @brief Fixed-size set of verse ids with one bit per verse.
+ *
+ * Bit (id - 1) represents the verse with the given id. Set operations are
+ * plain loops over the 64-bit words which compilers vectorize, so combining
+ * search terms and filters costs a few passes over 98 words.
+ */
+class VerseBitset
+{
+public:
+  /**
+   * @brief number of 64-bit words covering all verses
+   */
+  static constexpr int wordCount = (QuranMetadata::verseTotal + 63) / 64;
+  /**
+   * @brief Creates an empty set.
+   */
+  VerseBitset() = default;
+  /**
+   * @brief Creates a set of all verses.
+   */
+  static VerseBitset all();
+  /**
+   * @brief Creates a set of a contiguous range of verse ids.
+   * @param fromId The first verse id.
+   * @param toId The last verse id.
+   */
+  static VerseBitset range(int fromId, int toId);
+  /**
+   * @brief Creates a set of the verses of a surah range.
+   * @param from The first surah number.
+   * @param to The last surah number.
+   */
+  static VerseBitset surahs(int from, int to);
+  /**
+   * @brief Creates a set of the verses of a juz range.
+   * @param from The first juz number.
+   * @param to The last juz number.
+   */
+  static VerseBitset juzs(int from, int to);
+  /**
+   * @brief Creates a set of the verses of a page range.
+   * @param from The first page number.
+   * @param to The last page number.
+   * @param qcfVersion The QCF version the page numbers refer to.
+   */
+  static VerseBitset pages(int from, int to, int qcfVersion);
+  /**
+   * @brief Creates a set of the given verse ids.
+   * @param ids QList of verse ids.
+   */
+  static VerseBitset fromIds(const QList<int>& ids);
+  /**
+   * @brief Reads a set written by compressed().
+   * @param data The compressed set.
+   * @return The set, empty if the data is malformed.
+   */
+  static VerseBitset fromCompressed(const QByteArray& data);
+
+  void set(int id);
+  bool test(int id) const;
+  bool isEmpty() const;
+  int count() const;
+  /**
+   * @brief Gets the verse ids in the set.
+   * @return Ascending QList of verse ids.
+   */
+  QList<int> ids() const;
+  /**
+   * @brief Encodes the set compactly for storage.
+   * @details Sparse sets are written as varint gaps between the ids, dense
+   * sets as the raw words, whichever is shorter.
+   */
+  QByteArray compressed() const;
+
+  VerseBitset& operator&=(const VerseBitset& other);
+  VerseBitset& operator|=(const VerseBitset& other);
+  /**
+   * @brief Removes the verses of the other set from this one.
+   */
+  VerseBitset& andNot(const VerseBitset& other);
+  /**
+   * @brief Gets the complement of the set.
+   */
+  VerseBitset operator~() const;
+  bool operator==(const VerseBitset& other) const;
+
+private:
+  /**
+   * @brief Leading byte of the compressed encodings.
+   */
+  static const char gapEncoding = 0;
+  static const char rawEncoding = 1;
+  /**
+   * @brief Clears the bits past the last verse in the last word.
+   */
+  void clearPadding();
+  std::array<quint64, wordCount> m_words = {};
+};
+
+#endif // VERSEBITSET_H
@@ -0,0 +1,324 @@
+#include "versesearchengine.h"
+#include <algorithm>
+#include <QSet>
+#include <QThread>
+#include <QtConcurrent>
+#include <cmath>
+#include <queue>
+#include <generated/quranmetadata.h>
+#include <search/fuzzymatcher.h>
+#include <utils/arabicnormalizer.h>
+
+VerseSearchEngine::VerseSearchEngine(const QStringList& texts, int qcfVersion)
+  : m_version(qcfVersion - 1)
+{
+  QList<QStringList> documents;
+  documents.reserve(texts.size());
+  m_texts.reserve(texts.size());
+  for (const QString& text : texts) {
+    const QString normalized = ArabicNormalizer::normalize(text);
+    documents.append(normalized.split(' ', Qt::SkipEmptyParts));
+    m_texts.append(' ' + normalized + ' ');
+  }
+
+  m_index.build(documents);
+  m_positions.build(documents);
+}
+
+QList<int>
+VerseSearchEngine::search(const QString& text,
+                          bool whole,
+                          int fromId,
+                          int toId) const
+{
+  const QStringList tokens = ArabicNormalizer::tokens(text);
+  if (tokens.isEmpty())
+    return {};
+
+  if (whole) {
+    QList<int> ids;
+    for (const WordSpan& span : m_positions.phrase(tokens)) {
+      if (span.verse >= fromId && span.verse <= toId &&
+          (ids.isEmpty() || ids.constLast() != span.verse))
+        ids.append(span.verse);
+    }
+    return ids;
+  }
+
+  // without whole word matching the phrase may start in the middle of its
+  // first word and end in the middle of its last one
+  QList<QList<int>> lists;
+  for (int i = 0; i < tokens.size(); i++) {
+    InvertedIndex::MatchMode mode = InvertedIndex::Exact;
+    if (tokens.size() == 1)
+      mode = InvertedIndex::Contains;
+    else if (i == 0)
+      mode = InvertedIndex::Suffix;
+    else if (i == tokens.size() - 1)
+      mode = InvertedIndex::Prefix;
+
+    lists.append(m_index.postings(tokens.at(i), mode));
+    if (lists.constLast().isEmpty())
+      return {};
+  }
+
+  std::sort(lists.begin(),
+            lists.end(),
+            [](const QList<int>& a, const QList<int>& b) {
+              return a.size() < b.size();
+            });
+
+  // restrict the shortest list to the id range before intersecting
+  auto first = std::lower_bound(lists[0].cbegin(), lists[0].cend(), fromId);
+  auto last = std::upper_bound(first, lists[0].cend(), toId);
+  QList<int> ids(first, last);
+  for (int i = 1; i < lists.size() && !ids.isEmpty(); i++)
+    ids = InvertedIndex::intersect(ids, lists.at(i));
+
+  if (tokens.size() == 1)
+    return ids;
+
+  // all words occur in the verse, keep verses containing them as a phrase
+  const QString phrase = tokens.join(' ');
+  ids.removeIf(
+    [&](int id) { return !m_texts.at(id - 1).contains(phrase); });
+  return ids;
+}
+
+QList<int>
+VerseSearchEngine::refine(const QList<int>& ids,
+                          const QString& text,
+                          bool whole) const
+{
+  const QStringList tokens = ArabicNormalizer::tokens(text);
+  if (tokens.isEmpty())
+    return {};
+
+  // verse texts are padded with spaces, a leading space anchors the phrase
+  // at a word start and a trailing one at a word end
+  QString phrase = tokens.join(' ');
+  if (whole)
+    phrase = ' ' + phrase + ' ';
+  QList<int> refined;
+  for (int id : ids) {
+    if (id >= 1 && id <= m_texts.size() && m_texts.at(id - 1).contains(phrase))
+      refined.append(id);
+  }
+  return refined;
+}
+
+QHash<int, QList<QPair<int, int>>>
+VerseSearchEngine::matchedWords(const QList<int>& ids,
+                                const QStringList& phrases,
+                                bool whole,
+                                bool crossVerse) const
+{
+  const QSet<int> verses(ids.cbegin(), ids.cend());
+  QHash<int, QList<QPair<int, int>>> words;
+  for (const QString& phrase : phrases) {
+    const QStringList tokens = ArabicNormalizer::tokens(phrase);
+    if (tokens.isEmpty())
+      continue;
+
+    // the same modes as the search, a partial phrase may start inside its
+    // first word and end inside its last one
+    QList<InvertedIndex::MatchMode> modes(tokens.size(), InvertedIndex::Exact);
+    if (!whole && tokens.size() == 1) {
+      modes.first() = InvertedIndex::Contains;
+    } else if (!whole) {
+      modes.first() = InvertedIndex::Suffix;
+      modes.last() = InvertedIndex::Prefix;
+    }
+
+    for (const WordSpan& span : m_positions.phrase(tokens, modes, crossVerse)) {
+      int verse = span.verse, offset = span.offset, length = span.length;
+      while (length > 0 && verse <= m_positions.verseCount()) {
+        const int count =
+          std::min(length, m_positions.verseLength(verse) - offset);
+        if (verses.contains(verse))
+          words[verse].append({ offset, count });
+        length -= count;
+        offset = 0;
+        verse++;
+      }
+    }
+  }
+  return words;
+}
+
+QList<int>
+VerseSearchEngine::rank(const QList<int>& ids,
+                        const QString& text,
+                        bool whole,
+                        int limit) const
+{
+  // common BM25 parameters, k1 saturates repeated terms and b normalizes the
+  // verse length
+  const double k1 = 1.2, b = 0.75;
+  const double verseCount = m_positions.verseCount();
+  const double averageLength = m_positions.averageVerseLength();
+
+  QList<double> idf;
+  QList<QHash<int, int>> frequencies;
+  for (const QString& token : ArabicNormalizer::tokens(text)) {
+    frequencies.append(m_positions.termFrequencies(
+      token, whole ? InvertedIndex::Exact : InvertedIndex::Contains));
+    const double df = frequencies.constLast().size();
+    idf.append(std::log(1 + (verseCount - df + 0.5) / (df + 0.5)));
+  }
+
+  // min-heap of the best (score, index) pairs seen so far
+  using Scored = std::pair<double, int>;
+  std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>> best;
+  for (int i = 0; i < ids.size() && limit > 0; i++) {
+    const int id = ids.at(i);
+    const double norm =
+      k1 * (1 - b + b * m_positions.verseLength(id) / averageLength);
+    double score = 0;
+    for (int t = 0; t < frequencies.size(); t++) {
+      const double tf = frequencies.at(t).value(id);
+      score += idf.at(t) * tf * (k1 + 1) / (tf + norm);
+    }
+
+    // ties keep the earlier verse
+    if (best.size() < size_t(limit))
+      best.push({ score, -i });
+    else if (score > best.top().first) {
+      best.pop();
+      best.push({ score, -i });
+    }
+  }
+
+  QList<int> ranked(best.size());
+  QList<bool> taken(ids.size(), false);
+  for (qsizetype i = ranked.size() - 1; i >= 0; i--) {
+    ranked[i] = ids.at(-best.top().second);
+    taken[-best.top().second] = true;
+    best.pop();
+  }
+  for (int i = 0; i < ids.size(); i++)
+    if (!taken.at(i))
+      ranked.append(ids.at(i));
+  return ranked;
+}
+
+QList<Verse>
+VerseSearchEngine::searchVerses(const QString& searchText,
+                                const int range[2],
+                                bool whole) const
+{
+  // a page range is a contiguous range of verse ids
+  const int first = std::clamp(range[0], 1, QuranMetadata::pageTotal);
+  const int last = std::clamp(range[1], first, QuranMetadata::pageTotal);
+  return toVerses(
+    search(searchText,
+           whole,
+           QuranMetadata::pageFirstVerse[m_version][first],
+           QuranMetadata::pageFirstVerse[m_version][last + 1] - 1));
+}
+
+QList<Verse>
+VerseSearchEngine::searchSurahs(const QString& searchText,
+                                const QList<int>& surahs,
+                                bool whole) const
+{
+  if (surahs.isEmpty())
+    return {};
+
+  bool selected[QuranMetadata::surahTotal + 1] = {};
+  int firstSurah = QuranMetadata::surahTotal, lastSurah = 1;
+  for (int surah : surahs) {
+    if (surah < 1 || surah > QuranMetadata::surahTotal)
+      continue;
+    selected[surah] = true;
+    firstSurah = std::min(firstSurah, surah);
+    lastSurah = std::max(lastSurah, surah);
+  }
+
+  QList<int> ids = search(searchText,
+                          whole,
+                          QuranMetadata::verseId(firstSurah, 1),
+                          QuranMetadata::surahOffset[lastSurah]);
+  ids.removeIf(
+    [&](int id) { return !selected[QuranMetadata::surahOf(id)]; });
+  return toVerses(ids);
+}
+
+QList<QPair<int, int>>
+VerseSearchEngine::searchApproximate(const QString& text, int maxEdits) const
+{
+  const FuzzyMatcher matcher(ArabicNormalizer::normalize(text));
+  if (!matcher.length())
+    return {};
+  // roughly one mistake every five characters, short texts are matched
+  // exactly since a single edit already matches most verses
+  if (maxEdits < 0)
+    maxEdits =
+      matcher.length() < 4 ? 0 : std::clamp(matcher.length() / 5, 1, 8);
+
+  // contiguous verse id ranges, a few per thread to balance verse lengths
+  const int chunkCount = std::max(1, QThread::idealThreadCount() * 4);
+  const int chunkSize = (m_texts.size() + chunkCount - 1) / chunkCount;
+  QList<QPair<int, int>> chunks;
+  for (int first = 0; first < m_texts.size(); first += chunkSize)
+    chunks.append({ first, std::min<int>(first + chunkSize, m_texts.size()) });
+
+  const auto matchChunk = [&](const QPair<int, int>& chunk) {
+    QList<QPair<int, int>> matches;
+    for (int i = chunk.first; i < chunk.second; i++) {
+      int distance = matcher.distance(m_texts.at(i), maxEdits);
+      if (distance <= maxEdits)
+        matches.append({ i + 1, distance });
+    }
+    return matches;
+  };
+  const auto collect = [](QList<QPair<int, int>>& all,
+                          const QList<QPair<int, int>>& matches) {
+    all.append(matches);
+  };
+
+  QList<QPair<int, int>> results =
+    QtConcurrent::blockingMappedReduced<QList<QPair<int, int>>>(
+      chunks, matchChunk, collect, QtConcurrent::UnorderedReduce);
+
+  std::sort(results.begin(),
+            results.end(),
+            [](const QPair<int, int>& a, const QPair<int, int>& b) {
+              return a.second != b.second ? a.second < b.second
+                                          : a.first < b.first;
+            });
+  return results;
+}
+
+QList<WordSpan>
+VerseSearchEngine::searchPhrase(const QString& text, bool crossVerse) const
+{
+  return m_positions.phrase(ArabicNormalizer::tokens(text), crossVerse);
+}
+
+QList<WordSpan>
+VerseSearchEngine::searchNear(const QString& first,
+                              const QString& second,
+                              int distance) const
+{
+  return m_positions.near(ArabicNormalizer::tokens(first),
+                          ArabicNormalizer::tokens(second),
+                          distance);
+}
+
+const InvertedIndex&
+VerseSearchEngine::index() const
+{
+  return m_index;
+}
+
+QList<Verse>
+VerseSearchEngine::toVerses(const QList<int>& ids) const
+{
+  QList<Verse> verses;
+  verses.reserve(ids.size());
+  for (int id : ids)
+    verses.append(Verse::fromId(id, m_version + 1));
+
+  return verses;
+}
@@ -0,0 +1,168 @@
+#ifndef VERSESEARCHENGINE_H
+#define VERSESEARCHENGINE_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <climits>
+#include <search/invertedindex.h>
+#include <search/positionalindex.h>
+#include <types/verse.h>
+
+/**
+ * @class VerseSearchEngine
+ * @brief In-memory verse search over an InvertedIndex of normalized tokens.
+ *
+ * The engine is built once from the emlaey text of every verse. Query tokens
+ * are resolved to posting lists which are intersected starting from the
+ * shortest, and multi-word queries are then verified against the normalized
+ * verse text so results match the phrase semantics of the SQL search.
+ * Whole-word phrases and proximity searches are answered by a
+ * PositionalIndex of the same tokens.
+ */
+class VerseSearchEngine
+{
+public:
+  /**
+   * @brief Builds the engine.
+   * @param texts QList of the verse texts ordered by verse id.
+   * @param qcfVersion The QCF version whose page numbers are used for page
+   * ranges and returned verses.
+   */
+  VerseSearchEngine(const QStringList& texts, int qcfVersion);
+  /**
+   * @brief Searches all verses.
+   * @param text The searched word or phrase.
+   * @param whole If true, match whole words only, otherwise the phrase may
+   * start and end inside words.
+   * @param fromId The first verse id to include.
+   * @param toId The last verse id to include.
+   * @return Ascending QList of matching verse ids.
+   */
+  QList<int> search(const QString& text,
+                    bool whole,
+                    int fromId = 1,
+                    int toId = INT_MAX) const;
+  /**
+   * @brief Orders results by their BM25 relevance to the searched text.
+   * @details Term frequencies and verse lengths come from the positional
+   * index, document frequencies from the posting lists. Only the best scored
+   * verses are selected, through a bounded heap, without sorting all results.
+   * @param ids QList of verse ids to order.
+   * @param text The searched text.
+   * @param whole If true, only whole words count as occurrences.
+   * @param limit Number of best scored verses to move to the front.
+   * @return QList of the given ids, the best scored first in descending score
+   * followed by the rest in their original order.
+   */
+  QList<int> rank(const QList<int>& ids,
+                  const QString& text,
+                  bool whole,
+                  int limit) const;
+  /**
+   * @brief Narrows down previous results to the verses matching the text.
+   * @details Used when a search text is extended, the verse texts of the
+   * previous results are checked directly instead of querying the index.
+   * @param ids QList of verse ids to check.
+   * @param text The searched word or phrase.
+   * @param whole If true, match whole words only.
+   * @return QList of the given ids whose verse matches, in the same order.
+   */
+  QList<int> refine(const QList<int>& ids,
+                    const QString& text,
+                    bool whole) const;
+  /**
+   * @brief Finds the words of the given verses matched by the searched
+   * phrases.
+   * @details Phrases are matched through the positional index the way the
+   * search producing the verses matched them. Partial matches cover the whole
+   * words they start and end in, phrases running into the next verse are
+   * split at the verse ends.
+   * @param ids QList of the ids of the verses to locate the phrases in.
+   * @param phrases QList of the searched words or phrases.
+   * @param whole If true, match whole words only.
+   * @param crossVerse If true, phrases may continue into the next verse.
+   * @return QHash of the first word offset and the number of words of each
+   * match by verse id, holding only the given verses that have a match.
+   */
+  QHash<int, QList<QPair<int, int>>> matchedWords(
+    const QList<int>& ids,
+    const QStringList& phrases,
+    bool whole,
+    bool crossVerse = false) const;
+  /**
+   * @brief Searches verses within a page range.
+   * @param searchText The searched word or phrase.
+   * @param range The first and last page to search in.
+   * @param whole If true, match whole words only.
+   * @return QList of matching verses in mushaf order.
+   */
+  QList<Verse> searchVerses(const QString& searchText,
+                            const int range[2],
+                            bool whole) const;
+  /**
+   * @brief Searches verses in the given surahs.
+   * @param searchText The searched word or phrase.
+   * @param surahs QList of surah numbers to search in.
+   * @param whole If true, match whole words only.
+   * @return QList of matching verses in mushaf order.
+   */
+  QList<Verse> searchSurahs(const QString& searchText,
+                            const QList<int>& surahs,
+                            bool whole) const;
+  /**
+   * @brief Searches all verses for approximate matches of the text.
+   * @details Verses are split in chunks matched in parallel on the global
+   * thread pool with a FuzzyMatcher.
+   * @param text The searched text, possibly misspelled.
+   * @param maxEdits Maximum number of edits between the text and a verse
+   * substring, derived from the text length if negative, texts shorter
+   * than 4 characters are then matched exactly.
+   * @return QList of the matching verse ids and their edit distances ordered
+   * by distance, then by verse id.
+   */
+  QList<QPair<int, int>> searchApproximate(const QString& text,
+                                           int maxEdits = -1) const;
+  /**
+   * @brief Finds the occurrences of an exact phrase of whole words.
+   * @param text The searched phrase.
+   * @param crossVerse If true, the phrase may continue into the next verse.
+   * @return QList of the matched word spans ordered by position.
+   */
+  QList<WordSpan> searchPhrase(const QString& text, bool crossVerse) const;
+  /**
+   * @brief Finds two phrases within a number of words of each other.
+   * @param first The first searched phrase.
+   * @param second The second searched phrase.
+   * @param distance Maximum number of words between the phrases.
+   * @return QList of the word spans covering both phrases.
+   */
+  QList<WordSpan> searchNear(const QString& first,
+                             const QString& second,
+                             int distance) const;
+  /**
+   * @brief Gets the underlying index.
+   * @return Const reference to the InvertedIndex.
+   */
+  const InvertedIndex& index() const;
+
+private:
+  /**
+   * @brief Constructs the verses of the given ids.
+   */
+  QList<Verse> toVerses(const QList<int>& ids) const;
+  InvertedIndex m_index;
+  PositionalIndex m_positions;
+  /**
+   * @brief Normalized verse texts padded with a space on both ends, indexed
+   * by verse id - 1.
+   */
+  QStringList m_texts;
+  /**
+   * @brief Index of the QCF version in the generated page tables.
+   */
+  int m_version;
+};
+
+#endif // VERSESEARCHENGINE_H
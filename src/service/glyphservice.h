@@ -33,6 +33,18 @@ public:
    * @return QString of verse glyphs
    */
   virtual QString getVerseGlyphs(const int sIdx, const int vIdx) const = 0;
+  /**
+   * @brief gets the QCF glyphs of any set of verses at once
+   * @param ids - QList of verse ids (1-6236)
+   * @return QStringList of the verse glyphs in the order of the ids
+   */
+  virtual QStringList verseGlyphsById(const QList<int>& ids) const = 0;
+  /**
+   * @brief gets the QCF glyphs of all verses of a page at once
+   * @param page - Quran page number
+   * @return QStringList of the verse glyphs in the order of the page verses
+   */
+  virtual QStringList pageVerseGlyphs(const int page) const = 0;
 };
 
 #endif
@@ -28,3 +28,15 @@ GlyphServiceSqlImpl::getVerseGlyphs(const int sIdx, const int vIdx) const
 {
   return m_glyphRepository.getVerseGlyphs(sIdx, vIdx);
 }
+
+QStringList
+GlyphServiceSqlImpl::verseGlyphsById(const QList<int>& ids) const
+{
+  return m_glyphRepository.verseGlyphsById(ids);
+}
+
+QStringList
+GlyphServiceSqlImpl::pageVerseGlyphs(const int page) const
+{
+  return m_glyphRepository.pageVerseGlyphs(page);
+}
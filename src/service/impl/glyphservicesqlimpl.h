@@ -19,6 +19,10 @@ public:
   QString getJuzGlyph(const int juz) const override;
 
   QString getVerseGlyphs(const int sIdx, const int vIdx) const override;
+
+  QStringList verseGlyphsById(const QList<int>& ids) const override;
+
+  QStringList pageVerseGlyphs(const int page) const override;
 };
 
 #endif // GLYPHSERVICESQLIMPL_H
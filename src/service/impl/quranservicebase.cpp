@@ -0,0 +1,159 @@
+#include "quranservicebase.h"
+#include <QMutex>
+#include <map>
+#include <repository/concordancerepository.h>
+#include <repository/morphologyrepository.h>
+
+QuranServiceBase::QuranServiceBase()
+  : m_quranRepository(QuranRepository::getInstance())
+  , m_similarity(SimilarityRepository::getInstance())
+{
+}
+
+QList<Verse>
+QuranServiceBase::versesFromIds(const QList<int>& ids)
+{
+  QList<Verse> verses;
+  verses.reserve(ids.size());
+  const int qcfVersion = Configuration::getInstance().qcfVersion();
+  for (int id : ids)
+    verses.append(Verse::fromId(id, qcfVersion));
+  return verses;
+}
+
+QList<int>
+QuranServiceBase::verseIds(const QList<Verse>& verses)
+{
+  QList<int> ids;
+  ids.reserve(verses.size());
+  for (const Verse& v : verses)
+    ids.append(Verse::id(v.surah(), v.number()));
+  return ids;
+}
+
+QList<Verse>
+QuranServiceBase::searchApproximate(QString searchText) const
+{
+  QList<int> ids;
+  for (const QPair<int, int>& match :
+       searchEngine().searchApproximate(searchText))
+    ids.append(match.first);
+  return versesFromIds(ids);
+}
+
+QList<WordSpan>
+QuranServiceBase::searchPhrase(QString searchText, const bool crossVerse) const
+{
+  return searchEngine().searchPhrase(searchText, crossVerse);
+}
+
+QList<WordSpan>
+QuranServiceBase::searchNear(QString first,
+                             QString second,
+                             const int distance) const
+{
+  return searchEngine().searchNear(first, second, distance);
+}
+
+QList<Verse>
+QuranServiceBase::rankSearch(const QList<Verse>& verses,
+                             QString searchText,
+                             const bool whole,
+                             const int limit) const
+{
+  return versesFromIds(
+    searchEngine().rank(verseIds(verses), searchText, whole, limit));
+}
+
+QList<Verse>
+QuranServiceBase::refineSearch(const QList<Verse>& verses,
+                               QString searchText,
+                               const bool whole) const
+{
+  return versesFromIds(
+    searchEngine().refine(verseIds(verses), searchText, whole));
+}
+
+const TextAlignment&
+QuranServiceBase::textAlignment() const
+{
+  // the verse type can change during the session, map nodes are stable so
+  // references to the alignments of other types stay valid
+  static std::map<ConfigurationSchema::VerseType, TextAlignment> alignments;
+  static QMutex lock;
+  const ConfigurationSchema::VerseType type =
+    Configuration::getInstance().verseType();
+  QMutexLocker locker(&lock);
+  auto it = alignments.find(type);
+  if (it == alignments.end())
+    it = alignments
+           .emplace(type,
+                    TextAlignment(m_quranRepository.emlaeyTexts(),
+                                  m_quranRepository.displayTexts(type)))
+           .first;
+  return it->second;
+}
+
+QHash<int, QList<QPair<int, int>>>
+QuranServiceBase::matchedWords(const QList<Verse>& verses,
+                               const QStringList& phrases,
+                               const bool whole,
+                               const bool crossVerse) const
+{
+  return searchEngine().matchedWords(
+    verseIds(verses), phrases, whole, crossVerse);
+}
+
+QList<QPair<int, int>>
+QuranServiceBase::matchSpans(const Verse& verse,
+                             const QString& displayed,
+                             const QList<QPair<int, int>>& words) const
+{
+  if (words.isEmpty())
+    return {};
+  return textAlignment().spans(
+    Verse::id(verse.surah(), verse.number()), words, displayed);
+}
+
+QList<Verse>
+QuranServiceBase::similarVerses(const Verse& verse, const int limit) const
+{
+  QList<int> ids;
+  const int id = Verse::id(verse.surah(), verse.number());
+  for (const SimilarityIndex::Match& match :
+       m_similarity.index().similar(id, limit))
+    ids.append(match.verse);
+  return versesFromIds(ids);
+}
+
+QFuture<bool>
+QuranServiceBase::prepareConcordance() const
+{
+  return ConcordanceRepository::getInstance().prepare();
+}
+
+const Concordance&
+QuranServiceBase::concordance() const
+{
+  return ConcordanceRepository::getInstance().concordance();
+}
+
+bool
+QuranServiceBase::hasMorphology() const
+{
+  return MorphologyRepository::getInstance().isAvailable();
+}
+
+QList<int>
+QuranServiceBase::searchMorphology(QString searchText, const bool lemma) const
+{
+  return MorphologyRepository::getInstance().search(
+    searchText, lemma ? Morphology::Lemma : Morphology::Root);
+}
+
+QStringList
+QuranServiceBase::morphologyForms(QString word, const bool lemma) const
+{
+  return MorphologyRepository::getInstance().forms(
+    word, lemma ? Morphology::Lemma : Morphology::Root);
+}
@@ -0,0 +1,90 @@
+#ifndef QURANSERVICEBASE_H
+#define QURANSERVICEBASE_H
+
+#include <repository/quranrepository.h>
+#include <repository/similarityrepository.h>
+#include <search/textalignment.h>
+#include <search/versesearchengine.h>
+#include <service/quranservice.h>
+
+/**
+ * @brief QuranServiceBase holds the parts of QuranService shared by its
+ * implementations
+ * @details ranking, refinement, match locations, similar verses, the
+ * concordance and the morphology are answered by in-memory indices whatever
+ * answers the navigation queries. Implementations provide the
+ * VerseSearchEngine these run on.
+ */
+class QuranServiceBase : public QuranService
+{
+protected:
+  QuranServiceBase();
+  /**
+   * @brief in-memory index of the verse texts used by the shared searches
+   */
+  virtual const VerseSearchEngine& searchEngine() const = 0;
+  QuranRepository& m_quranRepository;
+
+private:
+  SimilarityRepository& m_similarity;
+  /**
+   * @brief alignment of the verse texts to the displayed variant of the
+   * current verse type, computed on the first use of each type
+   */
+  const TextAlignment& textAlignment() const;
+  /**
+   * @brief construct the verses of the given ids in the current QCF version
+   */
+  static QList<Verse> versesFromIds(const QList<int>& ids);
+  /**
+   * @brief get the ids of the given verses
+   */
+  static QList<int> verseIds(const QList<Verse>& verses);
+
+public:
+  QList<Verse> searchApproximate(QString searchText) const override;
+
+  QList<WordSpan> searchPhrase(QString searchText,
+                               const bool crossVerse) const override;
+
+  QList<WordSpan> searchNear(QString first,
+                             QString second,
+                             const int distance) const override;
+
+  QList<Verse> rankSearch(const QList<Verse>& verses,
+                          QString searchText,
+                          const bool whole,
+                          const int limit) const override;
+
+  QList<Verse> refineSearch(const QList<Verse>& verses,
+                            QString searchText,
+                            const bool whole) const override;
+
+  QHash<int, QList<QPair<int, int>>> matchedWords(
+    const QList<Verse>& verses,
+    const QStringList& phrases,
+    const bool whole,
+    const bool crossVerse) const override;
+
+  QList<QPair<int, int>> matchSpans(
+    const Verse& verse,
+    const QString& displayed,
+    const QList<QPair<int, int>>& words) const override;
+
+  QList<Verse> similarVerses(const Verse& verse,
+                             const int limit) const override;
+
+  QFuture<bool> prepareConcordance() const override;
+
+  const Concordance& concordance() const override;
+
+  bool hasMorphology() const override;
+
+  QList<int> searchMorphology(QString searchText,
+                              const bool lemma) const override;
+
+  QStringList morphologyForms(QString word,
+                              const bool lemma) const override;
+};
+
+#endif // QURANSERVICEBASE_H
@@ -0,0 +1,277 @@
+#include "quranservicememoryimpl.h"
+#include <QRandomGenerator>
+#include <algorithm>
+#include <generated/quranmetadata.h>
+
+QuranServiceMemoryImpl::QuranServiceMemoryImpl()
+  : m_config(Configuration::getInstance())
+  , m_version(Configuration::getInstance().qcfVersion() == 2 ? 1 : 0)
+  , m_searchEngine(m_quranRepository.emlaeyTexts(),
+                   Configuration::getInstance().qcfVersion())
+{
+  loadTable();
+  m_surahNames = m_quranRepository.surahNames();
+  for (int i = 1; i <= 114; i++)
+    m_surahNamesAr.append(m_quranRepository.surahName(i, true));
+}
+
+void
+QuranServiceMemoryImpl::loadTable()
+{
+  using namespace QuranMetadata;
+  for (int v = 0; v < 2; v++)
+    m_table.page[v] = QList<quint16>(versePage[v], versePage[v] + verseTotal);
+  m_table.surah.resize(verseTotal);
+  m_table.number.resize(verseTotal);
+  m_table.juz.resize(verseTotal);
+
+  for (int s = 1; s <= surahTotal; s++) {
+    for (int i = surahOffset[s - 1]; i < surahOffset[s]; i++) {
+      m_table.surah[i] = s;
+      m_table.number[i] = i - surahOffset[s - 1] + 1;
+    }
+  }
+  for (int j = 1; j <= juzTotal; j++) {
+    for (int i = juzFirstVerse[j] - 1; i < juzFirstVerse[j + 1] - 1; i++)
+      m_table.juz[i] = j;
+  }
+}
+
+Verse
+QuranServiceMemoryImpl::verseAt(int idx) const
+{
+  return Verse(m_table.page[m_version].at(idx),
+               m_table.surah.at(idx),
+               m_table.number.at(idx));
+}
+
+int
+QuranServiceMemoryImpl::indexOf(int surahIdx, int verse) const
+{
+  if (verse < 1 || verse > Verse::surahVerseCount(surahIdx))
+    return -1;
+  return Verse::id(surahIdx, verse) - 1;
+}
+
+QPair<int, int>
+QuranServiceMemoryImpl::pageMetadata(const int page) const
+{
+  if (page < 1 || page > 604)
+    return { 0, 0 };
+
+  // page header metadata is resolved against QCF v1 pages
+  int idx = QuranMetadata::pageFirstVerse[0][page] - 1;
+  return { m_table.surah.at(idx), m_table.juz.at(idx) };
+}
+
+std::optional<QPair<int, int>>
+QuranServiceMemoryImpl::getRubStartingInPage(const int page) const
+{
+  if (page < 1 || page > 604)
+    return std::nullopt;
+
+  // rub boundaries are resolved against QCF v1 pages
+  const int rub = QuranMetadata::pageRubStart[0][page];
+  if (!rub)
+    return std::nullopt;
+
+  return QPair<int, int>(
+    rub % 4 ? rub % 4 : 4,
+    QuranMetadata::hizbOf(QuranMetadata::rubFirstVerse[rub]));
+}
+
+int
+QuranServiceMemoryImpl::getVersePage(const int& surahIdx,
+                                     const int& verse) const
+{
+  int idx = indexOf(surahIdx, verse);
+  return idx == -1 ? 0 : m_table.page[m_version].at(idx);
+}
+
+Verse
+QuranServiceMemoryImpl::getJuzStart(const int juz) const
+{
+  if (juz < 1 || juz > 30)
+    return Verse();
+  return verseAt(QuranMetadata::juzFirstVerse[juz] - 1);
+}
+
+int
+QuranServiceMemoryImpl::getVerseJuz(const Verse verse) const
+{
+  int idx = indexOf(verse.surah(), std::max(1, verse.number()));
+  return idx == -1 ? 0 : m_table.juz.at(idx);
+}
+
+QList<Verse>
+QuranServiceMemoryImpl::verseInfoList(const int page) const
+{
+  QList<Verse> viList;
+  if (page < 1 || page > 604)
+    return viList;
+
+  const int* pageFirstVerse = QuranMetadata::pageFirstVerse[m_version];
+  viList.reserve(pageFirstVerse[page + 1] - pageFirstVerse[page]);
+  for (int id = pageFirstVerse[page]; id < pageFirstVerse[page + 1]; id++)
+    viList.append(verseAt(id - 1));
+
+  return viList;
+}
+
+Verse
+QuranServiceMemoryImpl::firstInPage(int page) const
+{
+  if (page < 1 || page > 604)
+    return Verse();
+  return verseAt(QuranMetadata::pageFirstVerse[m_version][page] - 1);
+}
+
+QString
+QuranServiceMemoryImpl::verseText(const int sIdx, const int vIdx) const
+{
+  return m_quranRepository.verseText(sIdx, vIdx);
+}
+
+QStringList
+QuranServiceMemoryImpl::verseTexts(const int surah,
+                                   const int from,
+                                   const int to) const
+{
+  return m_quranRepository.verseTexts(surah, from, to);
+}
+
+QStringList
+QuranServiceMemoryImpl::verseTextsById(const QList<int>& ids) const
+{
+  return m_quranRepository.verseTextsById(ids);
+}
+
+QList<Verse>
+QuranServiceMemoryImpl::verseInfoRange(const int fromId,
+                                       const int toId) const
+{
+  QList<Verse> verses;
+  const int first = std::max(fromId, 1);
+  const int last = std::min<int>(toId, m_table.surah.size());
+  verses.reserve(std::max(last - first + 1, 0));
+  for (int id = first; id <= last; id++)
+    verses.append(verseAt(id - 1));
+  return verses;
+}
+
+QStringList
+QuranServiceMemoryImpl::pageVerseTexts(const int page) const
+{
+  return m_quranRepository.pageVerseTexts(page);
+}
+
+int
+QuranServiceMemoryImpl::surahStartPage(int surahIdx) const
+{
+  return getVersePage(surahIdx, 1);
+}
+
+QString
+QuranServiceMemoryImpl::surahName(const int sIdx, bool ar) const
+{
+  if (sIdx < 1 || sIdx > 114)
+    return QString();
+  if (ar || m_config.language() == QLocale::Arabic)
+    return m_surahNamesAr.at(sIdx - 1);
+  return m_surahNames.at(sIdx - 1);
+}
+
+Verse
+QuranServiceMemoryImpl::verseById(const int id) const
+{
+  if (id < 1 || id > m_table.surah.size())
+    return Verse();
+  return verseAt(id - 1);
+}
+
+int
+QuranServiceMemoryImpl::versePage(const int& surahIdx, const int& verse) const
+{
+  return getVersePage(surahIdx, verse);
+}
+
+QList<int>
+QuranServiceMemoryImpl::searchSurahNames(QString text) const
+{
+  return m_quranRepository.searchSurahNames(text);
+}
+
+QList<Verse>
+QuranServiceMemoryImpl::searchSurahs(QString searchText,
+                                     const QList<int> surahs,
+                                     const bool whole) const
+{
+  return m_searchEngine.searchSurahs(searchText, surahs, whole);
+}
+
+QList<Verse>
+QuranServiceMemoryImpl::searchVerses(QString searchText,
+                                     const int range[],
+                                     const bool whole) const
+{
+  return m_searchEngine.searchVerses(searchText, range, whole);
+}
+
+QString
+QuranServiceMemoryImpl::searchBackend() const
+{
+  return "memory";
+}
+
+const VerseSearchEngine&
+QuranServiceMemoryImpl::searchEngine() const
+{
+  return m_searchEngine;
+}
+
+Verse
+QuranServiceMemoryImpl::randomVerse() const
+{
+  return verseAt(QRandomGenerator::global()->bounded(m_table.surah.size()));
+}
+
+QStringList
+QuranServiceMemoryImpl::surahNames() const
+{
+  return m_surahNames;
+}
+
+Verse
+QuranServiceMemoryImpl::next(const Verse& verse, bool withBasmallah) const
+{
+  Verse nxt(verse);
+  if (!nxt.number()) {
+    nxt.setNumber(1);
+    return nxt;
+  }
+
+  nxt = verseById(Verse::id(nxt.surah(), nxt.number()) + 1);
+
+  if (withBasmallah && nxt.number() == 1 && nxt.surah() != 9 &&
+      nxt.surah() != 1)
+    nxt.setNumber(0);
+
+  return nxt;
+}
+
+Verse
+QuranServiceMemoryImpl::previous(const Verse& verse, bool withBasmallah) const
+{
+  Verse nxt(verse);
+  if (withBasmallah && nxt.number() == 1 && nxt.surah() != 9 &&
+      nxt.surah() != 1) {
+    nxt.setNumber(0);
+    return nxt;
+  }
+
+  if (!nxt.number())
+    nxt.setNumber(1);
+
+  nxt = verseById(Verse::id(nxt.surah(), nxt.number()) - 1);
+  return nxt;
+}
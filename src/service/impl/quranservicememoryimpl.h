@@ -0,0 +1,124 @@
+#ifndef QURANSERVICEMEMORYIMPL_H
+#define QURANSERVICEMEMORYIMPL_H
+
+#include <service/impl/quranservicebase.h>
+
+/**
+ * @brief QuranService implementation that answers navigation queries from an
+ * in-memory verse table
+ * @details All 6236 verses are filled once on construction into a
+ * struct-of-arrays table indexed by (verse id - 1) from the generated
+ * QuranMetadata tables. Page, surah, juz and rub lookups are answered by
+ * array indexing or the QuranMetadata tables, so page flips and
+ * playback advancement never reach SQLite. Verse searches are answered by an
+ * in-memory VerseSearchEngine, verse text is still read from the
+ * QuranRepository.
+ */
+class QuranServiceMemoryImpl : public QuranServiceBase
+{
+private:
+  /**
+   * @brief VerseTable holds the metadata of all verses as parallel arrays
+   */
+  struct VerseTable
+  {
+    QList<quint16> page[2]; ///< page per QCF version (index 0: v1, 1: v2)
+    QList<quint8> surah;    ///< surah number (1-114)
+    QList<quint16> number;  ///< verse number in surah
+    QList<quint8> juz;      ///< juz number (1-30)
+  };
+
+  const Configuration& m_config;
+  VerseTable m_table;
+  QStringList m_surahNames;
+  QStringList m_surahNamesAr;
+  /**
+   * @brief index of the active QCF version in the VerseTable page arrays
+   */
+  int m_version;
+  /**
+   * @brief in-memory index of the verse texts answering verse searches
+   */
+  VerseSearchEngine m_searchEngine;
+  /**
+   * @brief fills the verse table from the generated QuranMetadata tables
+   */
+  void loadTable();
+  /**
+   * @brief construct a Verse from the table entry at the given index
+   * @param idx - 0-based verse index (verse id - 1)
+   * @return Verse instance using the active QCF version page
+   */
+  Verse verseAt(int idx) const;
+  /**
+   * @brief get the 0-based table index for a verse
+   * @param surahIdx - sura number
+   * @param verse - verse number
+   * @return table index, -1 if the verse is out of range
+   */
+  int indexOf(int surahIdx, int verse) const;
+
+protected:
+  const VerseSearchEngine& searchEngine() const override;
+
+public:
+  QuranServiceMemoryImpl();
+
+  QPair<int, int> pageMetadata(const int page) const override;
+
+  std::optional<QPair<int, int>> getRubStartingInPage(
+    const int page) const override;
+
+  int getVersePage(const int& surahIdx, const int& verse) const override;
+
+  Verse getJuzStart(const int juz) const override;
+
+  int getVerseJuz(const Verse verse) const override;
+
+  QList<Verse> verseInfoList(const int page) const override;
+
+  Verse firstInPage(int page) const override;
+
+  QString verseText(const int sIdx, const int vIdx) const override;
+
+  QStringList verseTexts(const int surah,
+                         const int from,
+                         const int to) const override;
+
+  QStringList verseTextsById(const QList<int>& ids) const override;
+
+  QList<Verse> verseInfoRange(const int fromId,
+                              const int toId) const override;
+
+  QStringList pageVerseTexts(const int page) const override;
+
+  int surahStartPage(int surahIdx) const override;
+
+  QString surahName(const int sIdx, bool ar) const override;
+
+  Verse verseById(const int id) const override;
+
+  int versePage(const int& surahIdx, const int& verse) const override;
+
+  QList<int> searchSurahNames(QString text) const override;
+
+  QList<Verse> searchSurahs(QString searchText,
+                            const QList<int> surahs,
+                            const bool whole) const override;
+
+  QList<Verse> searchVerses(QString searchText,
+                            const int range[],
+                            const bool whole) const override;
+
+  QString searchBackend() const override;
+
+  Verse randomVerse() const override;
+
+  QStringList surahNames() const override;
+
+  Verse next(const Verse& verse, bool withBasmallah) const override;
+
+  Verse previous(const Verse& verse, bool withBasmallah) const override;
+};
+
+#endif // QURANSERVICEMEMORYIMPL_H
@@ -1,9 +1,7 @@
 #include "quranservicesqlimpl.h"
+#include <repository/searchindexrepository.h>
 
-QuranServiceSqlImpl::QuranServiceSqlImpl()
-  : m_quranRepository(QuranRepository::getInstance())
-{
-}
+QuranServiceSqlImpl::QuranServiceSqlImpl() {}
 
 QPair<int, int>
 QuranServiceSqlImpl::pageMetadata(const int page) const
@@ -59,6 +57,32 @@ QuranServiceSqlImpl::verseText(const int sIdx, const int vIdx) const
   return m_quranRepository.verseText(sIdx, vIdx);
 }
 
+QStringList
+QuranServiceSqlImpl::verseTexts(const int surah,
+                                const int from,
+                                const int to) const
+{
+  return m_quranRepository.verseTexts(surah, from, to);
+}
+
+QStringList
+QuranServiceSqlImpl::verseTextsById(const QList<int>& ids) const
+{
+  return m_quranRepository.verseTextsById(ids);
+}
+
+QList<Verse>
+QuranServiceSqlImpl::verseInfoRange(const int fromId, const int toId) const
+{
+  return m_quranRepository.verseInfoRange(fromId, toId);
+}
+
+QStringList
+QuranServiceSqlImpl::pageVerseTexts(const int page) const
+{
+  return m_quranRepository.pageVerseTexts(page);
+}
+
 int
 QuranServiceSqlImpl::surahStartPage(int surahIdx) const
 {
@@ -105,6 +129,24 @@ QuranServiceSqlImpl::searchVerses(QString searchText,
   return m_quranRepository.searchVerses(searchText, range, whole);
 }
 
+QString
+QuranServiceSqlImpl::searchBackend() const
+{
+  // the database falls back to LIKE until the FTS index is built
+  return SearchIndexRepository::getInstance().isReady() ? "fts" : "like";
+}
+
+const VerseSearchEngine&
+QuranServiceSqlImpl::searchEngine() const
+{
+  // approximate matching and refinement need the whole corpus in memory,
+  // build it on first use
+  static const VerseSearchEngine engine(
+    m_quranRepository.emlaeyTexts(),
+    Configuration::getInstance().qcfVersion());
+  return engine;
+}
+
 Verse
 QuranServiceSqlImpl::randomVerse() const
 {
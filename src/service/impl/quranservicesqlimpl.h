@@ -1,13 +1,16 @@
 #ifndef QURANSERVICESQLIMPL_H
 #define QURANSERVICESQLIMPL_H
 
-#include <repository/quranrepository.h>
-#include <service/quranservice.h>
+#include <service/impl/quranservicebase.h>
 
-class QuranServiceSqlImpl : public QuranService
+class QuranServiceSqlImpl : public QuranServiceBase
 {
-private:
-  QuranRepository& m_quranRepository;
+protected:
+  /**
+   * @brief in-memory index of the verse texts, built on first use by the
+   * searches the database can't answer
+   */
+  const VerseSearchEngine& searchEngine() const override;
 
 public:
   QuranServiceSqlImpl();
@@ -29,6 +32,17 @@ public:
 
   QString verseText(const int sIdx, const int vIdx) const override;
 
+  QStringList verseTexts(const int surah,
+                         const int from,
+                         const int to) const override;
+
+  QStringList verseTextsById(const QList<int>& ids) const override;
+
+  QList<Verse> verseInfoRange(const int fromId,
+                              const int toId) const override;
+
+  QStringList pageVerseTexts(const int page) const override;
+
   int surahStartPage(int surahIdx) const override;
 
   QString surahName(const int sIdx, bool ar) const override;
@@ -47,6 +61,8 @@ public:
                             const int range[],
                             const bool whole) const override;
 
+  QString searchBackend() const override;
+
   Verse randomVerse() const override;
 
   QStringList surahNames() const override;
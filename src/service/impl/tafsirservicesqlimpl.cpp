@@ -28,3 +28,28 @@ TafsirServiceSqlImpl::currTafsir() const
 {
   return m_tafsirRepository.currTafsir();
 }
+
+QList<int>
+TafsirServiceSqlImpl::searchTafsir(QString searchText,
+                                   QString id,
+                                   const bool whole) const
+{
+  std::optional<Tafsir> tafsir = Tafsir::findById(id);
+  if (!tafsir.has_value())
+    return {};
+  return TafsirSearchRepository::getInstance().search(
+    searchText, tafsir.value(), whole);
+}
+
+QList<TafsirSnippet>
+TafsirServiceSqlImpl::tafsirSnippets(const QStringList& phrases,
+                                     QString id,
+                                     const QList<int>& verses,
+                                     const bool whole) const
+{
+  std::optional<Tafsir> tafsir = Tafsir::findById(id);
+  if (!tafsir.has_value())
+    return {};
+  return TafsirSearchRepository::getInstance().snippets(
+    phrases, tafsir.value(), whole, verses);
+}
@@ -2,6 +2,7 @@
 #define TAFSIRSERVICESQLIMPL_H
 
 #include <repository/tafsirrepository.h>
+#include <repository/tafsirsearchrepository.h>
 #include <service/tafsirservice.h>
 
 class TafsirServiceSqlImpl : public TafsirService
@@ -19,6 +20,15 @@ public:
   QString getTafsir(const int sIdx, const int vIdx) override;
 
   std::optional<const Tafsir> currTafsir() const override;
+
+  QList<int> searchTafsir(QString searchText,
+                          QString id,
+                          const bool whole = false) const override;
+
+  QList<TafsirSnippet> tafsirSnippets(const QStringList& phrases,
+                                      QString id,
+                                      const QList<int>& verses,
+                                      const bool whole = false) const override;
 };
 
 #endif // TAFSIRSERVICESQLIMPL_H
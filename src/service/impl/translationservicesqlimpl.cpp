@@ -1,4 +1,5 @@
 #include "translationservicesqlimpl.h"
+#include <repository/translationsearchrepository.h>
 
 TranslationServiceSqlImpl::TranslationServiceSqlImpl()
   : m_translationRepository(TranslationRepository::getInstance())
@@ -17,6 +18,12 @@ TranslationServiceSqlImpl::getTranslation(const int sIdx, const int vIdx) const
   return m_translationRepository.getTranslation(sIdx, vIdx);
 }
 
+QStringList
+TranslationServiceSqlImpl::translationsForPage(const int page) const
+{
+  return m_translationRepository.translationsForPage(page);
+}
+
 std::optional<const Translation>
 TranslationServiceSqlImpl::currTranslation() const
 {
@@ -28,3 +35,19 @@ TranslationServiceSqlImpl::loadTranslation()
 {
   return m_translationRepository.loadTranslation();
 }
+
+QList<int>
+TranslationServiceSqlImpl::searchTranslations(QString searchText,
+                                              const QStringList& ids,
+                                              const bool whole) const
+{
+  QList<Translation> translations;
+  for (const QString& id : ids) {
+    std::optional<Translation> translation = Translation::findById(id);
+    if (translation.has_value())
+      translations.append(translation.value());
+  }
+
+  return TranslationSearchRepository::getInstance().search(
+    searchText, translations, whole);
+}
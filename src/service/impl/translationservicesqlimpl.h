@@ -17,9 +17,15 @@ public:
 
   QString getTranslation(const int sIdx, const int vIdx) const override;
 
+  QStringList translationsForPage(const int page) const override;
+
   std::optional<const Translation> currTranslation() const override;
 
   void loadTranslation() override;
+
+  QList<int> searchTranslations(QString searchText,
+                                const QStringList& ids,
+                                const bool whole) const override;
 };
 
 #endif // TRANSLATIONSERVICESQLIMPL_H
@@ -1,8 +1,12 @@
 #ifndef QURANSERVICE_H
 #define QURANSERVICE_H
 
+#include <QFuture>
+#include <QHash>
 #include <QList>
 #include <QPair>
+#include <search/concordance.h>
+#include <search/positionalindex.h>
 #include <types/verse.h>
 
 class QuranService
@@ -61,6 +65,36 @@ public:
    * @return QString of the verse text
    */
   virtual QString verseText(const int sIdx, const int vIdx) const = 0;
+  /**
+   * @brief gets the texts of a range of verses in a surah at once
+   * @param surah - sura number (1-114)
+   * @param from - first verse number
+   * @param to - last verse number
+   * @return QStringList of the verse texts in order
+   */
+  virtual QStringList verseTexts(const int surah,
+                                 const int from,
+                                 const int to) const = 0;
+  /**
+   * @brief gets the texts of any set of verses at once
+   * @param ids - QList of verse ids (1-6236)
+   * @return QStringList of the verse texts in the order of the ids
+   */
+  virtual QStringList verseTextsById(const QList<int>& ids) const = 0;
+  /**
+   * @brief gets the Verse instances of a range of verse ids at once
+   * @param fromId - first verse id (1-6236)
+   * @param toId - last verse id
+   * @return QList of Verse instances in mushaf order
+   */
+  virtual QList<Verse> verseInfoRange(const int fromId,
+                                      const int toId) const = 0;
+  /**
+   * @brief gets the texts of all verses of a page at once
+   * @param page - Quran page number
+   * @return QStringList of the verse texts in the order of the page verses
+   */
+  virtual QStringList pageVerseTexts(const int page) const = 0;
   /**
    * @brief gets the page where the surah begins
    * @param surahIdx - sura number
@@ -115,6 +149,149 @@ public:
   virtual QList<Verse> searchVerses(QString searchText,
                                     const int range[2] = new int[2]{ 1, 604 },
                                     const bool whole = false) const = 0;
+  /**
+   * @brief get the name of the backend answering verse searches at the
+   * moment, backends differ in how whole words match at verse edges so their
+   * results are cached apart
+   * @return QString of the backend name
+   */
+  virtual QString searchBackend() const = 0;
+  /**
+   * @brief search all verses for approximate matches of the given text,
+   * ignoring diacritics and tolerating a few mistyped letters
+   * @param searchText - text to search for
+   * @return QList of Verse instances ordered by the number of edits
+   */
+  virtual QList<Verse> searchApproximate(QString searchText) const = 0;
+  /**
+   * @brief find the occurrences of an exact phrase of whole words
+   * @param searchText - phrase to search for
+   * @param crossVerse - boolean value to allow the phrase to continue into
+   * the next verse
+   * @return QList of WordSpan of the matched words ordered by position
+   */
+  virtual QList<WordSpan> searchPhrase(QString searchText,
+                                       const bool crossVerse = false) const = 0;
+  /**
+   * @brief find two phrases occurring within a number of words of each other
+   * in the same verse
+   * @param first - first phrase to search for
+   * @param second - second phrase to search for
+   * @param distance - maximum number of words between the phrases
+   * @return QList of WordSpan covering both phrases ordered by position
+   */
+  virtual QList<WordSpan> searchNear(QString first,
+                                     QString second,
+                                     const int distance) const = 0;
+  /**
+   * @brief order search results by their BM25 relevance to the search text
+   * @param verses - search results in mushaf order
+   * @param searchText - searched text
+   * @param whole - boolean value to count whole word occurrences only
+   * @param limit - number of most relevant verses to move to the front
+   * @return QList of the given verses, the most relevant first followed by
+   * the rest in mushaf order
+   */
+  virtual QList<Verse> rankSearch(const QList<Verse>& verses,
+                                  QString searchText,
+                                  const bool whole = false,
+                                  const int limit = 100) const = 0;
+  /**
+   * @brief narrow down previous search results to the verses matching the
+   * given text, used when the search text is extended while typing
+   * @param verses - previous search results
+   * @param searchText - text to search for
+   * @param whole - boolean value to search for whole words only
+   * @return QList of the given verses matching the search text, in order
+   */
+  virtual QList<Verse> refineSearch(const QList<Verse>& verses,
+                                    QString searchText,
+                                    const bool whole = false) const = 0;
+  /**
+   * @brief locate the searched phrases in the result verses of a search
+   * @details phrases are matched against the word positions of the
+   * normalized emlaey text the way the search matched them, meant to run
+   * with the search on a worker thread
+   * @param verses - result verses to locate the phrases in
+   * @param phrases - searched words or phrases
+   * @param whole - boolean value to match whole words only
+   * @param crossVerse - boolean value to let phrases run into the next verse
+   * @return QHash of the first word offset and the number of words of each
+   * match by verse id, partial matches cover their whole words
+   */
+  virtual QHash<int, QList<QPair<int, int>>> matchedWords(
+    const QList<Verse>& verses,
+    const QStringList& phrases,
+    const bool whole = false,
+    const bool crossVerse = false) const = 0;
+  /**
+   * @brief map the matched words of a verse to the displayed text
+   * @details words are mapped through a TextAlignment to the displayed verse
+   * text variant, the alignment of the current verse type is computed for all
+   * verses on first use
+   * @param verse - verse the words are matched in
+   * @param displayed - displayed text of the verse, verse text or QCF glyphs
+   * @param words - first word offset and number of words of each match, from
+   * QuranService::matchedWords
+   * @return QList of the start and length of the matched spans in the
+   * displayed text
+   */
+  virtual QList<QPair<int, int>> matchSpans(
+    const Verse& verse,
+    const QString& displayed,
+    const QList<QPair<int, int>>& words) const = 0;
+  /**
+   * @brief find the verses worded most like the given verse (mutashabihat)
+   * @details candidates are found through the MinHash/LSH SimilarityIndex
+   * and re-scored by the exact Jaccard similarity of their word bigrams, the
+   * index is loaded or built on first use, which waits for it
+   * @param verse - verse to find similar verses for
+   * @param limit - maximum number of returned verses
+   * @return QList of similar verses, the most similar first
+   */
+  virtual QList<Verse> similarVerses(const Verse& verse,
+                                     const int limit = 20) const = 0;
+  /**
+   * @brief start writing and mapping the concordance in the background, if
+   * not already started
+   * @details a concordance that couldn't be prepared isn't retried
+   * @return QFuture holding true once the concordance is open
+   */
+  virtual QFuture<bool> prepareConcordance() const = 0;
+  /**
+   * @brief get the word frequencies and occurrences of the whole mushaf
+   * @details the concordance file is written from the verse texts on first
+   * use and mapped, lookups don't query the database. Waits for the
+   * concordance if it is being prepared
+   * @return reference to the Concordance, not open if it couldn't be prepared
+   */
+  virtual const Concordance& concordance() const = 0;
+  /**
+   * @brief check whether a morphology dataset is installed for searching by
+   * root or lemma, the dataset isn't read
+   */
+  virtual bool hasMorphology() const = 0;
+  /**
+   * @brief find the verses containing a word of the same root or lemma as
+   * every word of the given text
+   * @details the morphology dataset is compiled and mapped on first use,
+   * words missing from the dataset match no verse
+   * @param searchText - words or roots to search for
+   * @param lemma - boolean value to match lemmas instead of roots
+   * @return ascending QList of verse ids
+   */
+  virtual QList<int> searchMorphology(QString searchText,
+                                      const bool lemma = false) const = 0;
+  /**
+   * @brief get the words of the mushaf sharing the root or lemma of a word
+   * @details the morphology dataset is compiled and mapped on first use
+   * @param word - word, root or lemma to get the forms of
+   * @param lemma - boolean value to group by lemma instead of root
+   * @return QStringList of the normalized words, empty if the word is missing
+   * from the dataset
+   */
+  virtual QStringList morphologyForms(QString word,
+                                      const bool lemma = false) const = 0;
   /**
    * @brief gets a random verse from the Quran
    * @return QPair of Verse instance and verse text
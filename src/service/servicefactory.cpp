@@ -3,6 +3,7 @@
 #include <service/impl/bookmarkservicesqlimpl.h>
 #include <service/impl/glyphservicesqlimpl.h>
 #include <service/impl/khatmahservicesqlimpl.h>
+#include <service/impl/quranservicememoryimpl.h>
 #include <service/impl/quranservicesqlimpl.h>
 #include <service/impl/tafsirservicesqlimpl.h>
 #include <service/impl/thoughtsservicesqlimpl.h>
@@ -11,8 +12,11 @@
 QuranService*
 ServiceFactory::quranService()
 {
-  static QuranServiceSqlImpl quranService = QuranServiceSqlImpl();
-  return (QuranService*)&quranService;
+  static QuranService* quranService =
+    Configuration::getInstance().settings().value("InMemoryQuran").toBool()
+      ? (QuranService*)new QuranServiceMemoryImpl()
+      : (QuranService*)new QuranServiceSqlImpl();
+  return quranService;
 }
 
 GlyphService*
@@ -29,6 +29,31 @@ public:
    * @return pointer to the currently selected Tafasir
    */
   virtual std::optional<const Tafsir> currTafsir() const = 0;
+  /**
+   * @brief search the tafsir of all verses, a tafsir that was never searched
+   * is indexed first
+   * @param searchText - text to search for
+   * @param id - id of the tafsir to search
+   * @param whole - boolean value to search for whole words only
+   * @return ascending QList of the ids of the verses whose tafsir matches
+   */
+  virtual QList<int> searchTafsir(QString searchText,
+                                  QString id,
+                                  const bool whole = false) const = 0;
+  /**
+   * @brief get excerpts of the tafsir of the given verses around the matches
+   * of a search done with TafsirService::searchTafsir
+   * @param phrases - the searched phrases, excerpts show any of them
+   * @param id - id of the searched tafsir
+   * @param verses - ids of the verses to get excerpts for
+   * @param whole - boolean value to match whole words only
+   * @return QList of TafsirSnippet with the offsets of the matches
+   */
+  virtual QList<TafsirSnippet> tafsirSnippets(
+    const QStringList& phrases,
+    QString id,
+    const QList<int>& verses,
+    const bool whole = false) const = 0;
 };
 
 #endif
@@ -22,6 +22,13 @@ public:
    * @return QString containing the verse translation
    */
   virtual QString getTranslation(const int sIdx, const int vIdx) const = 0;
+  /**
+   * @brief gets the translations of all verses of a page at once using the
+   * active translation
+   * @param page - Quran page number
+   * @return QStringList of the translations in the order of the page verses
+   */
+  virtual QStringList translationsForPage(const int page) const = 0;
   /**
    * @brief getter for m_currTr
    * @return pointer to the currently selected translation
@@ -31,6 +38,18 @@ public:
    * @brief set translation to the one in the settings, update the selected db
    */
   virtual void loadTranslation() = 0;
+  /**
+   * @brief search the text of several translations at once, translations
+   * that were never searched are indexed first
+   * @param searchText - text to search for
+   * @param ids - ids of the translations to search, unavailable ones are
+   * skipped
+   * @param whole - boolean value to search for whole words only
+   * @return ascending QList of the ids of the matching verses
+   */
+  virtual QList<int> searchTranslations(QString searchText,
+                                        const QStringList& ids,
+                                        const bool whole = false) const = 0;
 };
 
 #endif
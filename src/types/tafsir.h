@@ -3,6 +3,7 @@
 
 #include "content.h"
 #include <QList>
+#include <QPair>
 #include <QSharedPointer>
 #include <QString>
 
@@ -29,4 +30,14 @@ private:
   bool m_isText;
 };
 
+/**
+ * @brief excerpt of a verse tafsir matching a search
+ */
+struct TafsirSnippet
+{
+  int verse;                      ///< verse id
+  QString text;                   ///< plain text excerpt around the matches
+  QList<QPair<int, int>> matches; ///< start and length of matches in text
+};
+
 #endif // TAFSIR_H
@@ -12,9 +12,9 @@
 class Verse
 {
 public:
-  static const QList<int> verseCount;
   static const int surahVerseCount(int surah);
   static int id(int surah, int verse);
+  static Verse fromId(int id, int qcfVersion);
   static Verse& getCurrent();
   static QList<Verse> fromList(QList<QList<int>> lst);
 
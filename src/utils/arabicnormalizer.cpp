@@ -0,0 +1,53 @@
+#include "arabicnormalizer.h"
+
+QString
+ArabicNormalizer::normalize(const QString& text)
+{
+  QString normalized;
+  normalized.reserve(text.size());
+  bool pendingSpace = false;
+
+  for (const QChar c : text) {
+    const char16_t u = c.unicode();
+    if (c.isSpace()) {
+      pendingSpace = !normalized.isEmpty();
+      continue;
+    }
+
+    // tashkeel, superscript alef, tatweel and Quranic annotation marks
+    if ((u >= 0x064B && u <= 0x065F) || u == 0x0670 || u == 0x0640 ||
+        (u >= 0x06D6 && u <= 0x06ED))
+      continue;
+
+    if (pendingSpace) {
+      normalized.append(' ');
+      pendingSpace = false;
+    }
+
+    switch (u) {
+      case 0x0622: // alef with madda
+      case 0x0623: // alef with hamza above
+      case 0x0625: // alef with hamza below
+      case 0x0671: // alef wasla
+        normalized.append(QChar(0x0627));
+        break;
+      case 0x0649: // alef maqsura
+        normalized.append(QChar(0x064A));
+        break;
+      case 0x0629: // ta marbuta
+        normalized.append(QChar(0x0647));
+        break;
+      default:
+        normalized.append(c);
+        break;
+    }
+  }
+
+  return normalized;
+}
+
+QStringList
+ArabicNormalizer::tokens(const QString& text)
+{
+  return normalize(text).split(' ', Qt::SkipEmptyParts);
+}
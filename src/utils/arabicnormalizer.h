@@ -0,0 +1,35 @@
+#ifndef ARABICNORMALIZER_H
+#define ARABICNORMALIZER_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @class ArabicNormalizer
+ * @brief Normalizes Arabic text for searching.
+ *
+ * Strips tashkeel, Quranic annotation marks and tatweel, and folds the
+ * letter variants users commonly type interchangeably: alef with hamza or
+ * madda and alef wasla become a bare alef, alef maqsura becomes ya, and ta
+ * marbuta becomes ha. Indexed text and search queries must go through the
+ * same normalization.
+ */
+class ArabicNormalizer
+{
+public:
+  /**
+   * @brief Normalizes the given text, whitespace is collapsed to a single
+   * space.
+   * @param text Arabic text to normalize.
+   * @return QString of the normalized text.
+   */
+  static QString normalize(const QString& text);
+  /**
+   * @brief Splits the given text into normalized tokens.
+   * @param text Arabic text to tokenize.
+   * @return QStringList of normalized tokens.
+   */
+  static QStringList tokens(const QString& text);
+};
+
+#endif // ARABICNORMALIZER_H
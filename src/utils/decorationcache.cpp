@@ -0,0 +1,98 @@
+#include "decorationcache.h"
+#include <QPainter>
+#include <generated/quranmetadata.h>
+
+bool
+DecorationCache::Key::operator==(const Key& other) const
+{
+  return surah == other.surah && darkMode == other.darkMode &&
+         width == other.width;
+}
+
+size_t
+qHash(const DecorationCache::Key& key, size_t seed)
+{
+  return qHashMulti(seed, key.surah, key.darkMode, key.width);
+}
+
+DecorationCache&
+DecorationCache::getInstance()
+{
+  static DecorationCache decorationCache;
+  return decorationCache;
+}
+
+DecorationCache::DecorationCache()
+{
+  m_scaled.setMaxCost(capacityKiB);
+}
+
+QImage
+DecorationCache::surahFrame(int surah, bool darkMode, int width)
+{
+  const Key key{ surah, darkMode, width };
+  if (std::optional<QImage> cached = find(key))
+    return *cached;
+
+  // construct the text to be put inside the frame
+  QString frmText;
+  frmText.append("ﰦ");
+  frmText.append("ﮌ");
+  frmText.append(QString::fromUtf8(QuranMetadata::surahNameGlyphs[surah - 1]));
+
+  // draw the surah name on top of the empty frame, the text is drawn inverted
+  // on the inverted frame of the dark theme
+  QImage frame = themed(":/resources/sura_box.png", darkMode);
+  QPainter p(&frame);
+  p.setPen(QPen(darkMode ? Qt::white : Qt::black));
+  p.setFont(QFont("QCF_BSML", 85));
+  p.drawText(frame.rect(), Qt::AlignCenter, frmText);
+  p.end();
+
+  const QImage scaled = frame.scaledToWidth(width, Qt::SmoothTransformation);
+  insert(key, scaled);
+  return scaled;
+}
+
+QImage
+DecorationCache::basmalah(bool darkMode, int width)
+{
+  const Key key{ 0, darkMode, width };
+  if (std::optional<QImage> cached = find(key))
+    return *cached;
+
+  const QImage scaled = themed(":/resources/basmalah.png", darkMode)
+                          .scaledToWidth(width, Qt::SmoothTransformation);
+  insert(key, scaled);
+  return scaled;
+}
+
+QImage
+DecorationCache::themed(const QString& resource, bool darkMode)
+{
+  QMutexLocker locker(&m_lock);
+  QImage& image = m_themed[{ resource, darkMode }];
+  if (image.isNull()) {
+    image.load(resource);
+    if (darkMode)
+      image.invertPixels();
+  }
+  return image;
+}
+
+std::optional<QImage>
+DecorationCache::find(const Key& key)
+{
+  QMutexLocker locker(&m_lock);
+  if (const QImage* image = m_scaled.object(key))
+    return *image;
+  return std::nullopt;
+}
+
+void
+DecorationCache::insert(const Key& key, const QImage& image)
+{
+  QMutexLocker locker(&m_lock);
+  m_scaled.insert(
+    key, new QImage(image), std::max<qsizetype>(image.sizeInBytes() / 1024, 1));
+}
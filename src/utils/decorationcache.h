@@ -0,0 +1,73 @@
+#ifndef DECORATIONCACHE_H
+#define DECORATIONCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <optional>
+
+/**
+ * @class DecorationCache
+ * @brief Cache of the rendered decoration images of Quran pages.
+ *
+ * Surah name frames and the basmalah are rendered once per surah, theme and
+ * target width, later pages showing them reuse the scaled images. The empty
+ * frame and the basmalah are loaded and inverted for the dark theme once per
+ * theme, so a zoom change only paints and scales the images again. Scaled
+ * images are kept in a least recently used cache bounded by their memory,
+ * images of other sizes and themes stay cached until they are the least
+ * recently used. All methods are thread safe.
+ */
+class DecorationCache
+{
+public:
+  /**
+   * @brief Maximum memory of the scaled images in KiB.
+   */
+  static const int capacityKiB = 16 * 1024;
+  static DecorationCache& getInstance();
+  /**
+   * @brief Gets the frame containing the surah name.
+   * @param surah The surah number.
+   * @param darkMode True to get the frame of the dark theme.
+   * @param width The width the frame is scaled to.
+   * @return QImage of the surah frame.
+   */
+  QImage surahFrame(int surah, bool darkMode, int width);
+  /**
+   * @brief Gets the basmalah image.
+   * @param darkMode True to get the image of the dark theme.
+   * @param width The width the image is scaled to.
+   * @return QImage of the basmalah.
+   */
+  QImage basmalah(bool darkMode, int width);
+
+private:
+  /**
+   * @brief Identifies a scaled image, surah 0 is the basmalah.
+   */
+  struct Key
+  {
+    int surah;
+    bool darkMode;
+    int width;
+    bool operator==(const Key& other) const;
+  };
+  friend size_t qHash(const Key& key, size_t seed);
+  DecorationCache();
+  /**
+   * @brief Gets a resource image inverted for the dark theme, loaded once per
+   * theme.
+   */
+  QImage themed(const QString& resource, bool darkMode);
+  std::optional<QImage> find(const Key& key);
+  void insert(const Key& key, const QImage& image);
+  QCache<Key, QImage> m_scaled;
+  QHash<QPair<QString, bool>, QImage> m_themed;
+  QMutex m_lock;
+};
+
+#endif // DECORATIONCACHE_H
@@ -0,0 +1,53 @@
+#include "fontmetricscache.h"
+#include <QFontMetrics>
+
+FontMetricsCache&
+FontMetricsCache::getInstance()
+{
+  static FontMetricsCache fontMetricsCache;
+  return fontMetricsCache;
+}
+
+int
+FontMetricsCache::height(const QString& family, int size)
+{
+  {
+    QMutexLocker locker(&m_lock);
+    const int cached = m_metrics.value({ family, size }).height;
+    if (cached != -1)
+      return cached;
+  }
+
+  // measured without the lock, a concurrent measurement gives the same value
+  const int height = QFontMetrics(QFont(family, size)).height();
+  QMutexLocker locker(&m_lock);
+  m_metrics[{ family, size }].height = height;
+  return height;
+}
+
+QSize
+FontMetricsCache::lineSize(const QString& family,
+                           int size,
+                           int page,
+                           const QString& line)
+{
+  {
+    QMutexLocker locker(&m_lock);
+    auto it = m_metrics.constFind({ family, size });
+    if (it != m_metrics.cend() && it->lineSizes.contains(page))
+      return it->lineSizes.value(page);
+  }
+
+  const QSize lineSize =
+    QFontMetrics(QFont(family, size)).size(Qt::TextSingleLine, line);
+  QMutexLocker locker(&m_lock);
+  m_metrics[{ family, size }].lineSizes.insert(page, lineSize);
+  return lineSize;
+}
+
+void
+FontMetricsCache::precompute(const QString& family, int minSize, int maxSize)
+{
+  for (int size = minSize; size <= maxSize; size++)
+    height(family, size);
+}
@@ -0,0 +1,64 @@
+#ifndef FONTMETRICSCACHE_H
+#define FONTMETRICSCACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QSize>
+#include <QString>
+
+/**
+ * @class FontMetricsCache
+ * @brief Cache of the font metrics used to size Quran pages.
+ *
+ * Constructing QFontMetrics resolves the font engine of the family and size
+ * every time, which adds up when the page font size is fitted to the window
+ * on each resize. The cache keeps the line height of each (family, size) and
+ * the measured line size of each page, so fitting the font size of a page
+ * already seen costs a few hash lookups. All methods are thread safe.
+ */
+class FontMetricsCache
+{
+public:
+  static FontMetricsCache& getInstance();
+  /**
+   * @brief Gets the line height of a font.
+   * @param family The font family.
+   * @param size The point size.
+   * @return QFontMetrics::height() of the font.
+   */
+  int height(const QString& family, int size);
+  /**
+   * @brief Gets the size of a single line of a page.
+   * @param family The font family.
+   * @param size The point size.
+   * @param page The page number the line is measured for.
+   * @param line The measured line, only measured the first time the page is
+   * requested for the font.
+   * @return QFontMetrics::size() of the line.
+   */
+  QSize lineSize(const QString& family,
+                 int size,
+                 int page,
+                 const QString& line);
+  /**
+   * @brief Computes the line heights of a font for a range of sizes ahead of
+   * their use.
+   * @param family The font family.
+   * @param minSize The smallest point size.
+   * @param maxSize The largest point size.
+   */
+  void precompute(const QString& family, int minSize, int maxSize);
+
+private:
+  FontMetricsCache() = default;
+  struct Metrics
+  {
+    int height = -1;
+    QHash<int, QSize> lineSizes; ///< measured line size by page
+  };
+  QHash<QPair<QString, int>, Metrics> m_metrics;
+  QMutex m_lock;
+};
+
+#endif // FONTMETRICSCACHE_H
@@ -0,0 +1,110 @@
+#include "htmlstripper.h"
+
+/**
+ * @brief true if the tag contents (without the angle brackets) open or close
+ * one of the given elements
+ */
+static bool
+isElement(QStringView tag, std::initializer_list<QStringView> names)
+{
+  if (tag.startsWith('/'))
+    tag = tag.mid(1);
+  for (QStringView name : names) {
+    if (tag.size() >= name.size() &&
+        tag.left(name.size()).compare(name, Qt::CaseInsensitive) == 0 &&
+        (tag.size() == name.size() || !tag.at(name.size()).isLetterOrNumber()))
+      return true;
+  }
+  return false;
+}
+
+QString
+HtmlStripper::strip(QStringView html)
+{
+  QString text;
+  text.reserve(html.size());
+
+  qsizetype i = 0;
+  while (i < html.size()) {
+    const QChar c = html.at(i);
+    if (c == '&' && decodeEntity(html, i, text))
+      continue;
+    if (c != '<') {
+      text.append(c);
+      i++;
+      continue;
+    }
+
+    const qsizetype end = html.indexOf('>', i + 1);
+    if (end < 0)
+      break;
+    const QStringView tag = html.mid(i + 1, end - i - 1);
+    i = end + 1;
+
+    // script and style bodies are not text
+    if (!tag.startsWith('/') && isElement(tag, { u"script", u"style" })) {
+      const QStringView close = isElement(tag, { u"style" })
+                                  ? QStringView(u"</style")
+                                  : QStringView(u"</script");
+      const qsizetype next = html.indexOf(close, i, Qt::CaseInsensitive);
+      i = next < 0 ? html.size() : next;
+      continue;
+    }
+
+    // inline tags may split a word, block tags never do
+    if (isElement(tag,
+                  { u"br", u"p", u"div", u"li", u"ul", u"ol", u"tr", u"td",
+                    u"th", u"h1", u"h2", u"h3", u"h4", u"h5", u"h6", u"hr",
+                    u"blockquote", u"table" }))
+      text.append(' ');
+  }
+
+  return text;
+}
+
+bool
+HtmlStripper::decodeEntity(QStringView html, qsizetype& pos, QString& text)
+{
+  // the longest supported entity name is 6 characters long
+  const qsizetype end = html.indexOf(';', pos + 1);
+  if (end < 0 || end - pos > 10)
+    return false;
+
+  const QStringView name = html.mid(pos + 1, end - pos - 1);
+  char32_t decoded = 0;
+  if (name.startsWith('#')) {
+    bool ok = false;
+    const bool hex =
+      name.size() > 1 && (name.at(1) == 'x' || name.at(1) == 'X');
+    decoded = name.mid(hex ? 2 : 1).toUInt(&ok, hex ? 16 : 10);
+    if (!ok || decoded > 0x10FFFF)
+      return false;
+  } else if (name == u"amp") {
+    decoded = '&';
+  } else if (name == u"lt") {
+    decoded = '<';
+  } else if (name == u"gt") {
+    decoded = '>';
+  } else if (name == u"quot") {
+    decoded = '"';
+  } else if (name == u"apos") {
+    decoded = '\'';
+  } else if (name == u"nbsp") {
+    decoded = ' ';
+  } else if (name == u"laquo") {
+    decoded = 0x00AB;
+  } else if (name == u"raquo") {
+    decoded = 0x00BB;
+  } else {
+    return false;
+  }
+
+  if (QChar::requiresSurrogates(decoded)) {
+    text.append(QChar(QChar::highSurrogate(decoded)));
+    text.append(QChar(QChar::lowSurrogate(decoded)));
+  } else {
+    text.append(QChar(static_cast<char16_t>(decoded)));
+  }
+  pos = end + 1;
+  return true;
+}
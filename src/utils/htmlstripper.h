@@ -0,0 +1,38 @@
+#ifndef HTMLSTRIPPER_H
+#define HTMLSTRIPPER_H
+
+#include <QString>
+#include <QStringView>
+
+/**
+ * @class HtmlStripper
+ * @brief Extracts the plain text of HTML fragments for indexing.
+ *
+ * Tags are dropped, block-level tags and line breaks become spaces so the
+ * words they separate stay apart, script and style bodies are skipped, and
+ * the named entities common in the content databases as well as numeric
+ * character references are decoded. The input is read in a single pass
+ * without building a document.
+ */
+class HtmlStripper
+{
+public:
+  /**
+   * @brief Strips the markup of the given HTML fragment.
+   * @param html HTML text, malformed markup is tolerated.
+   * @return QString of the plain text.
+   */
+  static QString strip(QStringView html);
+
+private:
+  /**
+   * @brief Decodes the entity starting at html[pos], which is '&'.
+   * @param html HTML text.
+   * @param pos Position of the entity, moved past it if it is decoded.
+   * @param text Output the decoded character is appended to.
+   * @return True if a known entity was decoded.
+   */
+  static bool decodeEntity(QStringView html, qsizetype& pos, QString& text);
+};
+
+#endif // HTMLSTRIPPER_H
@@ -0,0 +1,61 @@
+#include "indexfile.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+QByteArray
+IndexFile::stamp(const QStringList& sourcePaths)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  for (const QString& sourcePath : sourcePaths) {
+    QFile source(sourcePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+      qWarning() << "Couldn't read" << sourcePath;
+      return QByteArray();
+    }
+    // hashed in chunks, tafsir files are too large to read at once
+    hash.addData(&source);
+  }
+  return hash.result().toHex();
+}
+
+bool
+IndexFile::replace(const QString& path,
+                   const std::function<bool(const QString& partPath)>& writer)
+{
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  const QString partPath = path + ".part";
+  QFile::remove(partPath);
+  if (!writer(partPath)) {
+    QFile::remove(partPath);
+    return false;
+  }
+
+  QFile::remove(path);
+  if (!QFile::rename(partPath, path)) {
+    qWarning() << "Couldn't replace" << path;
+    QFile::remove(partPath);
+    return false;
+  }
+  return true;
+}
+
+bool
+IndexFile::write(const QString& path,
+                 const std::function<bool(QIODevice& device)>& writer)
+{
+  return replace(path, [&writer](const QString& partPath) {
+    QFile part(partPath);
+    if (!part.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qWarning() << "Couldn't write" << partPath;
+      return false;
+    }
+    const bool success = writer(part);
+    part.close();
+    if (!success)
+      qWarning() << "Couldn't write" << partPath;
+    return success;
+  });
+}
@@ -0,0 +1,51 @@
+#ifndef INDEXFILE_H
+#define INDEXFILE_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+/**
+ * @class IndexFile
+ * @brief Stamps and writes the files derived from the app data (search
+ * indices, caches and compiled datasets).
+ *
+ * A derived file stores the stamp of the sources it was built from and is
+ * rebuilt when the stamp no longer matches. Files are written next to their
+ * destination with a `.part` suffix and only replace it once complete, so an
+ * interrupted or failed write never leaves a broken file behind.
+ */
+class IndexFile
+{
+public:
+  /**
+   * @brief Computes the stamp of source files.
+   * @param sourcePaths Paths of the files the derived file is built from.
+   * @return Hex SHA-1 of the contents of the files in order, empty if any of
+   * them couldn't be read.
+   */
+  static QByteArray stamp(const QStringList& sourcePaths);
+  /**
+   * @brief Writes a file through a partial file replacing it once complete.
+   * @param path Path of the file, its directory is created if missing.
+   * @param writer Function writing the partial file at the given path,
+   * returning true on success.
+   * @return True if the file was written and replaced.
+   */
+  static bool replace(
+    const QString& path,
+    const std::function<bool(const QString& partPath)>& writer);
+  /**
+   * @brief Writes a file through a partial file replacing it once complete.
+   * @param path Path of the file, its directory is created if missing.
+   * @param writer Function writing to the open partial file, returning true
+   * on success.
+   * @return True if the file was written and replaced.
+   */
+  static bool write(const QString& path,
+                    const std::function<bool(QIODevice& device)>& writer);
+};
+
+#endif // INDEXFILE_H
@@ -0,0 +1,170 @@
+#include "pagedocumentcache.h"
+#include "configuration.h"
+#include <QCoreApplication>
+#include <QImage>
+#include <QTextBlock>
+#include <QUrl>
+#include <QtConcurrent>
+
+/**
+ * @brief rough memory of the layout and format data of a single character,
+ * measured on laid-out QCF pages
+ */
+static const qint64 bytesPerCharacter = 384;
+
+bool
+PageDocumentCache::Key::operator==(const Key& other) const
+{
+  return page == other.page && qcfVersion == other.qcfVersion &&
+         fontSize == other.fontSize && theme == other.theme;
+}
+
+size_t
+qHash(const PageDocumentCache::Key& key, size_t seed)
+{
+  return qHashMulti(seed, key.page, key.qcfVersion, key.fontSize, key.theme);
+}
+
+double
+PageDocumentCache::Statistics::hitRate() const
+{
+  const qint64 lookups = hits + misses;
+  return lookups ? double(hits) / lookups : 0;
+}
+
+PageDocumentCache&
+PageDocumentCache::getInstance()
+{
+  static PageDocumentCache pageDocumentCache;
+  return pageDocumentCache;
+}
+
+PageDocumentCache::PageDocumentCache()
+{
+  m_pool.setMaxThreadCount(2);
+  // queued builds are dropped and running ones finish before the services
+  // and fonts they use are destroyed
+  QObject::connect(qApp, &QCoreApplication::aboutToQuit, [this]() {
+    m_pool.clear();
+    m_pool.waitForDone();
+  });
+  const int mib = Configuration::getInstance()
+                    .settings()
+                    .value("Reader/PageCacheSize", defaultCapacityMiB)
+                    .toInt();
+  setCapacity(qint64(mib) * 1024 * 1024);
+}
+
+std::optional<PageDocumentCache::Page>
+PageDocumentCache::find(const Key& key)
+{
+  QMutexLocker locker(&m_lock);
+  const Page* page = m_pages.object(key);
+  if (!page) {
+    m_misses++;
+    return std::nullopt;
+  }
+
+  m_hits++;
+  return *page;
+}
+
+void
+PageDocumentCache::insert(const Key& key, const Page& page)
+{
+  const qsizetype pageCost = cost(page);
+  QMutexLocker locker(&m_lock);
+  m_pages.insert(key, new Page(page), pageCost);
+}
+
+QFuture<PageDocumentCache::Page>
+PageDocumentCache::build(const Key& key, const std::function<Page()>& builder)
+{
+  QMutexLocker locker(&m_lock);
+  auto it = m_pending.constFind(key);
+  if (it != m_pending.cend())
+    return *it;
+  return startBuild(key, builder);
+}
+
+void
+PageDocumentCache::prefetch(const Key& key,
+                            const std::function<Page()>& builder)
+{
+  QMutexLocker locker(&m_lock);
+  if (m_pages.contains(key) || m_pending.contains(key))
+    return;
+  startBuild(key, builder);
+}
+
+QFuture<PageDocumentCache::Page>
+PageDocumentCache::startBuild(const Key& key,
+                              const std::function<Page()>& builder)
+{
+  // the build can't finish before it is registered, removing it from the
+  // pending builds waits for the lock held by the caller
+  QFuture<Page> future = QtConcurrent::run(&m_pool, [this, key, builder]() {
+    const Page page = builder();
+    insert(key, page);
+    QMutexLocker locker(&m_lock);
+    m_pending.remove(key);
+    return page;
+  });
+  m_pending.insert(key, future);
+  return future;
+}
+
+void
+PageDocumentCache::clear()
+{
+  QMutexLocker locker(&m_lock);
+  m_pages.clear();
+}
+
+void
+PageDocumentCache::setCapacity(qint64 bytes)
+{
+  QMutexLocker locker(&m_lock);
+  m_pages.setMaxCost(std::max<qint64>(bytes / 1024, 1));
+}
+
+PageDocumentCache::Statistics
+PageDocumentCache::statistics() const
+{
+  QMutexLocker locker(&m_lock);
+  return { m_hits, m_misses, int(m_pages.size()), m_pages.totalCost() * 1024 };
+}
+
+void
+PageDocumentCache::logStatistics() const
+{
+  const Statistics stats = statistics();
+  qInfo().nospace() << "Page cache: " << stats.hits << " hits, "
+                    << stats.misses << " misses ("
+                    << qRound(stats.hitRate() * 100) << "% hit rate), "
+                    << stats.entries << " pages, " << stats.bytes / 1024
+                    << " KiB";
+}
+
+qsizetype
+PageDocumentCache::cost(const Page& page)
+{
+  const QTextDocument* document = page.document.data();
+  if (!document)
+    return 1;
+
+  qint64 bytes = document->characterCount() * bytesPerCharacter;
+  for (QTextBlock block = document->begin(); block.isValid();
+       block = block.next()) {
+    for (auto it = block.begin(); !it.atEnd(); ++it) {
+      const QTextCharFormat format = it.fragment().charFormat();
+      if (!format.isImageFormat())
+        continue;
+      const QImage image = qvariant_cast<QImage>(document->resource(
+        QTextDocument::ImageResource, QUrl(format.toImageFormat().name())));
+      bytes += image.sizeInBytes();
+    }
+  }
+
+  return std::max<qsizetype>(bytes / 1024, 1);
+}
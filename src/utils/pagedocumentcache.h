@@ -0,0 +1,154 @@
+#ifndef PAGEDOCUMENTCACHE_H
+#define PAGEDOCUMENTCACHE_H
+
+#include <QCache>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSharedPointer>
+#include <QSize>
+#include <QStringList>
+#include <QTextDocument>
+#include <QThreadPool>
+#include <functional>
+#include <optional>
+
+/**
+ * @class PageDocumentCache
+ * @brief Least recently used cache of laid-out Quran page documents.
+ *
+ * Holds the QTextDocument of each constructed mushaf page together with the
+ * page data QuranPageBrowser derives while building it, so turning back to a
+ * recently shown page or zoom level swaps the document instead of building
+ * the page again. Pages are keyed by everything that changes their content:
+ * the page number, the QCF version, the font size and the theme.
+ *
+ * Missing pages are built on a small thread pool of the cache, a page
+ * requested while its build is running joins that build, so the page being
+ * read and its prefetched neighbours are never built twice.
+ *
+ * The cache is bounded by the estimated memory of its documents, the least
+ * recently used pages are dropped first. Documents are shared, a page still
+ * shown by a browser outlives its eviction. All methods are thread safe.
+ */
+class PageDocumentCache
+{
+public:
+  /**
+   * @brief Identifies a constructed page.
+   */
+  struct Key
+  {
+    int page;
+    int qcfVersion;
+    int fontSize;
+    int theme; ///< Configuration::themeId() the page colors come from
+    bool operator==(const Key& other) const;
+  };
+  /**
+   * @brief A constructed page and its layout data.
+   */
+  struct Page
+  {
+    QSharedPointer<QTextDocument> document;
+    QList<QPair<int, int>> verseCoordinates; ///< verse bounds in document
+    QSize lineSize;                          ///< average page line size
+    QStringList headerSegments;
+    QStringList footerSegments;
+    QPair<int, int> headerData; ///< surah and juz of the first page verse
+  };
+  /**
+   * @brief Lookup counters of the cache.
+   */
+  struct Statistics
+  {
+    qint64 hits;   ///< number of lookups answered from the cache
+    qint64 misses; ///< number of lookups not found in the cache
+    int entries;   ///< number of cached pages
+    qint64 bytes;  ///< estimated memory of the cached pages
+    /**
+     * @brief Fraction of the lookups answered from the cache.
+     */
+    double hitRate() const;
+  };
+  /**
+   * @brief Default memory bound in MiB, overridden by the
+   * "Reader/PageCacheSize" setting.
+   */
+  static const int defaultCapacityMiB = 48;
+  static PageDocumentCache& getInstance();
+  /**
+   * @brief Looks up a constructed page and marks it as recently used.
+   * @param key The page key.
+   * @return The cached page, std::nullopt if it isn't cached.
+   */
+  std::optional<Page> find(const Key& key);
+  /**
+   * @brief Caches a constructed page, replacing any page with the same key.
+   * @param key The page key.
+   * @param page The constructed page.
+   */
+  void insert(const Key& key, const Page& page);
+  /**
+   * @brief Builds a page on the thread pool and caches it.
+   * @param key The page key.
+   * @param builder Function building the page, called on a worker thread.
+   * @return Future of the built page, the running build if the page is
+   * already being built.
+   */
+  QFuture<Page> build(const Key& key, const std::function<Page()>& builder);
+  /**
+   * @brief Builds a page in the background unless it is cached or already
+   * being built.
+   * @param key The page key.
+   * @param builder Function building the page, called on a worker thread.
+   */
+  void prefetch(const Key& key, const std::function<Page()>& builder);
+  /**
+   * @brief Drops all cached pages.
+   */
+  void clear();
+  /**
+   * @brief Sets the memory bound of the cache, evicting pages as needed.
+   * @param bytes Maximum estimated memory of the cached pages.
+   */
+  void setCapacity(qint64 bytes);
+  Statistics statistics() const;
+  /**
+   * @brief Logs the lookup counters of the cache.
+   */
+  void logStatistics() const;
+
+private:
+  PageDocumentCache();
+  /**
+   * @brief Estimates the memory held by a page in KiB, the unit of the
+   * QCache cost.
+   */
+  static qsizetype cost(const Page& page);
+  /**
+   * @brief Starts building a page, the lock must be held.
+   */
+  QFuture<Page> startBuild(const Key& key,
+                           const std::function<Page()>& builder);
+  QCache<Key, Page> m_pages;
+  /**
+   * @brief Builds running on the pool by page key.
+   */
+  QHash<Key, QFuture<Page>> m_pending;
+  /**
+   * @brief Pool of the page builds, kept small so prefetching doesn't compete
+   * with searches on the global pool.
+   */
+  QThreadPool m_pool;
+  qint64 m_hits = 0;
+  qint64 m_misses = 0;
+  mutable QMutex m_lock;
+};
+
+size_t
+qHash(const PageDocumentCache::Key& key, size_t seed = 0);
+
+#endif // PAGEDOCUMENTCACHE_H
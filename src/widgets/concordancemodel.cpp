@@ -0,0 +1,111 @@
+/**
+ * @file concordancemodel.cpp
+ * @brief Implementation file for ConcordanceModel
+ */
+
+#include "concordancemodel.h"
+#include <QFont>
+#include <generated/quranmetadata.h>
+
+ConcordanceModel::ConcordanceModel(const QStringList& surahNames,
+                                   QObject* parent)
+  : QAbstractTableModel(parent)
+  , m_surahNames(surahNames)
+{
+}
+
+void
+ConcordanceModel::setOccurrences(
+  const Concordance* concordance,
+  const QList<Concordance::Occurrence>& occurrences)
+{
+  beginResetModel();
+  m_concordance = concordance;
+  m_occurrences = occurrences;
+  endResetModel();
+}
+
+const Concordance::Occurrence&
+ConcordanceModel::occurrenceAt(int row) const
+{
+  return m_occurrences.at(row);
+}
+
+int
+ConcordanceModel::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : m_occurrences.size();
+}
+
+int
+ConcordanceModel::columnCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant
+ConcordanceModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || index.row() >= m_occurrences.size())
+    return QVariant();
+
+  const Concordance::Occurrence& occurrence = m_occurrences.at(index.row());
+  if (role == Qt::TextAlignmentRole) {
+    // the context columns hug the keyword column
+    switch (index.column()) {
+      case Before:
+        return int(Qt::AlignTrailing | Qt::AlignVCenter);
+      case Keyword:
+        return int(Qt::AlignCenter);
+      default:
+        return int(Qt::AlignLeading | Qt::AlignVCenter);
+    }
+  }
+  if (role == Qt::FontRole && index.column() == Keyword) {
+    QFont font;
+    font.setBold(true);
+    return font;
+  }
+  if (role != Qt::DisplayRole)
+    return QVariant();
+
+  if (index.column() == Reference) {
+    const int surah = QuranMetadata::surahOf(occurrence.verse);
+    return m_surahNames.value(surah - 1) + ':' +
+           QString::number(occurrence.verse -
+                           QuranMetadata::surahOffset[surah - 1]);
+  }
+
+  const Concordance::Line line =
+    m_concordance->context(occurrence, contextWidth);
+  switch (index.column()) {
+    case Before:
+      return line.before;
+    case Keyword:
+      return line.keyword;
+    default:
+      return line.after;
+  }
+}
+
+QVariant
+ConcordanceModel::headerData(int section,
+                             Qt::Orientation orientation,
+                             int role) const
+{
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    return QAbstractTableModel::headerData(section, orientation, role);
+
+  switch (section) {
+    case Reference:
+      return tr("Verse");
+    case Before:
+      return tr("Before");
+    case Keyword:
+      return tr("Word");
+    case After:
+      return tr("After");
+    default:
+      return QVariant();
+  }
+}
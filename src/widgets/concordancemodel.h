@@ -0,0 +1,71 @@
+/**
+ * @file concordancemodel.h
+ * @brief Header file for ConcordanceModel
+ */
+
+#ifndef CONCORDANCEMODEL_H
+#define CONCORDANCEMODEL_H
+
+#include <QAbstractTableModel>
+#include <search/concordance.h>
+
+/**
+ * @brief ConcordanceModel is a table model of keyword-in-context lines.
+ * @details Each row is an occurrence of the looked up word, with the verse
+ * reference, the words before it, the word itself and the words after it in
+ * separate columns so the keywords line up. Lines are read from the
+ * Concordance when a row is displayed, only the occurrences are held.
+ */
+class ConcordanceModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Columns of the model.
+   */
+  enum Column
+  {
+    Reference, ///< surah name and verse number
+    Before,    ///< words preceding the keyword
+    Keyword,   ///< the occurring word
+    After,     ///< words following the keyword
+    ColumnCount
+  };
+  /**
+   * @brief Class constructor
+   * @param surahNames - names of the surahs shown in the references
+   * @param parent - pointer to parent object
+   */
+  ConcordanceModel(const QStringList& surahNames, QObject* parent = nullptr);
+  /**
+   * @brief Replaces the shown occurrences.
+   * @param concordance - Concordance the lines are read from
+   * @param occurrences - QList of occurrences in mushaf order
+   */
+  void setOccurrences(const Concordance* concordance,
+                      const QList<Concordance::Occurrence>& occurrences);
+  /**
+   * @brief Get the occurrence shown in a row.
+   */
+  const Concordance::Occurrence& occurrenceAt(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section,
+                      Qt::Orientation orientation,
+                      int role = Qt::DisplayRole) const override;
+
+private:
+  /**
+   * @brief Maximum number of words shown on each side of the keyword.
+   */
+  static const int contextWidth = 6;
+  const QStringList m_surahNames;
+  const Concordance* m_concordance = nullptr;
+  QList<Concordance::Occurrence> m_occurrences;
+};
+
+#endif // CONCORDANCEMODEL_H
@@ -4,16 +4,28 @@
  */
 
 #include "quranpagebrowser.h"
+#include <QAbstractTextDocumentLayout>
 #include <QApplication>
 #include <QRegularExpression>
+#include <QTextBlock>
+#include <QTextLayout>
 #include <QtAwesome.h>
+#include <generated/quranmetadata.h>
 #include <service/servicefactory.h>
 #include <utils/fontmanager.h>
+#include <utils/fontmetricscache.h>
+#include <widgets/quranpagebuilder.h>
 using namespace fa;
 
+/**
+ * @brief range of the font sizes fitted to the reader height
+ */
+static const int minFitFontSize = 12;
+static const int maxFitFontSize = 28;
+static const char headerFontFamily[] = "PakType Naskh Basic";
+
 QuranPageBrowser::QuranPageBrowser(QWidget* parent, int initPage)
   : QTextBrowser(parent)
-  , m_highlighter(new QTextCursor(document()))
   , m_highlightColor(QBrush(qApp->palette().color(QPalette::Highlight)))
   , m_config(Configuration::getInstance())
   , m_styleMgr(StyleManager::getInstance())
@@ -28,10 +40,16 @@ QuranPageBrowser::QuranPageBrowser(QWidget* parent, int initPage)
   updateFontSize();
 
   m_pageFont = FontManager::getInstance().getInstance().pageFontname(initPage);
-  m_pageFormat.setAlignment(Qt::AlignCenter);
-  m_pageFormat.setNonBreakableLines(true);
-  m_pageFormat.setLayoutDirection(Qt::RightToLeft);
-  m_pageInfoTextFormat.setFont(QFont("PakType Naskh Basic"));
+  connect(&m_pageWatcher,
+          &QFutureWatcher<PageDocumentCache::Page>::finished,
+          this,
+          &QuranPageBrowser::pageBuilt);
+}
+
+QuranPageBrowser::~QuranPageBrowser()
+{
+  // detach the shared page document before it may be released
+  setDocument(nullptr);
 }
 
 void
@@ -44,296 +62,237 @@ QuranPageBrowser::updateFontSize()
   highlightVerse(m_highlightedIdx);
 }
 
-QSize
-QuranPageBrowser::calcPageLineSize(QStringList& lines)
-{
-  QFontMetrics fm(QFont(m_pageFont, m_fontSize));
-  QString measureLine;
-  if (m_page < 3) {
-    measureLine = lines.at(3);
-  } else if (m_page >= 602 || m_page == 596) {
-    measureLine = lines.at(2);
-  } else {
-    measureLine = lines.at(lines.size() - 2);
-  }
-
-  return fm.size(Qt::TextSingleLine, measureLine.remove(':')) + QSize(0, 5);
-}
-
-QImage
-QuranPageBrowser::surahFrame(int surah)
+void
+QuranPageBrowser::constructPage(int pageNo, bool forceCustomSize)
 {
-  QImage baseImage(":/resources/sura_box.png"); // load the empty frame
+  // the highlight of the previous page is dropped
+  const int highlighted = pageNo == m_page ? m_highlightedIdx : -1;
+  resetHighlight();
+  m_page = pageNo;
+  m_highlightedIdx = highlighted;
 
-  // construct the text to be put inside the frame
-  QString frmText;
-  frmText.append("ﰦ");
-  frmText.append("ﮌ");
-  frmText.append(m_glyphService->getSurahNameGlyph(surah));
+  m_pageFont = FontManager::getInstance().pageFontname(pageNo);
 
-  // draw on top of the image the surah name text
-  QPainter p(&baseImage);
-  p.setPen(QPen(Qt::black));
-  p.setFont(QFont("QCF_BSML", 85));
-  p.drawText(baseImage.rect(), Qt::AlignCenter, frmText);
+  // automatic font adjustment check
+  if (!forceCustomSize &&
+      m_config.settings().value("Reader/AdaptiveFont").toBool()) {
+    m_fontSize = this->bestFitFontSize();
+    m_config.settings().setValue(
+      "Reader/QCF" + QString::number(m_config.qcfVersion()) + "Size",
+      m_fontSize);
+  }
 
-  if (m_config.darkMode())
-    baseImage.invertPixels();
+  const PageDocumentCache::Key key = pageKey(m_page, m_fontSize);
+  PageDocumentCache& cache = PageDocumentCache::getInstance();
+  if (std::optional<PageDocumentCache::Page> page = cache.find(key)) {
+    m_pendingKey.reset();
+    showPage(*page);
+    return;
+  }
 
-  return baseImage;
+  // keep showing the previous page until the new one is built
+  m_pageReady = false;
+  m_pendingKey = key;
+  m_pageWatcher.setFuture(cache.build(key, pageBuilder(key)));
 }
 
-int
-QuranPageBrowser::setHref(QTextCursor* cursor, int to, QString url)
+void
+QuranPageBrowser::pageBuilt()
 {
-  QTextCharFormat anchorFormat;
-  anchorFormat.setAnchor(true);
-  anchorFormat.setAnchorHref(url);
-
-  int lastInsertPos = cursor->position();
-  cursor->setPosition(to, QTextCursor::KeepAnchor);
-  cursor->mergeCharFormat(anchorFormat);
-  cursor->setPosition(lastInsertPos);
+  // the page may have been replaced by a cached one meanwhile
+  if (!m_pendingKey || !m_pageWatcher.isFinished())
+    return;
 
-  return lastInsertPos;
+  m_pendingKey.reset();
+  showPage(m_pageWatcher.result());
+  if (m_highlightedIdx != -1)
+    highlightVerse(m_highlightedIdx);
 }
 
 void
-QuranPageBrowser::insertFooter(QTextCursor* cursor, int page)
-{
-  m_pageInfoTextFormat.setFontPointSize(m_fontSize - 6);
-
-  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
-  QFontMetrics fm(m_pageInfoTextFormat.font());
-
-  // first -> rub no. relative to hizb
-  // second -> hizb no.
-  std::optional<QPair<int, int>> rubStartingInPage =
-    m_quranService->getRubStartingInPage(page);
-  m_currFooterSegments = this->pageFooter(m_page, rubStartingInPage);
-
-  if (rubStartingInPage.has_value()) {
-    int rubWidth = fm.horizontalAdvance(m_currFooterSegments.at(0));
-    int pageNumWidth = fm.horizontalAdvance(m_currFooterSegments.at(1));
-    int hizbWidth = fm.horizontalAdvance(m_currFooterSegments.at(2));
-
-    int remaining =
-      m_pageLineSize.width() - rubWidth - hizbWidth - pageNumWidth;
-    int spaceCount = remaining / fm.horizontalAdvance(' ');
-
-    m_pageInfoTextFormat.setForeground(
-      QBrush(qApp->palette().color(QPalette::PlaceholderText)));
-    cursor->setCharFormat(m_pageInfoTextFormat);
-    cursor->insertText(m_currFooterSegments.at(0));
-
-    m_pageInfoTextFormat.setForeground(qApp->palette().text());
-    cursor->setCharFormat(m_pageInfoTextFormat);
-    cursor->insertText(QString(spaceCount / 2, ' ') +
-                       m_currFooterSegments.at(1) +
-                       QString((spaceCount + 1) / 2, ' '));
-
-    m_pageInfoTextFormat.setForeground(
-      QBrush(qApp->palette().color(QPalette::PlaceholderText)));
-    cursor->setCharFormat(m_pageInfoTextFormat);
-    cursor->insertText(m_currFooterSegments.at(2));
-  } else {
-    m_pageInfoTextFormat.setForeground(qApp->palette().text());
-    cursor->setCharFormat(m_pageInfoTextFormat);
-    cursor->insertText(m_currFooterSegments.at(0));
-  }
-}
-
-QStringList
-QuranPageBrowser::pageHeader(int page)
+QuranPageBrowser::prefetchPage(int page)
 {
-  m_headerData = m_quranService->pageMetadata(page);
+  if (page < 1 || page > QuranMetadata::pageTotal)
+    return;
 
-  QString suraHeader, jozzHeader;
-  suraHeader.append("سورة ");
-  suraHeader.append(m_quranService->surahName(m_headerData.first, true));
-  jozzHeader.append("الجزء ");
-  jozzHeader.append(m_glyphService->getJuzGlyph(m_headerData.second));
+  int fontSize = m_fontSize;
+  if (m_config.settings().value("Reader/AdaptiveFont").toBool())
+    fontSize = bestFitFontSize(FontManager::getInstance().pageFontname(page));
 
-  return QStringList({ suraHeader, jozzHeader });
+  const PageDocumentCache::Key key = pageKey(page, fontSize);
+  PageDocumentCache::getInstance().prefetch(key, pageBuilder(key));
 }
 
-int
-QuranPageBrowser::insertHeader(QTextCursor* cursor, int page)
+PageDocumentCache::Key
+QuranPageBrowser::pageKey(int page, int fontSize) const
 {
-  m_currHeaderSegments = this->pageHeader(m_page);
-  m_pageInfoTextFormat.setForeground(
-    QBrush(qApp->palette().color(QPalette::PlaceholderText)));
-
-  // smaller header font size for long juz > 10
-  if (m_config.qcfVersion() == 1 && page >= 202)
-    m_pageInfoTextFormat.setFontPointSize(std::max(4, m_fontSize - 8));
-  else
-    m_pageInfoTextFormat.setFontPointSize(m_fontSize - 6);
-
-  QFontMetrics fm(m_pageInfoTextFormat.font());
-  int juzWidth = fm.horizontalAdvance(m_currHeaderSegments.at(0));
-  int suraWidth = fm.horizontalAdvance(m_currHeaderSegments.at(1));
-  int margin = m_config.qcfVersion() == 1 ? 5 : 10;
-  int remaining = m_pageLineSize.width() - juzWidth - suraWidth - margin;
-  int spaceCount = remaining / fm.horizontalAdvance(' ');
-
-  QString headerLine = m_currHeaderSegments.join(QString(spaceCount, ' '));
-  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
-  cursor->insertText(headerLine);
+  return { page, m_config.qcfVersion(), fontSize, m_config.themeId() };
+}
 
-  setHref(cursor, 1, "#F" + QString::number(m_headerData.first));
-  return headerLine.size();
+std::function<PageDocumentCache::Page()>
+QuranPageBrowser::pageBuilder(const PageDocumentCache::Key& key)
+{
+  QuranPageBuilder::Style style;
+  style.defaultFont = font();
+  style.textColor = qApp->palette().color(QPalette::Text);
+  style.placeholderColor = qApp->palette().color(QPalette::PlaceholderText);
+  style.darkMode = m_config.darkMode();
+
+  const QString pageFont = FontManager::getInstance().pageFontname(key.page);
+  const GlyphService* glyphService = m_glyphService;
+  const int width = viewport()->width();
+  return [key, pageFont, style, glyphService, width]() {
+    PageDocumentCache::Page page =
+      QuranPageBuilder(key, pageFont, style, glyphService).build(width);
+    // measure the fitted sizes of the page font here, so fitting the page to
+    // the reader on the UI thread only looks them up
+    FontMetricsCache& metrics = FontMetricsCache::getInstance();
+    metrics.precompute(pageFont, minFitFontSize, maxFitFontSize);
+    metrics.precompute(
+      headerFontFamily, minFitFontSize - 6, maxFitFontSize - 6);
+    return page;
+  };
 }
 
-QStringList
-QuranPageBrowser::pageFooter(int page,
-                             std::optional<QPair<int, int>> rubStartingInPage)
+void
+QuranPageBrowser::showPage(const PageDocumentCache::Page& page)
 {
-  QStringList footerSegments;
-  footerSegments.append(m_stringConverter.arabicNumber(page));
-
-  if (rubStartingInPage.has_value()) {
-    footerSegments.insert(
-      0, "الربع " + m_stringConverter.arabicNumber(rubStartingInPage->first));
-    footerSegments.append(
-      "الحزب " + m_stringConverter.arabicNumber(rubStartingInPage->second));
+  m_verseCoordinates = page.verseCoordinates;
+  m_pageLineSize = page.lineSize;
+  m_currHeaderSegments = page.headerSegments;
+  m_currFooterSegments = page.footerSegments;
+  m_headerData = page.headerData;
+  m_verseRects.clear();
+  m_pageReady = true;
+
+  if (m_document != page.document) {
+    m_document = page.document;
+    setDocument(m_document.data());
   }
 
-  return footerSegments;
+  parentWidget()->setMinimumWidth(m_pageLineSize.width() + 70);
+  setAlignment(Qt::AlignCenter);
 }
 
 void
-QuranPageBrowser::constructPage(int pageNo, bool forceCustomSize)
+QuranPageBrowser::highlightVerse(int verseIdxInPage)
 {
-  if (pageNo != m_page) {
-    m_page = pageNo;
-    m_highlightedIdx = -1;
+  // highlighted once the page being built is shown
+  if (!m_pageReady) {
+    m_highlightedIdx = verseIdxInPage;
+    return;
   }
-  // cleanup
-  if (!m_verseCoordinates.empty())
-    m_verseCoordinates.clear();
-  this->document()->clear();
 
-  m_pageFont = FontManager::getInstance().pageFontname(pageNo);
-  QTextCursor textCursor(this->document());
-
-  m_currPageLines = m_glyphService->getPageLines(m_page);
-
-  // automatic font adjustment check
-  if (!forceCustomSize &&
-      m_config.settings().value("Reader/AdaptiveFont").toBool()) {
-    m_fontSize = this->bestFitFontSize();
-    m_config.settings().setValue(
-      "Reader/QCF" + QString::number(m_config.qcfVersion()) + "Size",
-      m_fontSize);
+  if (verseIdxInPage >= m_verseCoordinates.size() || verseIdxInPage < 0) {
+    qCritical() << "verseIdxInPage is out of page coords range!!!";
+    return;
   }
 
-  m_pageLineSize = this->calcPageLineSize(m_currPageLines);
+  resetHighlight();
+  m_highlightedIdx = verseIdxInPage;
+  viewport()->update(verseRegion(verseIdxInPage));
+}
 
-  int prevAnchor = 0;
-  // insert header in pages 3-604
-  if (pageNo > 2) {
-    prevAnchor = this->insertHeader(&textCursor, m_page) + 1;
-  }
+void
+QuranPageBrowser::resetHighlight()
+{
+  if (m_pageReady && m_highlightedIdx >= 0 &&
+      m_highlightedIdx < m_verseCoordinates.size())
+    viewport()->update(verseRegion(m_highlightedIdx));
 
-  parentWidget()->setMinimumWidth(m_pageLineSize.width() + 70);
+  m_highlightedIdx = -1;
+}
 
-  // page lines drawing
-  int counter = 0;
-  m_bodyTextFormat.setFont(QFont(m_pageFont, m_fontSize));
-  foreach (QString l, m_currPageLines) {
-    l = l.trimmed();
-    if (l.isEmpty())
-      continue;
-
-    if (l.contains("frame")) {
-      // generate frame for surah
-      int surah = l.split('_').at(1).toInt();
-      QImage surahFrame = this->surahFrame(surah);
-      // insert the surah image in the document
-      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
-      textCursor.insertImage(surahFrame.scaledToWidth(
-        m_pageLineSize.width() + 5, Qt::SmoothTransformation));
-
-      setHref(&textCursor, prevAnchor, "#F" + QString::number(surah));
-      prevAnchor += 2;
-    } else if (l.contains("bsml")) {
-      QImage bsml(":/resources/basmalah.png");
-      if (m_config.darkMode())
-        bsml.invertPixels();
-
-      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
-      textCursor.insertImage(
-        bsml.scaledToWidth(m_pageLineSize.width(), Qt::SmoothTransformation));
-      prevAnchor += 2;
-    } else {
-      // pageline inertion operation
-      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
-      // if contains verse separator character, add anchors
-      if (l.contains(':')) {
-        foreach (QChar glyph, l) {
-          if (glyph != ':') {
-            textCursor.insertText(glyph);
-          } else {
-            int lastInsertPos =
-              setHref(&textCursor, prevAnchor, "#" + QString::number(counter));
-
-            QPair<int, int> coords(prevAnchor, lastInsertPos);
-            m_verseCoordinates.append(coords);
-
-            counter++;
-            prevAnchor = lastInsertPos;
-          }
+const QList<QRectF>&
+QuranPageBrowser::verseRects(int verseIdxInPage)
+{
+  if (m_verseRects.isEmpty()) {
+    const QAbstractTextDocumentLayout* layout = document()->documentLayout();
+    for (const QPair<int, int>& bounds : std::as_const(m_verseCoordinates)) {
+      QList<QRectF> rects;
+      for (QTextBlock block = document()->findBlock(bounds.first);
+           block.isValid() && block.position() < bounds.second;
+           block = block.next()) {
+        const QTextLayout* textLayout = block.layout();
+        const QPointF blockPos = layout->blockBoundingRect(block).topLeft();
+        const int from = bounds.first - block.position();
+        const int to = bounds.second - block.position();
+
+        // the part of the verse in each line of the block
+        for (int i = 0; i < textLayout->lineCount(); i++) {
+          const QTextLine line = textLayout->lineAt(i);
+          const int start = std::max(from, line.textStart());
+          const int end = std::min(to, line.textStart() + line.textLength());
+          if (start >= end)
+            continue;
+
+          const qreal x1 = line.cursorToX(start);
+          const qreal x2 = line.cursorToX(end);
+          rects.append(QRectF(std::min(x1, x2),
+                              line.y(),
+                              std::abs(x2 - x1),
+                              line.height())
+                         .translated(blockPos));
         }
-
-      } else
-        textCursor.insertText(l);
+      }
+      m_verseRects.append(rects);
     }
   }
 
-  // insert footer (page number)
-  insertFooter(&textCursor, m_page);
-  setAlignment(Qt::AlignCenter);
+  return m_verseRects.at(verseIdxInPage);
+}
+
+QRegion
+QuranPageBrowser::verseRegion(int verseIdxInPage)
+{
+  const QPoint offset(horizontalScrollBar()->value(),
+                      verticalScrollBar()->value());
+  QRegion region;
+  for (const QRectF& rect : verseRects(verseIdxInPage))
+    region += rect.toAlignedRect().adjusted(-1, -1, 1, 1).translated(-offset);
+  return region;
 }
 
 void
-QuranPageBrowser::highlightVerse(int verseIdxInPage)
+QuranPageBrowser::paintEvent(QPaintEvent* event)
 {
-  if (verseIdxInPage > m_verseCoordinates.size() || verseIdxInPage < 0) {
-    qCritical() << "verseIdxInPage is out of page coords range!!!";
+  if (!m_pageReady || m_highlightedIdx < 0 ||
+      m_highlightedIdx >= m_verseCoordinates.size()) {
+    QTextBrowser::paintEvent(event);
     return;
   }
 
-  resetHighlight();
-
-  QTextCharFormat tcf;
+  // draw the page as QTextEdit does with the highlighted verse added as a
+  // selection, the layout draws the verse glyphs with the highlight format
+  const QPair<int, int>& bounds = m_verseCoordinates.at(m_highlightedIdx);
+  QAbstractTextDocumentLayout::Selection highlight;
+  highlight.cursor = QTextCursor(document());
+  highlight.cursor.setPosition(bounds.first);
+  highlight.cursor.setPosition(bounds.second, QTextCursor::KeepAnchor);
   if (m_fgHighlight)
-    tcf.setForeground(m_highlightColor);
+    highlight.format.setForeground(m_highlightColor);
   else
-    tcf.setBackground(m_highlightColor);
-
-  const QPair<int, int>& bounds = m_verseCoordinates.at(verseIdxInPage);
-
-  m_highlighter->setPosition(bounds.first);
-  m_highlighter->setPosition(bounds.second, QTextCursor::KeepAnchor);
-  m_highlighter->mergeCharFormat(tcf);
-
-  m_highlightedIdx = verseIdxInPage;
+    highlight.format.setBackground(m_highlightColor);
+
+  const QPoint offset(horizontalScrollBar()->value(),
+                      verticalScrollBar()->value());
+  QAbstractTextDocumentLayout::PaintContext context;
+  context.cursorPosition = -1;
+  context.palette = palette();
+  context.clip = event->rect().translated(offset);
+  context.selections.append(highlight);
+
+  QPainter painter(viewport());
+  painter.translate(-offset);
+  painter.setClipRect(context.clip);
+  document()->documentLayout()->draw(&painter, context);
 }
 
 void
-QuranPageBrowser::resetHighlight()
+QuranPageBrowser::resizeEvent(QResizeEvent* event)
 {
-  QTextCharFormat tcf;
-  if (m_fgHighlight)
-    tcf.setForeground(m_config.darkMode() ? Qt::white : Qt::black);
-  else
-    tcf.setBackground(Qt::transparent);
-
-  if (m_highlighter->hasSelection())
-    m_highlighter->mergeCharFormat(tcf); // de-highlight any previous highlights
-
-  m_highlightedIdx = -1;
+  QTextBrowser::resizeEvent(event);
+  m_verseRects.clear();
 }
 
 QuranPageBrowser::Action
@@ -345,6 +304,7 @@ QuranPageBrowser::lmbVerseMenu(bool favoriteVerse)
   lmbMenu.addAction(m_actTafsir);
   lmbMenu.addAction(m_actTranslation);
   lmbMenu.addAction(m_actThoughts);
+  lmbMenu.addAction(m_actSimilar);
   lmbMenu.addSeparator();
   lmbMenu.addAction(m_actCopy);
   if (favoriteVerse) {
@@ -366,6 +326,8 @@ QuranPageBrowser::lmbVerseMenu(bool favoriteVerse)
     actionIdx = Action::Translation;
   else if (chosen == m_actThoughts)
     actionIdx = Action::Thoughts;
+  else if (chosen == m_actSimilar)
+    actionIdx = Action::Similar;
   else if (chosen == m_actCopy)
     actionIdx = Action::Copy;
   else if (chosen == m_actAddBookmark)
@@ -380,17 +342,35 @@ QuranPageBrowser::lmbVerseMenu(bool favoriteVerse)
 int
 QuranPageBrowser::bestFitFontSize()
 {
-  int sz;
+  return bestFitFontSize(m_pageFont);
+}
+
+int
+QuranPageBrowser::bestFitFontSize(const QString& pageFont)
+{
+  FontMetricsCache& metrics = FontMetricsCache::getInstance();
   int margin = 10;
-  for (sz = 28; sz >= 12; sz--) {
-    QFontMetrics pageMetrics(QFont(m_pageFont, sz));
-    QFontMetrics headerMetrics(QFont("PakType Naskh Basic", sz - 6));
-    int pageHeight = (pageMetrics.height() * 15) + (headerMetrics.height() * 2);
-    if (pageHeight + margin <= parentWidget()->height())
-      break;
+  int available = parentWidget()->height() - margin;
+  auto fits = [&](int sz) {
+    int pageHeight = (metrics.height(pageFont, sz) * 15) +
+                     (metrics.height(headerFontFamily, sz - 6) * 2);
+    return pageHeight <= available;
+  };
+
+  // the page height grows with the font size, search for the largest size
+  // that fits, one below the range if none does
+  if (!fits(minFitFontSize))
+    return minFitFontSize - 1;
+  int low = minFitFontSize, high = maxFitFontSize;
+  while (low < high) {
+    int mid = (low + high + 1) / 2;
+    if (fits(mid))
+      low = mid;
+    else
+      high = mid - 1;
   }
 
-  return sz;
+  return low;
 }
 
 void
@@ -404,6 +384,7 @@ QuranPageBrowser::createActions()
   m_actTafsir = new QAction(tr("Tafsir"), this);
   m_actTranslation = new QAction(tr("Translation"), this);
   m_actThoughts = new QAction(tr("Thoughts"), this);
+  m_actSimilar = new QAction(tr("Similar Verses"), this);
   m_actAddBookmark = new QAction(tr("Add Bookmark"), this);
   m_actRemBookmark = new QAction(tr("Remove Bookmark"), this);
   m_actZoomIn->setIcon(
@@ -415,6 +396,7 @@ QuranPageBrowser::createActions()
   m_actTafsir->setIcon(m_styleMgr.awesome().icon(fa_solid, fa_book_open));
   m_actTranslation->setIcon(m_styleMgr.awesome().icon(fa_solid, fa_language));
   m_actThoughts->setIcon(m_styleMgr.awesome().icon(fa_solid, fa_comment));
+  m_actSimilar->setIcon(m_styleMgr.awesome().icon(fa_solid, fa_clone));
   m_actCopy->setIcon(m_styleMgr.awesome().icon(fa_solid, fa_clipboard));
   m_actAddBookmark->setIcon(m_styleMgr.awesome().icon(fa_regular, fa_bookmark));
   m_actRemBookmark->setIcon(m_styleMgr.awesome().icon(fa_solid, fa_bookmark));
@@ -493,3 +475,9 @@ QuranPageBrowser::page() const
 {
   return m_page;
 }
+
+bool
+QuranPageBrowser::pageReady() const
+{
+  return m_pageReady;
+}
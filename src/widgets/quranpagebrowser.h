@@ -7,6 +7,7 @@
 #define QURANPAGEBROWSER_H
 
 #include <QContextMenuEvent>
+#include <QFutureWatcher>
 #include <QHBoxLayout>
 #include <QMenu>
 #include <QPainter>
@@ -22,7 +23,7 @@
 #include <service/glyphservice.h>
 #include <service/quranservice.h>
 #include <utils/configuration.h>
-#include <utils/numbertostringconverter.h>
+#include <utils/pagedocumentcache.h>
 #include <utils/stylemanager.h>
 
 /**
@@ -45,6 +46,7 @@ public:
     Tafsir,        ///< show the tafsir for the verse
     Translation,   ///< show the translation for the verse
     Thoughts,      ///< show user thoughts for the verse
+    Similar,       ///< list the verses worded like the verse
     Copy,          ///< copy the verse text to clipboard
     AddBookmark,   ///< add the verse to bookmarks
     RemoveBookmark ///< remove the verse from bookmarks
@@ -56,6 +58,7 @@ public:
    * @param initPage - inital page to load
    */
   QuranPageBrowser(QWidget* parent = nullptr, int initPage = 1);
+  ~QuranPageBrowser();
   /**
    * @brief sets m_fontSize to the fontsize in the settings file
    */
@@ -66,29 +69,13 @@ public:
    * @return QString of the converted number
    */
   QString getEasternNum(QString num);
-  /**
-   * @brief generate the header line which contains the top verse surah name and
-   * the current juz
-   * @details the returned page header contains a '$' which needs to be replaced
-   * with the correct amount of space for the header to fit with the page size
-   * @param page - page number to generate header for
-   * @return QString of the page header without spacing
-   */
-  QStringList pageHeader(int page);
-  QStringList pageFooter(int page,
-                         std::optional<QPair<int, int>> rubStartingInPage);
   /**
    * @brief construct Quran page
-   * @details the page construction process is done through:
-   * (1) clear the QTextBrowser and the verse coordinates QList
-   * (2) set the new page font, header, page lines and page line pixel size
-   * (3) set minimum widget width to preseve the page display as expected
-   * (4) insert page lines which could be ('frame', 'bsml' or normal line)
-   * (5) in case the line contains a verse end/separator (':'), carefully
-   * insert the glyphs and set the verse anchor tag href to '#N' where N is the
-   * verse number relative to the start of the page
-   * (6) set the start and end cursor positions for the verse
-   * (7) insert page footer with the page number
+   * @details pages constructed before with the same font size and theme are
+   * taken from the PageDocumentCache. Otherwise the page is built by a
+   * QuranPageBuilder on a worker thread and shown once it is ready, the
+   * previous page stays displayed meanwhile and verses highlighted in between
+   * are highlighted when the page is shown.
    *
    * @param pageNo - page number to generate
    * @param forceCustomSize - boolean to force the use of
@@ -96,11 +83,20 @@ public:
   void constructPage(int pageNo, bool forceCustomSize = false);
   /**
    * @brief highlight the specified verse in the displayed page
+   * @details the highlight is drawn as a selection when painting, the page
+   * document isn't formatted, only the regions of the previous and the new
+   * highlighted verse are repainted
    * @param verseIdxInPage - 0-based index of the verse relative to the start of
    * the page
    */
   void highlightVerse(int verseIdxInPage);
   void resetHighlight();
+  /**
+   * @brief build a page in the background so constructing it later is a
+   * cache hit
+   * @param page - page number to prefetch
+   */
+  void prefetchPage(int page);
   /**
    * @brief show the main verse interaction menu and return number related to
    * the chosen action
@@ -126,6 +122,11 @@ public:
   QString pageFont() const;
 
   int page() const;
+  /**
+   * @brief getter for m_pageReady
+   * @return false while the shown document belongs to the previous page
+   */
+  bool pageReady() const;
 
 public slots:
   /**
@@ -145,10 +146,28 @@ public slots:
 signals:
   void copyVerse(int IdxInPage);
 
+private slots:
+  /**
+   * @brief show the page built in the background by constructPage()
+   */
+  void pageBuilt();
+
 protected:
 #ifndef QT_NO_CONTEXTMENU
   void contextMenuEvent(QContextMenuEvent* event) override;
 #endif
+  /**
+   * @brief re-implementation of QTextEdit::paintEvent() drawing the
+   * highlighted verse on top of the page
+   * @param event - the paint event
+   */
+  void paintEvent(QPaintEvent* event) override;
+  /**
+   * @brief re-implementation of QTextEdit::resizeEvent() dropping the verse
+   * rectangles of the previous layout
+   * @param event - the resize event
+   */
+  void resizeEvent(QResizeEvent* event) override;
 
 private:
   Configuration& m_config;
@@ -160,30 +179,45 @@ private:
    */
   void createActions();
   /**
-   * @brief calculate the approximate pixel size of the page line
-   * @param lines - QStringList of page lines
-   * @return QSize of a single page line
+   * @brief guess the best fontsize for a page based on the height of the
+   * parent widget
+   * @param pageFont - QCF font name of the page
+   * @return suggested fontsize for the page
+   */
+  int bestFitFontSize(const QString& pageFont);
+  /**
+   * @brief key of a page in the PageDocumentCache for the current settings
+   * @param page - page number
+   * @param fontSize - font size of the page
    */
-  QSize calcPageLineSize(QStringList& lines);
+  PageDocumentCache::Key pageKey(int page, int fontSize) const;
   /**
-   * @brief generate QImage for the frame containing the surah name to insert in
+   * @brief capture everything needed to build a page off the UI thread
+   * @param key - key of the page to build
+   * @return function building the page on any thread
+   */
+  std::function<PageDocumentCache::Page()> pageBuilder(
+    const PageDocumentCache::Key& key);
+  /**
+   * @brief display a constructed page and restore its layout data
+   * @param page - the constructed page
+   */
+  void showPage(const PageDocumentCache::Page& page);
+  /**
+   * @brief get the rectangles covering the glyphs of a verse
+   * @details the rectangles of all page verses are computed together the
+   * first time a verse is highlighted in the current layout
+   * @param verseIdxInPage - 0-based index of the verse relative to the start of
    * the page
-   * @param surah - surah number
-   * @return QImage of the surah frame
+   * @return QList of the rectangles in document coordinates, one per line
    */
-  QImage surahFrame(int surah);
+  const QList<QRectF>& verseRects(int verseIdxInPage);
   /**
-   * @brief utility to set the href url for the text from the current cursor
-   * position to the position given
-   * @param cursor - pointer to the current QTextCursor used for inserting text
-   * @param to  - the position in document to stop at
-   * @param url - url to set for the selected portion
-   * @return int - the current cursor postion
+   * @brief get the viewport region covered by a verse
+   * @param verseIdxInPage - 0-based index of the verse relative to the start of
+   * the page
    */
-  int setHref(QTextCursor* cursor, int to, QString url);
-
-  int insertHeader(QTextCursor*, int);
-  void insertFooter(QTextCursor*, int);
+  QRegion verseRegion(int verseIdxInPage);
   /**
    * @brief boolean indicating whether to highlight the foreground of the active
    * verse or not
@@ -206,10 +240,6 @@ private:
    * @brief the average size of the line in the current page
    */
   QSize m_pageLineSize;
-  /**
-   * @brief QStringList of the page line glyphs
-   */
-  QStringList m_currPageLines;
   /**
    * @brief QString of the page header
    */
@@ -263,6 +293,10 @@ private:
    * MODIFIED
    */
   QPointer<QAction> m_actThoughts;
+  /**
+   * @brief QAction for listing similarly worded verses
+   */
+  QPointer<QAction> m_actSimilar;
   /**
    * @brief QAction for bookmark addition functionality
    */
@@ -272,21 +306,9 @@ private:
    */
   QPointer<QAction> m_actRemBookmark;
   /**
-   * @brief QTextCursor used in highlighting verses
-   */
-  QSharedPointer<QTextCursor> m_highlighter;
-  /**
-   * @brief page format properties used in inserting lines
-   */
-  QTextBlockFormat m_pageFormat;
-  /**
-   * @brief character format used for header font properties
+   * @brief document of the displayed page, shared with the PageDocumentCache
    */
-  QTextCharFormat m_pageInfoTextFormat;
-  /**
-   * @brief character format used for main page text font properties
-   */
-  QTextCharFormat m_bodyTextFormat;
+  QSharedPointer<QTextDocument> m_document;
   /**
    * @brief QBrush used for changing highlighted verse foreground color
    */
@@ -296,8 +318,25 @@ private:
    * the current page
    */
   QList<QPair<int, int>> m_verseCoordinates;
+  /**
+   * @brief glyph rectangles of each verse in the current layout, empty until
+   * first needed
+   */
+  QList<QList<QRectF>> m_verseRects;
   QPair<int, int> m_headerData;
-  NumberToStringConverter m_stringConverter;
+  /**
+   * @brief whether the displayed document is the one of m_page, false while
+   * the page is built in the background
+   */
+  bool m_pageReady = false;
+  /**
+   * @brief key of the page built in the background for display
+   */
+  std::optional<PageDocumentCache::Key> m_pendingKey;
+  /**
+   * @brief watches the background build of the page to display
+   */
+  QFutureWatcher<PageDocumentCache::Page> m_pageWatcher;
 };
 
 #endif // QURANPAGEBROWSER_H
@@ -0,0 +1,255 @@
+/**
+ * @file quranpagebuilder.cpp
+ * @brief Implementation file for QuranPageBuilder
+ */
+
+#include "quranpagebuilder.h"
+#include <QAbstractTextDocumentLayout>
+#include <QCoreApplication>
+#include <generated/quranmetadata.h>
+#include <utils/decorationcache.h>
+#include <utils/fontmetricscache.h>
+
+QuranPageBuilder::QuranPageBuilder(const PageDocumentCache::Key& key,
+                                   const QString& pageFont,
+                                   const Style& style,
+                                   const GlyphService* glyphService)
+  : m_key(key)
+  , m_pageFont(pageFont)
+  , m_style(style)
+  , m_glyphService(glyphService)
+{
+  m_pageFormat.setAlignment(Qt::AlignCenter);
+  m_pageFormat.setNonBreakableLines(true);
+  m_pageFormat.setLayoutDirection(Qt::RightToLeft);
+  m_pageInfoTextFormat.setFont(QFont("PakType Naskh Basic"));
+}
+
+QSize
+QuranPageBuilder::calcPageLineSize(QStringList& lines)
+{
+  QString measureLine;
+  if (m_key.page < 3) {
+    measureLine = lines.at(3);
+  } else if (m_key.page >= 602 || m_key.page == 596) {
+    measureLine = lines.at(2);
+  } else {
+    measureLine = lines.at(lines.size() - 2);
+  }
+
+  return FontMetricsCache::getInstance().lineSize(
+           m_pageFont, m_key.fontSize, m_key.page, measureLine.remove(':')) +
+         QSize(0, 5);
+}
+
+int
+QuranPageBuilder::setHref(QTextCursor* cursor, int to, QString url)
+{
+  QTextCharFormat anchorFormat;
+  anchorFormat.setAnchor(true);
+  anchorFormat.setAnchorHref(url);
+
+  int lastInsertPos = cursor->position();
+  cursor->setPosition(to, QTextCursor::KeepAnchor);
+  cursor->mergeCharFormat(anchorFormat);
+  cursor->setPosition(lastInsertPos);
+
+  return lastInsertPos;
+}
+
+void
+QuranPageBuilder::insertFooter(QTextCursor* cursor)
+{
+  const int page = m_key.page;
+  m_pageInfoTextFormat.setFontPointSize(m_key.fontSize - 6);
+
+  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
+  QFontMetrics fm(m_pageInfoTextFormat.font());
+
+  // first -> rub no. relative to hizb
+  // second -> hizb no.
+  // rub boundaries are resolved against QCF v1 pages
+  std::optional<QPair<int, int>> rubStartingInPage = std::nullopt;
+  if (int rub = QuranMetadata::pageRubStart[0][page]) {
+    rubStartingInPage.emplace(
+      rub % 4 ? rub % 4 : 4,
+      QuranMetadata::hizbOf(QuranMetadata::rubFirstVerse[rub]));
+  }
+  m_result.footerSegments = this->pageFooter(page, rubStartingInPage);
+  const QStringList& segments = m_result.footerSegments;
+
+  if (rubStartingInPage.has_value()) {
+    int rubWidth = fm.horizontalAdvance(segments.at(0));
+    int pageNumWidth = fm.horizontalAdvance(segments.at(1));
+    int hizbWidth = fm.horizontalAdvance(segments.at(2));
+
+    int remaining =
+      m_result.lineSize.width() - rubWidth - hizbWidth - pageNumWidth;
+    int spaceCount = remaining / fm.horizontalAdvance(' ');
+
+    m_pageInfoTextFormat.setForeground(m_style.placeholderColor);
+    cursor->setCharFormat(m_pageInfoTextFormat);
+    cursor->insertText(segments.at(0));
+
+    m_pageInfoTextFormat.setForeground(m_style.textColor);
+    cursor->setCharFormat(m_pageInfoTextFormat);
+    cursor->insertText(QString(spaceCount / 2, ' ') + segments.at(1) +
+                       QString((spaceCount + 1) / 2, ' '));
+
+    m_pageInfoTextFormat.setForeground(m_style.placeholderColor);
+    cursor->setCharFormat(m_pageInfoTextFormat);
+    cursor->insertText(segments.at(2));
+  } else {
+    m_pageInfoTextFormat.setForeground(m_style.textColor);
+    cursor->setCharFormat(m_pageInfoTextFormat);
+    cursor->insertText(segments.at(0));
+  }
+}
+
+QStringList
+QuranPageBuilder::pageHeader(int page)
+{
+  // header metadata is resolved against QCF v1 pages
+  int firstVerse = QuranMetadata::pageFirstVerse[0][page];
+  m_result.headerData = { QuranMetadata::surahOf(firstVerse),
+                          QuranMetadata::juzOf(firstVerse) };
+
+  QString suraHeader, jozzHeader;
+  suraHeader.append("سورة ");
+  suraHeader.append(QString::fromUtf8(
+    QuranMetadata::surahNamesAr[m_result.headerData.first - 1]));
+  jozzHeader.append("الجزء ");
+  jozzHeader.append(QString::fromUtf8(
+    QuranMetadata::juzNames[m_result.headerData.second - 1]));
+
+  return QStringList({ suraHeader, jozzHeader });
+}
+
+int
+QuranPageBuilder::insertHeader(QTextCursor* cursor)
+{
+  const int page = m_key.page;
+  m_result.headerSegments = this->pageHeader(page);
+  const QStringList& segments = m_result.headerSegments;
+  m_pageInfoTextFormat.setForeground(m_style.placeholderColor);
+
+  // smaller header font size for long juz > 10
+  if (m_key.qcfVersion == 1 && page >= 202)
+    m_pageInfoTextFormat.setFontPointSize(std::max(4, m_key.fontSize - 8));
+  else
+    m_pageInfoTextFormat.setFontPointSize(m_key.fontSize - 6);
+
+  QFontMetrics fm(m_pageInfoTextFormat.font());
+  int juzWidth = fm.horizontalAdvance(segments.at(0));
+  int suraWidth = fm.horizontalAdvance(segments.at(1));
+  int margin = m_key.qcfVersion == 1 ? 5 : 10;
+  int remaining = m_result.lineSize.width() - juzWidth - suraWidth - margin;
+  int spaceCount = remaining / fm.horizontalAdvance(' ');
+
+  QString headerLine = segments.join(QString(spaceCount, ' '));
+  cursor->insertBlock(m_pageFormat, m_pageInfoTextFormat);
+  cursor->insertText(headerLine);
+
+  setHref(cursor, 1, "#F" + QString::number(m_result.headerData.first));
+  return headerLine.size();
+}
+
+QStringList
+QuranPageBuilder::pageFooter(int page,
+                             std::optional<QPair<int, int>> rubStartingInPage)
+{
+  QStringList footerSegments;
+  footerSegments.append(m_stringConverter.arabicNumber(page));
+
+  if (rubStartingInPage.has_value()) {
+    footerSegments.insert(
+      0, "الربع " + m_stringConverter.arabicNumber(rubStartingInPage->first));
+    footerSegments.append(
+      "الحزب " + m_stringConverter.arabicNumber(rubStartingInPage->second));
+  }
+
+  return footerSegments;
+}
+
+PageDocumentCache::Page
+QuranPageBuilder::build(int layoutWidth)
+{
+  m_result = PageDocumentCache::Page();
+  // the document may be released from any thread holding the page
+  m_result.document.reset(new QTextDocument, &QObject::deleteLater);
+  QTextDocument* document = m_result.document.data();
+  document->setDefaultFont(m_style.defaultFont);
+  QTextCursor textCursor(document);
+
+  QStringList pageLines = m_glyphService->getPageLines(m_key.page);
+  m_result.lineSize = this->calcPageLineSize(pageLines);
+
+  int prevAnchor = 0;
+  // insert header in pages 3-604
+  if (m_key.page > 2) {
+    prevAnchor = this->insertHeader(&textCursor) + 1;
+  }
+
+  // page lines drawing
+  DecorationCache& decorations = DecorationCache::getInstance();
+  int counter = 0;
+  m_bodyTextFormat.setFont(QFont(m_pageFont, m_key.fontSize));
+  foreach (QString l, pageLines) {
+    l = l.trimmed();
+    if (l.isEmpty())
+      continue;
+
+    if (l.contains("frame")) {
+      // generate frame for surah
+      int surah = l.split('_').at(1).toInt();
+      QImage surahFrame = decorations.surahFrame(
+        surah, m_style.darkMode, m_result.lineSize.width() + 5);
+      // insert the surah image in the document
+      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
+      textCursor.insertImage(surahFrame);
+
+      setHref(&textCursor, prevAnchor, "#F" + QString::number(surah));
+      prevAnchor += 2;
+    } else if (l.contains("bsml")) {
+      QImage bsml =
+        decorations.basmalah(m_style.darkMode, m_result.lineSize.width());
+
+      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
+      textCursor.insertImage(bsml);
+      prevAnchor += 2;
+    } else {
+      // pageline inertion operation
+      textCursor.insertBlock(m_pageFormat, m_bodyTextFormat);
+      // if contains verse separator character, add anchors
+      if (l.contains(':')) {
+        foreach (QChar glyph, l) {
+          if (glyph != ':') {
+            textCursor.insertText(glyph);
+          } else {
+            int lastInsertPos =
+              setHref(&textCursor, prevAnchor, "#" + QString::number(counter));
+
+            QPair<int, int> coords(prevAnchor, lastInsertPos);
+            m_result.verseCoordinates.append(coords);
+
+            counter++;
+            prevAnchor = lastInsertPos;
+          }
+        }
+
+      } else
+        textCursor.insertText(l);
+    }
+  }
+
+  // insert footer (page number)
+  insertFooter(&textCursor);
+
+  // shape and lay out the lines now, the displaying browser relayouts the
+  // document at the same width reusing the shaped text
+  document->setPageSize(QSizeF(layoutWidth, -1));
+  document->documentLayout()->documentSize();
+  document->moveToThread(QCoreApplication::instance()->thread());
+
+  return m_result;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file quranpagebuilder.h
+ * @brief Header file for QuranPageBuilder
+ */
+
+#ifndef QURANPAGEBUILDER_H
+#define QURANPAGEBUILDER_H
+
+#include <QColor>
+#include <QFont>
+#include <QTextBlockFormat>
+#include <QTextCharFormat>
+#include <QTextCursor>
+#include <optional>
+#include <service/glyphservice.h>
+#include <utils/numbertostringconverter.h>
+#include <utils/pagedocumentcache.h>
+
+/**
+ * @brief QuranPageBuilder builds the document of a Quran page as it is in the
+ * Madani Mushaf using QCF fonts
+ * @details the builder doesn't touch any widget, everything it needs from the
+ * UI thread is captured in its constructor, so pages can be built and laid out
+ * on a worker thread. The built document belongs to the application thread.
+ */
+class QuranPageBuilder
+{
+public:
+  /**
+   * @brief appearance of the page captured from the displaying widget
+   */
+  struct Style
+  {
+    QFont defaultFont;       ///< default font of the page document
+    QColor textColor;        ///< color of the page number
+    QColor placeholderColor; ///< color of the header and footer info
+    bool darkMode = false;   ///< invert the decoration images
+  };
+  /**
+   * @brief class constructor
+   * @param key - page, QCF version, font size and theme of the page to build
+   * @param pageFont - QCF font name of the page
+   * @param style - appearance of the page
+   * @param glyphService - pointer to the GlyphService used for the page lines
+   */
+  QuranPageBuilder(const PageDocumentCache::Key& key,
+                   const QString& pageFont,
+                   const Style& style,
+                   const GlyphService* glyphService);
+  /**
+   * @brief build the page document and lay it out
+   * @details the page construction process is done through:
+   * (1) fetch the page lines and calculate the page line pixel size
+   * (2) insert the page header in pages 3-604
+   * (3) insert page lines which could be ('frame', 'bsml' or normal line)
+   * (4) in case the line contains a verse end/separator (':'), carefully
+   * insert the glyphs and set the verse anchor tag href to '#N' where N is the
+   * verse number relative to the start of the page
+   * (5) set the start and end cursor positions for the verse
+   * (6) insert page footer with the page number
+   * (7) lay the document out for the given width
+   *
+   * @param layoutWidth - width of the displaying viewport
+   * @return PageDocumentCache::Page of the built page
+   */
+  PageDocumentCache::Page build(int layoutWidth);
+  /**
+   * @brief generate the header line which contains the top verse surah name and
+   * the current juz
+   * @details the returned page header contains a '$' which needs to be replaced
+   * with the correct amount of space for the header to fit with the page size
+   * @param page - page number to generate header for
+   * @return QString of the page header without spacing
+   */
+  QStringList pageHeader(int page);
+  QStringList pageFooter(int page,
+                         std::optional<QPair<int, int>> rubStartingInPage);
+
+private:
+  /**
+   * @brief calculate the approximate pixel size of the page line
+   * @param lines - QStringList of page lines
+   * @return QSize of a single page line
+   */
+  QSize calcPageLineSize(QStringList& lines);
+  /**
+   * @brief utility to set the href url for the text from the current cursor
+   * position to the position given
+   * @param cursor - pointer to the current QTextCursor used for inserting text
+   * @param to  - the position in document to stop at
+   * @param url - url to set for the selected portion
+   * @return int - the current cursor postion
+   */
+  int setHref(QTextCursor* cursor, int to, QString url);
+  int insertHeader(QTextCursor* cursor);
+  void insertFooter(QTextCursor* cursor);
+  const PageDocumentCache::Key m_key;
+  const QString m_pageFont;
+  const Style m_style;
+  const GlyphService* m_glyphService;
+  /**
+   * @brief the page being built
+   */
+  PageDocumentCache::Page m_result;
+  /**
+   * @brief page format properties used in inserting lines
+   */
+  QTextBlockFormat m_pageFormat;
+  /**
+   * @brief character format used for header font properties
+   */
+  QTextCharFormat m_pageInfoTextFormat;
+  /**
+   * @brief character format used for main page text font properties
+   */
+  QTextCharFormat m_bodyTextFormat;
+  NumberToStringConverter m_stringConverter;
+};
+
+#endif // QURANPAGEBUILDER_H
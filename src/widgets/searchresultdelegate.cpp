@@ -0,0 +1,171 @@
+/**
+ * @file searchresultdelegate.cpp
+ * @brief Implementation file for SearchResultDelegate
+ */
+
+#include "searchresultdelegate.h"
+#include "searchresultmodel.h"
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QPainter>
+#include <QtMath>
+
+void
+SearchResultDelegate::paint(QPainter* painter,
+                            const QStyleOptionViewItem& option,
+                            const QModelIndex& index) const
+{
+  // background, hover and selection only, the contents are painted below
+  QStyleOptionViewItem background(option);
+  initStyleOption(&background, index);
+  background.text.clear();
+  const QWidget* widget = option.widget;
+  QStyle* style = widget ? widget->style() : QApplication::style();
+  style->drawControl(QStyle::CE_ItemViewItem, &background, painter, widget);
+
+  const Qt::Alignment align =
+    QStyle::visualAlignment(option.direction, Qt::AlignLeft);
+  const QPalette::ColorRole textRole = option.state & QStyle::State_Selected
+                                         ? QPalette::HighlightedText
+                                         : QPalette::Text;
+  const QRect rect = option.rect.adjusted(margin, margin, -margin, -margin);
+  const QFontMetrics infoMetrics(option.font);
+
+  painter->save();
+  painter->setPen(option.palette.color(textRole));
+  painter->setFont(option.font);
+  QRect infoRect(rect.topLeft(), QSize(rect.width(), infoMetrics.height()));
+  painter->drawText(infoRect,
+                    align | Qt::AlignVCenter,
+                    index.data(Qt::DisplayRole).toString());
+
+  QTextLayout verse;
+  const int verseTop = infoRect.bottom() + margin;
+  const int verseHeight = layoutVerse(verse, option, index);
+  verse.draw(painter, QPointF(rect.left(), verseTop));
+
+  QTextLayout snippet;
+  if (layoutSnippet(snippet, option, index))
+    snippet.draw(painter,
+                 QPointF(rect.left(), verseTop + verseHeight + margin));
+  painter->restore();
+}
+
+QSize
+SearchResultDelegate::sizeHint(const QStyleOptionViewItem& option,
+                               const QModelIndex& index) const
+{
+  const int width = contentWidth(option);
+  const QFontMetrics infoMetrics(option.font);
+
+  if (!index.data(SearchResultModel::FetchedRole).toBool()) {
+    QFont verseFont(option.font);
+    verseFont.setPointSize(15);
+    return QSize(width + 2 * margin,
+                 infoMetrics.height() + 3 * margin +
+                   estimatedLines * QFontMetrics(verseFont).lineSpacing());
+  }
+
+  QTextLayout verse;
+  const int verseHeight = layoutVerse(verse, option, index);
+  QTextLayout snippet;
+  const int snippetHeight = layoutSnippet(snippet, option, index);
+  return QSize(width + 2 * margin,
+               infoMetrics.height() + verseHeight + 3 * margin +
+                 (snippetHeight ? snippetHeight + margin : 0));
+}
+
+void
+SearchResultDelegate::rowsFetched(int first, int last)
+{
+  Q_UNUSED(last);
+  // a single change is enough, the view lays out all rows again
+  auto view = qobject_cast<QAbstractItemView*>(parent());
+  if (view && view->model())
+    emit sizeHintChanged(view->model()->index(first, 0));
+}
+
+int
+SearchResultDelegate::contentWidth(const QStyleOptionViewItem& option)
+{
+  int width = option.rect.width();
+  if (auto view = qobject_cast<const QAbstractItemView*>(option.widget))
+    width = view->viewport()->width();
+  return std::max(width - 2 * margin, 1);
+}
+
+int
+SearchResultDelegate::layoutVerse(QTextLayout& layout,
+                                  const QStyleOptionViewItem& option,
+                                  const QModelIndex& index)
+{
+  QColor highlight = option.palette.color(QPalette::Highlight);
+  highlight.setAlpha(option.state & QStyle::State_Selected ? 160 : 80);
+  QTextCharFormat matchFormat;
+  matchFormat.setBackground(highlight);
+  return layoutText(layout,
+                    index.data(SearchResultModel::TextRole).toString(),
+                    index.data(Qt::FontRole).value<QFont>(),
+                    index.data(SearchResultModel::TextMatchesRole)
+                      .value<QList<QPair<int, int>>>(),
+                    matchFormat,
+                    option);
+}
+
+int
+SearchResultDelegate::layoutSnippet(QTextLayout& layout,
+                                    const QStyleOptionViewItem& option,
+                                    const QModelIndex& index)
+{
+  const QString text = index.data(SearchResultModel::SnippetRole).toString();
+  if (text.isEmpty())
+    return 0;
+
+  QTextCharFormat matchFormat;
+  matchFormat.setFontWeight(QFont::Bold);
+  return layoutText(layout,
+                    text,
+                    option.font,
+                    index.data(SearchResultModel::SnippetMatchesRole)
+                      .value<QList<QPair<int, int>>>(),
+                    matchFormat,
+                    option);
+}
+
+int
+SearchResultDelegate::layoutText(QTextLayout& layout,
+                                 const QString& text,
+                                 const QFont& font,
+                                 const QList<QPair<int, int>>& matches,
+                                 const QTextCharFormat& matchFormat,
+                                 const QStyleOptionViewItem& option)
+{
+  QList<QTextLayout::FormatRange> formats;
+  for (const QPair<int, int>& match : matches) {
+    QTextLayout::FormatRange range;
+    range.start = match.first;
+    range.length = match.second;
+    range.format = matchFormat;
+    formats.append(range);
+  }
+
+  QTextOption textOption(
+    QStyle::visualAlignment(option.direction, Qt::AlignLeft));
+  textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+  layout.setText(text);
+  layout.setFont(font);
+  layout.setTextOption(textOption);
+  layout.setFormats(formats);
+
+  const int width = contentWidth(option);
+  qreal height = 0;
+  layout.beginLayout();
+  for (QTextLine line = layout.createLine(); line.isValid();
+       line = layout.createLine()) {
+    line.setLineWidth(width);
+    line.setPosition(QPointF(0, height));
+    height += line.height();
+  }
+  layout.endLayout();
+  return qCeil(height);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file searchresultdelegate.h
+ * @brief Header file for SearchResultDelegate
+ */
+
+#ifndef SEARCHRESULTDELEGATE_H
+#define SEARCHRESULTDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QTextLayout>
+
+/**
+ * @brief SearchResultDelegate paints the rows of a SearchResultModel.
+ * @details Each row is painted as the info line followed by the verse text
+ * in the verse font, wrapped to the width of the view, over the item
+ * background of the current style so hover and selection look like any
+ * other item view. The searched phrases are highlighted in the verse text
+ * at the spans given by the model. Rows with a content excerpt show it below
+ * the verse with the matches in bold.
+ *
+ * Rows not fetched by the model yet are sized by an estimate instead of
+ * fetching them, so laying out the view only fetches the rows it paints.
+ * Their real size is measured once the model reports them fetched.
+ */
+class SearchResultDelegate : public QStyledItemDelegate
+{
+  Q_OBJECT
+
+public:
+  using QStyledItemDelegate::QStyledItemDelegate;
+
+  void paint(QPainter* painter,
+             const QStyleOptionViewItem& option,
+             const QModelIndex& index) const override;
+  QSize sizeHint(const QStyleOptionViewItem& option,
+                 const QModelIndex& index) const override;
+
+public slots:
+  /**
+   * @brief Relayouts the view once rows sized by an estimate are fetched.
+   * @param first - first fetched row
+   * @param last - last fetched row
+   */
+  void rowsFetched(int first, int last);
+
+private:
+  /**
+   * @brief Margin around the row contents in pixels.
+   */
+  static const int margin = 8;
+  /**
+   * @brief Number of verse lines assumed for rows that aren't fetched.
+   */
+  static const int estimatedLines = 2;
+  /**
+   * @brief Width available to the row contents.
+   */
+  static int contentWidth(const QStyleOptionViewItem& option);
+  /**
+   * @brief Lays out text wrapped to the content width of a row.
+   * @param layout - layout receiving the text and match formats
+   * @param text - text to lay out
+   * @param font - font of the text
+   * @param matches - start and length of the matches in the text
+   * @param matchFormat - format applied to the matches
+   * @param option - style options of the row
+   * @return Height of the laid out text.
+   */
+  static int layoutText(QTextLayout& layout,
+                        const QString& text,
+                        const QFont& font,
+                        const QList<QPair<int, int>>& matches,
+                        const QTextCharFormat& matchFormat,
+                        const QStyleOptionViewItem& option);
+  /**
+   * @brief Lays out the verse text of a row with its matches highlighted.
+   * @param layout - layout receiving the verse text and match formats
+   * @param option - style options of the row
+   * @param index - model index of the row
+   * @return Height of the laid out verse text.
+   */
+  static int layoutVerse(QTextLayout& layout,
+                         const QStyleOptionViewItem& option,
+                         const QModelIndex& index);
+  /**
+   * @brief Lays out the content excerpt of a row, if any.
+   * @param layout - layout receiving the excerpt text and match formats
+   * @param option - style options of the row
+   * @param index - model index of the row
+   * @return Height of the laid out excerpt, 0 if the row has none.
+   */
+  static int layoutSnippet(QTextLayout& layout,
+                           const QStyleOptionViewItem& option,
+                           const QModelIndex& index);
+};
+
+#endif // SEARCHRESULTDELEGATE_H
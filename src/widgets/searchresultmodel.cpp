@@ -0,0 +1,123 @@
+/**
+ * @file searchresultmodel.cpp
+ * @brief Implementation file for SearchResultModel
+ */
+
+#include "searchresultmodel.h"
+#include <QFont>
+#include <utils/fontmanager.h>
+
+SearchResultModel::SearchResultModel(const QuranService* quranService,
+                                     const GlyphService* glyphService,
+                                     QObject* parent)
+  : QAbstractListModel(parent)
+  , m_config(Configuration::getInstance())
+  , m_quranService(quranService)
+  , m_glyphService(glyphService)
+  , m_surahNames(quranService->surahNames())
+  , m_batches(16)
+{
+}
+
+void
+SearchResultModel::setResults(const QList<Verse>& results,
+                              SnippetProvider snippets,
+                              MatchProvider matches)
+{
+  beginResetModel();
+  m_results = results;
+  m_snippets = snippets;
+  m_matches = matches;
+  m_batches.clear();
+  endResetModel();
+}
+
+Verse
+SearchResultModel::verseAt(int row) const
+{
+  return m_results.at(row);
+}
+
+int
+SearchResultModel::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : m_results.size();
+}
+
+QVariant
+SearchResultModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || index.row() >= m_results.size())
+    return QVariant();
+  if (role == FetchedRole)
+    return m_batches.contains(index.row() / batchSize);
+
+  if (role != Qt::DisplayRole && role != Qt::FontRole && role != TextRole &&
+      role != SnippetRole && role != SnippetMatchesRole &&
+      role != TextMatchesRole)
+    return QVariant();
+
+  const Row& row = batch(index.row() / batchSize).at(index.row() % batchSize);
+  switch (role) {
+    case Qt::DisplayRole:
+      return row.info;
+    case Qt::FontRole:
+      return QFont(row.fontName, 15);
+    case SnippetRole:
+      return row.snippet;
+    case SnippetMatchesRole:
+      return QVariant::fromValue(row.snippetMatches);
+    case TextMatchesRole:
+      return QVariant::fromValue(row.textMatches);
+    default:
+      return row.text;
+  }
+}
+
+const QList<SearchResultModel::Row>&
+SearchResultModel::batch(int number) const
+{
+  if (QList<Row>* cached = m_batches.object(number))
+    return *cached;
+
+  const bool qcf = m_config.verseType() == ConfigurationSchema::Qcf;
+  const int first = number * batchSize;
+  const int last = std::min<int>(first + batchSize, m_results.size());
+  QList<int> ids;
+  for (int i = first; i < last; i++)
+    ids.append(Verse::id(m_results.at(i).surah(), m_results.at(i).number()));
+  const QStringList texts = qcf ? m_glyphService->verseGlyphsById(ids)
+                                : m_quranService->verseTextsById(ids);
+
+  QList<Row>* rows = new QList<Row>;
+  rows->reserve(last - first);
+  for (int i = first; i < last; i++) {
+    const Verse& v = m_results.at(i);
+    Row row;
+    row.info = tr("Surah: ") + m_surahNames.at(v.surah() - 1) + " - " +
+               tr("Verse: ") + QString::number(v.number());
+    row.text = texts.at(i - first);
+    row.fontName =
+      FontManager::getInstance().verseFontname(m_config.verseType(), v.page());
+    if (m_matches)
+      row.textMatches = m_matches(v, row.text);
+    rows->append(row);
+  }
+
+  if (m_snippets) {
+    for (const TafsirSnippet& snippet : m_snippets(ids)) {
+      const qsizetype i = ids.indexOf(snippet.verse);
+      if (i < 0)
+        continue;
+      Row& row = (*rows)[i];
+      row.snippet = snippet.text;
+      row.snippetMatches = snippet.matches;
+    }
+  }
+
+  m_batches.insert(number, rows);
+  // fetching is part of reading the rows, the signal only tells views their
+  // real sizes are known
+  emit const_cast<SearchResultModel*>(this)->rowsFetched(first, last - 1);
+  return *m_batches.object(number);
+}
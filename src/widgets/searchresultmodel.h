@@ -0,0 +1,138 @@
+/**
+ * @file searchresultmodel.h
+ * @brief Header file for SearchResultModel
+ */
+
+#ifndef SEARCHRESULTMODEL_H
+#define SEARCHRESULTMODEL_H
+
+#include <QAbstractListModel>
+#include <QCache>
+#include <functional>
+#include <service/glyphservice.h>
+#include <service/quranservice.h>
+#include <types/tafsir.h>
+#include <types/verse.h>
+#include <utils/configuration.h>
+
+/**
+ * @brief SearchResultModel is a list model of verse search results.
+ * @details Only the result verses are held for every row. The info line,
+ * verse text (or QCF glyphs) and font of a row are fetched when the row is
+ * first requested, together with the rest of its batch in a single query,
+ * and kept in a cache of a bounded number of batches so memory use does not
+ * grow with the number of results. The spans of the searched phrases in the
+ * verse text and, for content searches (e.g. tafsir), an excerpt of the
+ * matching content are fetched with the rest of the batch. Views can check
+ * whether a row is fetched through FetchedRole without fetching it.
+ */
+class SearchResultModel : public QAbstractListModel
+{
+  Q_OBJECT
+
+public:
+  /**
+   * @brief Custom data roles, Qt::DisplayRole holds the info line and
+   * Qt::FontRole the verse font.
+   */
+  enum Roles
+  {
+    TextRole = Qt::UserRole + 1, ///< verse text or QCF glyphs
+    SnippetRole,                 ///< excerpt of the matching content
+    SnippetMatchesRole,          ///< start and length of the excerpt matches
+    TextMatchesRole,             ///< start and length of the text matches
+    FetchedRole                  ///< whether the row is fetched
+  };
+  /**
+   * @brief Fetches the excerpts of the rows of a batch.
+   * @details Takes the verse ids of the batch, returns TafsirSnippet
+   * instances for the verses that have an excerpt.
+   */
+  using SnippetProvider =
+    std::function<QList<TafsirSnippet>(const QList<int>& verses)>;
+  /**
+   * @brief Locates the matches in the text of a row.
+   * @details Takes the verse and its shown text or QCF glyphs, returns the
+   * start and length of the matched spans in the text.
+   */
+  using MatchProvider = std::function<QList<QPair<int, int>>(
+    const Verse& verse,
+    const QString& text)>;
+  /**
+   * @brief Class constructor
+   * @param quranService - QuranService used to fetch verse text
+   * @param glyphService - GlyphService used to fetch verse glyphs
+   * @param parent - pointer to parent object
+   */
+  SearchResultModel(const QuranService* quranService,
+                    const GlyphService* glyphService,
+                    QObject* parent = nullptr);
+  /**
+   * @brief Replaces the shown results and drops the cached batches.
+   * @param results - QList of result verses
+   * @param snippets - fetches the content excerpts shown with the results,
+   * none are shown if empty
+   * @param matches - locates the matches highlighted in the verse texts,
+   * none are highlighted if empty
+   */
+  void setResults(const QList<Verse>& results,
+                  SnippetProvider snippets = nullptr,
+                  MatchProvider matches = nullptr);
+  /**
+   * @brief Get the verse shown in a row.
+   * @param row - row number
+   * @return Verse instance
+   */
+  Verse verseAt(int row) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+
+signals:
+  /**
+   * @brief Emitted when the rows of a batch are fetched.
+   * @param first - first fetched row
+   * @param last - last fetched row
+   */
+  void rowsFetched(int first, int last);
+
+private:
+  /**
+   * @brief Fetched display data of a single row.
+   */
+  struct Row
+  {
+    QString info;
+    QString text;
+    QString fontName;
+    QList<QPair<int, int>> textMatches;
+    QString snippet;
+    QList<QPair<int, int>> snippetMatches;
+  };
+  /**
+   * @brief Number of rows fetched together.
+   */
+  static const int batchSize = 32;
+  /**
+   * @brief Gets the fetched rows of a batch, fetching them if not cached.
+   */
+  const QList<Row>& batch(int number) const;
+  const Configuration& m_config;
+  const QuranService* m_quranService;
+  const GlyphService* m_glyphService;
+  /**
+   * @brief Surah names used in the info line of each row.
+   */
+  const QStringList m_surahNames;
+  QList<Verse> m_results;
+  SnippetProvider m_snippets;
+  MatchProvider m_matches;
+  /**
+   * @brief Fetched batches by batch number, the least recently used batches
+   * are dropped first.
+   */
+  mutable QCache<int, QList<Row>> m_batches;
+};
+
+#endif // SEARCHRESULTMODEL_H
@@ -0,0 +1,311 @@
+/**
+ * @file metadatagen.cpp
+ * @brief Build-time generator for the static Quran metadata tables.
+ *
+ * Reads the verses tables of quran.db and the surah/juz glyph tables of
+ * glyphs.db, and writes a header of inline constexpr tables used by the
+ * application instead of querying the same metadata at runtime. The tables are
+ * inline so every translation unit shares one definition.
+ *
+ * usage: qc-metadatagen <quran.db> <glyphs.db> <output header>
+ */
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QList>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QTextStream>
+
+struct VerseRow
+{
+  int page[2];
+  int surah;
+  int juz;
+  int hizb;
+  int rub;
+};
+
+static QSqlDatabase
+openDatabase(const QString& connection, const QString& path)
+{
+  QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connection);
+  db.setDatabaseName(path);
+  db.setConnectOptions("QSQLITE_OPEN_READONLY");
+  if (!db.open())
+    qFatal("Couldn't open %s: %s",
+           qPrintable(path),
+           qPrintable(db.lastError().text()));
+  return db;
+}
+
+static void
+execOrDie(QSqlQuery& query, const QString& sql)
+{
+  if (!query.exec(sql))
+    qFatal("Couldn't execute '%s': %s",
+           qPrintable(sql),
+           qPrintable(query.lastError().text()));
+}
+
+static QString
+quoted(QString text)
+{
+  text.replace('\\', "\\\\").replace('"', "\\\"");
+  return '"' + text + '"';
+}
+
+/**
+ * @brief write comma separated values wrapped 12 per line
+ */
+static void
+writeValues(QTextStream& out, const QList<int>& values, const QString& indent)
+{
+  for (int i = 0; i < values.size(); i++) {
+    out << (i % 12 == 0 ? "\n" + indent : QString()) << values.at(i)
+        << (i + 1 < values.size() ? ", " : "");
+  }
+}
+
+static void
+writeArray(QTextStream& out,
+           const QString& declaration,
+           const QList<int>& values)
+{
+  out << declaration << " = {";
+  writeValues(out, values, "  ");
+  out << "\n};\n";
+}
+
+static void
+writeTable(QTextStream& out,
+           const QString& declaration,
+           const QList<int> (&rows)[2])
+{
+  out << declaration << " = {\n";
+  for (int v = 0; v < 2; v++) {
+    out << "  // QCF v" << v + 1 << "\n  {";
+    writeValues(out, rows[v], "    ");
+    out << "\n  },\n";
+  }
+  out << "};\n";
+}
+
+static void
+writeStringArray(QTextStream& out,
+                 const QString& declaration,
+                 const QStringList& values)
+{
+  out << declaration << " = {\n";
+  for (int i = 0; i < values.size(); i++)
+    out << "  " << quoted(values.at(i)) << ",\n";
+  out << "};\n";
+}
+
+int
+main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  const QStringList args = app.arguments();
+  if (args.size() != 4)
+    qFatal("usage: qc-metadatagen <quran.db> <glyphs.db> <output header>");
+
+  QSqlDatabase quranDb = openDatabase("QuranCon", args.at(1));
+  QSqlDatabase glyphsDb = openDatabase("GlyphsCon", args.at(2));
+
+  QList<VerseRow> verses;
+  QStringList surahNamesAr(114), surahNamesEn(114);
+  QList<int> surahOffset(115, 0);
+  QSqlQuery query(quranDb);
+  execOrDie(query,
+            "SELECT v1.page,v2.page,v1.sura_no,v1.aya_no,v1.jozz,v1.hizb,"
+            "v1.rub,v1.sura_name_ar,v1.sura_name_en FROM verses_v1 v1 "
+            "JOIN verses_v2 v2 ON v1.id=v2.id ORDER BY v1.id");
+  while (query.next()) {
+    VerseRow row;
+    row.page[0] = query.value(0).toInt();
+    row.page[1] = query.value(1).toInt();
+    row.surah = query.value(2).toInt();
+    row.juz = query.value(4).toInt();
+    row.hizb = query.value(5).toInt();
+    row.rub = query.value(6).toInt();
+    verses.append(row);
+
+    surahOffset[row.surah] = verses.size();
+    surahNamesAr[row.surah - 1] = query.value(7).toString();
+    surahNamesEn[row.surah - 1] = query.value(8).toString();
+  }
+
+  if (verses.size() != 6236)
+    qFatal("Unexpected verse count in quran.db: %lld",
+           static_cast<long long>(verses.size()));
+
+  // 1-based first verse ids, index 0 is unused and the last entry is a
+  // sentinel pointing past the last verse
+  QList<int> pageFirstVerse[2] = { QList<int>(606, 0), QList<int>(606, 0) };
+  QList<int> juzFirstVerse(32, 0), hizbFirstVerse(62, 0);
+  QList<int> rubFirstVerse(242, 0);
+  QList<int> pageRubStart[2] = { QList<int>(605, 0), QList<int>(605, 0) };
+  QList<int> versePage[2];
+  for (int i = 0; i < verses.size(); i++) {
+    const VerseRow& row = verses.at(i);
+    const int id = i + 1;
+    for (int v = 0; v < 2; v++) {
+      versePage[v].append(row.page[v]);
+      if (!pageFirstVerse[v][row.page[v]])
+        pageFirstVerse[v][row.page[v]] = id;
+    }
+    if (!juzFirstVerse[row.juz])
+      juzFirstVerse[row.juz] = id;
+    if (!hizbFirstVerse[row.hizb])
+      hizbFirstVerse[row.hizb] = id;
+    if (!rubFirstVerse[row.rub]) {
+      rubFirstVerse[row.rub] = id;
+      for (int v = 0; v < 2; v++)
+        if (!pageRubStart[v][row.page[v]])
+          pageRubStart[v][row.page[v]] = row.rub;
+    }
+  }
+  for (int v = 0; v < 2; v++)
+    pageFirstVerse[v][605] = verses.size() + 1;
+  juzFirstVerse[31] = hizbFirstVerse[61] = rubFirstVerse[241] =
+    verses.size() + 1;
+
+  QStringList surahGlyphs(114), juzNames(30);
+  QSqlQuery glyphsQuery(glyphsDb);
+  execOrDie(glyphsQuery, "SELECT surah,qcf_v1 FROM surah_glyphs");
+  while (glyphsQuery.next())
+    surahGlyphs[glyphsQuery.value(0).toInt() - 1] =
+      glyphsQuery.value(1).toString();
+
+  execOrDie(glyphsQuery, "SELECT juz,text FROM juz_glyphs ORDER BY page");
+  while (glyphsQuery.next()) {
+    QString& name = juzNames[glyphsQuery.value(0).toInt() - 1];
+    if (name.isEmpty())
+      name = glyphsQuery.value(1).toString();
+  }
+
+  QString header;
+  QTextStream out(&header);
+  out << "// Generated by qc-metadatagen from quran.db and glyphs.db, do not "
+         "edit.\n\n"
+      << "#ifndef QURANMETADATA_H\n#define QURANMETADATA_H\n\n"
+      << "namespace QuranMetadata {\n\n"
+      << "inline constexpr int verseTotal = " << verses.size() << ";\n"
+      << "inline constexpr int surahTotal = 114;\n"
+      << "inline constexpr int pageTotal = 604;\n"
+      << "inline constexpr int juzTotal = 30;\n"
+      << "inline constexpr int hizbTotal = 60;\n"
+      << "inline constexpr int rubTotal = 240;\n\n";
+
+  out << "/// number of verses preceding each surah, the last entry is the "
+         "verse total\n";
+  writeArray(
+    out, "inline constexpr int surahOffset[surahTotal + 1]", surahOffset);
+  out << "\n/// id of the first verse in each page per QCF version, index 0 is "
+         "unused and\n/// the last entry is a sentinel past the last verse\n";
+  writeTable(out,
+             "inline constexpr int pageFirstVerse[2][pageTotal + 2]",
+             pageFirstVerse);
+  out << "\n/// page of each verse per QCF version, indexed by verse id - 1\n";
+  writeTable(out, "inline constexpr short versePage[2][verseTotal]", versePage);
+  out << "\n/// id of the first verse in each juz, hizb and rub, index 0 is "
+         "unused and the\n/// last entry is a sentinel past the last verse\n";
+  writeArray(
+    out, "inline constexpr int juzFirstVerse[juzTotal + 2]", juzFirstVerse);
+  writeArray(
+    out, "inline constexpr int hizbFirstVerse[hizbTotal + 2]", hizbFirstVerse);
+  writeArray(
+    out, "inline constexpr int rubFirstVerse[rubTotal + 2]", rubFirstVerse);
+  out << "\n/// rub number (relative to the mushaf) starting in each page per "
+         "QCF version,\n/// 0 if no rub starts in the page\n";
+  writeTable(
+    out, "inline constexpr int pageRubStart[2][pageTotal + 1]", pageRubStart);
+  out << "\n";
+
+  writeStringArray(out,
+                   "inline constexpr const char* surahNamesAr[surahTotal]",
+                   surahNamesAr);
+  writeStringArray(out,
+                   "inline constexpr const char* surahNamesEn[surahTotal]",
+                   surahNamesEn);
+  out << "\n/// surah name glyphs for the QCF_BSML font\n";
+  writeStringArray(out,
+                   "inline constexpr const char* surahNameGlyphs[surahTotal]",
+                   surahGlyphs);
+  writeStringArray(
+    out, "inline constexpr const char* juzNames[juzTotal]", juzNames);
+
+  out << R"(
+/**
+ * @brief index of the last entry in table[first..last] that is less than or
+ * equal to value, the table must be sorted in ascending order
+ */
+constexpr int
+floorIndex(const int* table, int first, int last, int value)
+{
+  while (first < last) {
+    int mid = (first + last + 1) / 2;
+    if (table[mid] <= value)
+      first = mid;
+    else
+      last = mid - 1;
+  }
+  return first;
+}
+
+constexpr int
+verseId(int surah, int number)
+{
+  return surahOffset[surah - 1] + number;
+}
+
+constexpr int
+surahVerseCount(int surah)
+{
+  return surahOffset[surah] - surahOffset[surah - 1];
+}
+
+constexpr int
+surahOf(int id)
+{
+  return floorIndex(surahOffset, 0, surahTotal - 1, id - 1) + 1;
+}
+
+constexpr int
+juzOf(int id)
+{
+  return floorIndex(juzFirstVerse, 1, juzTotal, id);
+}
+
+constexpr int
+hizbOf(int id)
+{
+  return floorIndex(hizbFirstVerse, 1, hizbTotal, id);
+}
+
+constexpr int
+rubOf(int id)
+{
+  return floorIndex(rubFirstVerse, 1, rubTotal, id);
+}
+
+} // namespace QuranMetadata
+
+#endif // QURANMETADATA_H
+)";
+  out.flush();
+
+  // only touch the output when the content changes to avoid needless rebuilds
+  QFile output(args.at(3));
+  if (output.open(QIODevice::ReadOnly) && output.readAll() == header.toUtf8())
+    return 0;
+  output.close();
+
+  if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    qFatal("Couldn't write %s", qPrintable(args.at(3)));
+  output.write(header.toUtf8());
+  return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file searchbench.cpp
+ * @brief Benchmark of the in-memory VerseSearchEngine against the SQL LIKE
+ * verse search.
+ *
+ * Runs each query through both implementations over the whole mushaf and
+ * prints the average time and the number of results of each, then times the
+ * approximate search of each query, the similar verse lookup and the
+ * concordance lookup of each query word.
+ *
+ * usage: qc-searchbench <quran.db> [query...]
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <search/concordance.h>
+#include <search/similarityindex.h>
+#include <search/versesearchengine.h>
+#include <utils/arabicnormalizer.h>
+
+static const int iterations = 50;
+
+int
+main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QStringList args = app.arguments();
+  if (args.size() < 2)
+    qFatal("usage: qc-searchbench <quran.db> [query...]");
+
+  QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "QuranCon");
+  db.setDatabaseName(args.at(1));
+  db.setConnectOptions("QSQLITE_OPEN_READONLY");
+  if (!db.open())
+    qFatal("Couldn't open %s: %s",
+           qPrintable(args.at(1)),
+           qPrintable(db.lastError().text()));
+
+  QStringList queries = args.mid(2);
+  if (queries.isEmpty())
+    queries = { "الله", "الرحمن", "صلاة", "قال", "يا أيها الذين آمنوا",
+                "موسى", "والذين كفروا", "لعلكم تتقون" };
+
+  QStringList texts;
+  QSqlQuery query(db);
+  query.setForwardOnly(true);
+  query.exec("SELECT aya_text_emlaey FROM verses_v1 ORDER BY id");
+  while (query.next())
+    texts.append(query.value(0).toString());
+
+  QElapsedTimer timer;
+  timer.start();
+  VerseSearchEngine engine(texts, 1);
+  QTextStream out(stdout);
+  out << "index built in " << timer.nsecsElapsed() / 1000 << "us: "
+      << engine.index().termCount() << " terms, "
+      << engine.index().postingsSize() << " bytes of postings\n\n";
+
+  QSqlQuery like(db);
+  like.setForwardOnly(true);
+  like.prepare("SELECT page,sura_no,aya_no FROM verses_v1 WHERE page BETWEEN "
+               "? AND ? AND aya_text_emlaey LIKE ? ORDER BY id");
+  QSqlQuery likeWhole(db);
+  likeWhole.setForwardOnly(true);
+  likeWhole.prepare("SELECT page,sura_no,aya_no FROM verses_v1 WHERE page "
+                    "BETWEEN ? AND ? AND (aya_text_emlaey LIKE ? OR "
+                    "aya_text_emlaey LIKE ?) ORDER BY id");
+
+  const int range[2] = { 1, 604 };
+  out << "query\twhole\tlike(us)\tlike results\tengine(us)\tengine results\n";
+  for (const QString& text : queries) {
+    for (bool whole : { false, true }) {
+      QSqlQuery& sql = whole ? likeWhole : like;
+      int likeResults = 0;
+      timer.restart();
+      for (int i = 0; i < iterations; i++) {
+        sql.bindValue(0, range[0]);
+        sql.bindValue(1, range[1]);
+        if (whole) {
+          sql.bindValue(2, text + " %");
+          sql.bindValue(3, "% " + text + " %");
+        } else {
+          sql.bindValue(2, '%' + text + '%');
+        }
+        sql.exec();
+        for (likeResults = 0; sql.next(); likeResults++)
+          ;
+      }
+      const qint64 likeTime = timer.nsecsElapsed() / iterations / 1000;
+
+      qsizetype engineResults = 0;
+      timer.restart();
+      for (int i = 0; i < iterations; i++)
+        engineResults = engine.searchVerses(text, range, whole).size();
+      const qint64 engineTime = timer.nsecsElapsed() / iterations / 1000;
+
+      out << text << '\t' << whole << '\t' << likeTime << '\t' << likeResults
+          << '\t' << engineTime << '\t' << engineResults << '\n';
+    }
+  }
+
+  out << "\nquery\tapproximate(us)\tresults\n";
+  for (const QString& text : queries) {
+    qsizetype results = 0;
+    timer.restart();
+    for (int i = 0; i < iterations; i++)
+      results = engine.searchApproximate(text).size();
+    out << text << '\t' << timer.nsecsElapsed() / iterations / 1000 << '\t'
+        << results << '\n';
+  }
+
+  timer.restart();
+  SimilarityIndex similarity;
+  similarity.build(texts);
+  out << "\nsimilarity index built in " << timer.nsecsElapsed() / 1000
+      << "us\n";
+
+  qsizetype similar = 0;
+  timer.restart();
+  for (int id = 1; id <= similarity.verseCount(); id++)
+    similar += similarity.similar(id, 20).size();
+  out << "similar verses: "
+      << timer.nsecsElapsed() / similarity.verseCount() / 1000
+      << "us per verse, " << similar << " matches in total\n";
+
+  QTemporaryDir dir;
+  const QString concordancePath = dir.filePath("concordance.bin");
+  timer.restart();
+  Concordance concordance;
+  if (!Concordance::write(texts, concordancePath, "bench") ||
+      !concordance.open(concordancePath, "bench"))
+    qFatal("Couldn't write the concordance");
+  out << "\nconcordance written and mapped in "
+      << timer.nsecsElapsed() / 1000 << "us: " << concordance.termCount()
+      << " terms, " << concordance.wordCount() << " words\n";
+
+  out << "word\tlookup(us)\toccurrences\n";
+  for (const QString& text : queries) {
+    const QString word = ArabicNormalizer::tokens(text).value(0);
+    qsizetype results = 0;
+    timer.restart();
+    for (int i = 0; i < iterations; i++)
+      results = concordance.occurrences(word, false).size();
+    out << word << '\t' << timer.nsecsElapsed() / iterations / 1000 << '\t'
+        << results << '\n';
+  }
+
+  return 0;
+}